@@ -0,0 +1,206 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <iota/api/extended.hpp>
+#include <iota/api/responses/get_account_data.hpp>
+#include <iota/constants.hpp>
+#include <iota/models/address.hpp>
+#include <iota/models/bundle.hpp>
+#include <iota/models/seed.hpp>
+#include <iota/types/hash.hpp>
+#include <iota/types/trytes.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+/**
+ * Incremental account state of a seed.
+ *
+ * Keeps a snapshot of the account (known addresses, seen transactions, verified bundles, balances
+ * and last solid milestone) and updates it on each call to sync by only fetching what changed:
+ *  * addresses are only derived past the last known one,
+ *  * only transactions that are not in the snapshot are fetched, and their bundles verified,
+ *  * transactions whose bundle cannot be verified are retried a limited number of times,
+ *  * inclusion states are only checked for unconfirmed tails of unconfirmed bundles,
+ *  * balances are only queried when a new milestone, address or transaction was seen.
+ *
+ * The snapshot can be saved and loaded, so that the account state persists between runs.
+ * Not thread-safe.
+ */
+class AccountSync {
+public:
+  /**
+   * Number of syncs in which the bundle of a transaction is looked for before it is ignored.
+   */
+  static constexpr unsigned int MaxBundleAttempts = 5;
+
+public:
+  /**
+   * State of the account, as of the last sync.
+   */
+  struct Snapshot {
+    /**
+     * Known addresses, by key index, with their balance. The last one is unused.
+     */
+    std::vector<Models::Address> addresses;
+    /**
+     * Hashes of the transactions found on the addresses.
+     */
+    std::unordered_set<Types::Hash> transactions;
+    /**
+     * Hashes of the transactions found on the addresses whose bundle could not be verified, with
+     * the number of attempts. They are ignored after MaxBundleAttempts.
+     */
+    std::unordered_map<Types::Hash, unsigned int> rejected;
+    /**
+     * Verified bundles, by tail hash.
+     */
+    std::map<Types::Hash, Models::Bundle> bundles;
+    /**
+     * Tails of the confirmed bundles. The other tails of these bundles are reattachments, never
+     * confirmed nor checked again.
+     */
+    std::unordered_set<Types::Hash> confirmedTails;
+    /**
+     * Latest solid milestone at the time of the last sync.
+     */
+    Types::Trytes milestone;
+  };
+
+public:
+  /**
+   * Full init ctor.
+   *
+   * @param api The api used to sync, must outlive this object.
+   * @param seed The seed of the account.
+   * @param threshold Confirmation threshold used to get the balances.
+   */
+  AccountSync(const Extended& api, const Models::Seed& seed,
+              int threshold = GetBalancesRecommandedConfirmationThreshold);
+  /**
+   * Default dtor.
+   */
+  ~AccountSync() = default;
+
+public:
+  /**
+   * Fetch and verify what changed since the last sync, and update the snapshot.
+   *
+   * @return true if the snapshot changed.
+   */
+  bool sync();
+
+  /**
+   * @return The snapshot, as of the last sync.
+   */
+  const Snapshot& getSnapshot() const;
+
+  /**
+   * @return The account data of the snapshot, in the same format as Extended::getAccountData.
+   */
+  Responses::GetAccountData getAccountData() const;
+
+  /**
+   * @return The total balance of the account.
+   */
+  int64_t getBalance() const;
+
+  /**
+   * Write the snapshot to a stream, as json.
+   *
+   * @param os The stream.
+   */
+  void save(std::ostream& os) const;
+
+  /**
+   * Replace the snapshot by one read from a stream, as written by save.
+   * Throws if the snapshot is invalid or belongs to another seed.
+   *
+   * @param is The stream.
+   */
+  void load(std::istream& is);
+
+private:
+  /**
+   * Derive the addresses past the last known one, until an unused address is found.
+   *
+   * @return true if new addresses were found.
+   */
+  bool syncAddresses();
+
+  /**
+   * Fetch and verify the bundles of the transactions that are not in the snapshot.
+   *
+   * @return true if new transactions were found.
+   */
+  bool syncTransactions();
+
+  /**
+   * Check inclusion of the tails of the unconfirmed bundles, against the given milestone.
+   *
+   * @return true if bundles were confirmed.
+   */
+  bool syncInclusionStates(const Types::Trytes& milestone);
+
+  /**
+   * Refresh the balances of all known addresses.
+   */
+  void syncBalances();
+
+private:
+  /**
+   * The api used to sync.
+   */
+  const Extended& api_;
+
+  /**
+   * The seed of the account.
+   */
+  Models::Seed seed_;
+
+  /**
+   * Confirmation threshold used to get the balances.
+   */
+  int threshold_;
+
+  /**
+   * The account state.
+   */
+  Snapshot snapshot_;
+};
+
+}  // namespace API
+
+}  // namespace IOTA
@@ -0,0 +1,189 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <iota/api/core.hpp>
+#include <iota/constants.hpp>
+#include <iota/models/address.hpp>
+#include <iota/types/trytes.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+/**
+ * Polls the balances of a large set of addresses, and reports the ones that changed.
+ *
+ * Addresses are stored back to back in a single buffer, with their balances in an aligned int64_t
+ * column. Each poll splits the addresses into shards queried concurrently with getBalances, and
+ * decodes the balances straight into a new column as the responses are read. Memory is thus
+ * proportional to the number of addresses, not to the size of the responses.
+ *
+ * Not thread-safe.
+ */
+class BalancePoller {
+public:
+  /**
+   * A balance that changed between two polls.
+   */
+  struct Change {
+    /**
+     * Index of the address.
+     */
+    std::size_t index;
+    /**
+     * Balance at the previous poll.
+     */
+    int64_t previous;
+    /**
+     * Balance at this poll.
+     */
+    int64_t balance;
+  };
+
+public:
+  /**
+   * Full init ctor. Shards default to the chunk size and concurrency of getBalances on the api.
+   *
+   * @param api The api used to poll, must outlive this object.
+   * @param threshold Confirmation threshold used to get the balances.
+   */
+  explicit BalancePoller(const Core& api,
+                         int         threshold = GetBalancesRecommandedConfirmationThreshold);
+  /**
+   * Default dtor.
+   */
+  ~BalancePoller() = default;
+
+public:
+  /**
+   * Add an address to poll. Its balance is 0 until the next poll.
+   *
+   * @param address The address, checksum is ignored.
+   *
+   * @return Index of the address.
+   */
+  std::size_t add(const Models::Address& address);
+
+  /**
+   * Add addresses to poll. Their balances are 0 until the next poll.
+   *
+   * @param addresses The addresses, checksums are ignored.
+   */
+  void add(const std::vector<Models::Address>& addresses);
+
+  /**
+   * Query the balances of all the addresses.
+   * Throws if one of the shards could not be queried, in which case no balance is updated.
+   *
+   * @return The balances that changed since the previous poll, by increasing index.
+   */
+  std::vector<Change> poll();
+
+  /**
+   * @return Number of addresses.
+   */
+  std::size_t size() const;
+
+  /**
+   * @param index Index of the address.
+   *
+   * @return The address, without checksum.
+   */
+  Types::Trytes getAddress(std::size_t index) const;
+
+  /**
+   * @param index Index of the address.
+   *
+   * @return The balance of the address, as of the last poll.
+   */
+  int64_t getBalance(std::size_t index) const;
+
+  /**
+   * @return The balances, aligned with the addresses.
+   */
+  const std::vector<int64_t>& getBalances() const;
+
+  /**
+   * @return The sum of the balances.
+   */
+  int64_t getTotalBalance() const;
+
+  /**
+   * @param size Maximum number of addresses per getBalances request, 0 to never split the
+   * addresses.
+   */
+  void setShardSize(std::size_t size);
+
+  /**
+   * @return Maximum number of addresses per getBalances request, 0 if the addresses are never
+   * split.
+   */
+  std::size_t getShardSize() const;
+
+  /**
+   * @param maxShards Maximum number of getBalances requests in flight.
+   */
+  void setMaxShardsInFlight(std::size_t maxShards);
+
+  /**
+   * @return Maximum number of getBalances requests in flight.
+   */
+  std::size_t getMaxShardsInFlight() const;
+
+private:
+  /**
+   * Query the balances of a shard into a column.
+   *
+   * @param shard Index of the shard.
+   * @param shardSize Number of addresses per shard, at least 1.
+   * @param balances Column to fill.
+   */
+  void pollShard(std::size_t shard, std::size_t shardSize, std::vector<int64_t>& balances) const;
+
+private:
+  const Core& api_;
+  int         threshold_;
+  std::size_t shardSize_;
+  std::size_t maxShardsInFlight_;
+
+  /**
+   * Addresses without checksum, back to back.
+   */
+  std::string addresses_;
+  /**
+   * Balances, aligned with the addresses.
+   */
+  std::vector<int64_t> balances_;
+};
+
+}  // namespace API
+
+}  // namespace IOTA
@@ -0,0 +1,156 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <iota/api/tangle_store.hpp>
+#include <iota/models/compact_transaction.hpp>
+#include <iota/types/hash.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+/**
+ * Import of transaction trytes dumps, holding one transaction per line.
+ *
+ * The dump is read by blocks of lines. The lines of a block are validated and hashed on all the
+ * cores, by batches of BatchCurl::BatchSize transactions, and turned into compact transactions.
+ * Blocks are handed to the consumer in the order of the dump, one after the other.
+ *
+ * Empty lines are skipped, invalid lines are counted and skipped.
+ */
+class BulkImporter {
+public:
+  /**
+   * Default number of lines per block.
+   */
+  static constexpr std::size_t DefaultBlockSize = 8192;
+
+  /**
+   * Outcome of an import.
+   */
+  struct Stats {
+    /**
+     * Number of imported transactions.
+     */
+    std::size_t transactions;
+    /**
+     * Number of skipped invalid lines.
+     */
+    std::size_t invalid;
+    /**
+     * Duration of the import, in milliseconds.
+     */
+    int64_t duration;
+  };
+
+  /**
+   * Consumer of the transactions of a block. The transactions can be moved from.
+   */
+  using Consumer = std::function<void(std::vector<Models::CompactTransaction>&&)>;
+
+  /**
+   * Hashes of the transactions of each bundle, by bundle hash.
+   */
+  using BundleIndex = std::unordered_map<Types::Hash, std::vector<Types::Hash>>;
+
+public:
+  /**
+   * Full init ctor.
+   *
+   * @param blockSize Number of lines per block.
+   */
+  explicit BulkImporter(std::size_t blockSize = DefaultBlockSize);
+  /**
+   * Default dtor.
+   */
+  ~BulkImporter() = default;
+
+public:
+  /**
+   * Import a dump.
+   *
+   * @param is Stream of the dump.
+   * @param consumer Consumer of the transactions.
+   *
+   * @return The stats of the import.
+   */
+  Stats import(std::istream& is, const Consumer& consumer) const;
+
+  /**
+   * Import a dump file.
+   *
+   * @param path Path of the dump.
+   * @param consumer Consumer of the transactions.
+   *
+   * @return The stats of the import.
+   */
+  Stats importFile(const std::string& path, const Consumer& consumer) const;
+
+  /**
+   * @param store Store to add the transactions to, must outlive the consumer.
+   *
+   * @return A consumer adding the transactions to a tangle store.
+   */
+  static Consumer storeInto(TangleStore& store);
+
+  /**
+   * @param index Index to add the transactions to, must outlive the consumer.
+   *
+   * @return A consumer indexing the transactions by bundle.
+   */
+  static Consumer indexBundlesInto(BundleIndex& index);
+
+  /**
+   * @return Number of lines per block.
+   */
+  std::size_t getBlockSize() const;
+
+private:
+  /**
+   * Validate, hash and decode the lines of a block.
+   *
+   * @param lines Start and length of each non empty line.
+   * @param consumer Consumer of the transactions.
+   * @param stats Stats to update.
+   */
+  void importBlock(const std::vector<std::pair<const char*, std::size_t>>& lines,
+                   const Consumer& consumer, Stats& stats) const;
+
+private:
+  std::size_t blockSize_;
+};
+
+}  // namespace API
+
+}  // namespace IOTA
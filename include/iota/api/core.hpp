@@ -25,10 +25,19 @@
 
 #pragma once
 
+#include <functional>
+#include <future>
+#include <map>
+#include <memory>
+
 #include <iota/api/responses/fwd.hpp>
 #include <iota/api/service.hpp>
+#include <iota/api/tangle_store.hpp>
 #include <iota/models/address.hpp>
 #include <iota/models/tag.hpp>
+#include <iota/types/hash.hpp>
+#include <iota/utils/lru_cache.hpp>
+#include <iota/utils/thread_pool.hpp>
 
 namespace IOTA {
 
@@ -39,8 +48,28 @@ namespace API {
  *
  * https://iota.readme.io/reference
  *
+ * Async variants run the blocking call on a bounded executor owned by the api object. The api
+ * object must outlive the futures it returns.
+ *
+ * Commands taking a list of hashes or addresses (getTrytes, findTransactions, getBalances,
+ * getInclusionStates and wereAddressesSpentFrom) are split into chunks of at most getChunkSize
+ * items. Chunks are sent concurrently and their results are merged back in input order.
+ *
+ * getTrytes can be backed by a cache of trytes by hash, see enableTrytesCache, and getTrytes and
+ * findTransactions by a local store of transactions, see setTangleStore.
+ *
  */
 class Core {
+public:
+  /**
+   * Consumer of the trytes or hashes decoded from a response. The trytes can be moved from.
+   */
+  using TrytesConsumer = std::function<void(Types::Trytes&&)>;
+  /**
+   * Cache of transaction trytes by transaction hash.
+   */
+  using TrytesCache = Utils::LRUCache<Types::Hash, Types::Trytes>;
+
 public:
   /**
    * Full init ctor.
@@ -53,7 +82,16 @@ public:
   explicit Core(const std::string& host, const uint16_t& port, bool localPow = true,
                 int timeout = 60, const std::string& user = "", const std::string& pass = "");
   /**
-   * Default dtor.
+   * Copy ctor. The copy gets its own executor for async calls.
+   */
+  Core(const Core& other);
+  /**
+   * Copy assignment. The configuration is copied, the object keeps its own executor for async
+   * calls.
+   */
+  Core& operator=(const Core& other);
+  /**
+   * Runs the pending async calls.
    */
   virtual ~Core() = default;
 
@@ -281,6 +319,235 @@ public:
    */
   Responses::CheckConsistency checkConsistency(const std::vector<Types::Trytes>& tails) const;
 
+public:
+  /**
+   * Streaming variant of findTransactions: each hash is handed to the consumer as it is decoded,
+   * without building the full list.
+   *
+   * @param consumer Consumer of the transaction hashes.
+   *
+   * @return The response, holding only the duration.
+   */
+  Responses::Base findTransactions(const std::vector<Models::Address>& addresses,
+                                   const std::vector<Models::Tag>&     tags,
+                                   const std::vector<Types::Trytes>&   approvees,
+                                   const std::vector<Types::Trytes>&   bundles,
+                                   const TrytesConsumer&               consumer) const;
+
+  /**
+   * Streaming variant of getTrytes: the trytes of each transaction are handed to the consumer as
+   * they are decoded, in the order of the hashes, without building the full list.
+   *
+   * @param consumer Consumer of the transaction trytes.
+   *
+   * @return The response, holding only the duration.
+   */
+  Responses::Base getTrytes(const std::vector<Types::Trytes>& hashes,
+                            const TrytesConsumer&             consumer) const;
+
+  /**
+   * Streaming variant of getBalances: each balance is handed to the consumer as it is decoded, in
+   * the order of the addresses.
+   *
+   * @param consumer Consumer of the balances.
+   *
+   * @return The response, holding the references and milestone index but no balances.
+   */
+  Responses::GetBalances getBalances(const std::vector<Models::Address>&   addresses,
+                                     const int&                            threshold,
+                                     const std::vector<Types::Trytes>&     tips,
+                                     const std::function<void(int64_t)>& consumer) const;
+
+public:
+  /**
+   * Async variant of findTransactions.
+   *
+   * @return A future holding the response, or the exception raised by the request.
+   */
+  std::future<Responses::FindTransactions> findTransactionsAsync(
+      const std::vector<Models::Address>& addresses, const std::vector<Models::Tag>& tags,
+      const std::vector<Types::Trytes>& approvees, const std::vector<Types::Trytes>& bundles) const;
+
+  /**
+   * Async variant of getTrytes.
+   *
+   * @return A future holding the response, or the exception raised by the request.
+   */
+  std::future<Responses::GetTrytes> getTrytesAsync(const std::vector<Types::Trytes>& hashes) const;
+
+  /**
+   * Async variant of getInclusionStates.
+   *
+   * @return A future holding the response, or the exception raised by the request.
+   */
+  std::future<Responses::GetInclusionStates> getInclusionStatesAsync(
+      const std::vector<Types::Trytes>& transactions, const std::vector<Types::Trytes>& tips) const;
+
+  /**
+   * Async variant of getBalances.
+   *
+   * @return A future holding the response, or the exception raised by the request.
+   */
+  std::future<Responses::GetBalances> getBalancesAsync(
+      const std::vector<Models::Address>& addresses, const int& threshold = 100,
+      const std::vector<Types::Trytes>& tips = {}) const;
+
+  /**
+   * @return The maximum number of async requests in flight at the same time.
+   */
+  std::size_t getMaxAsyncRequests() const;
+
+  /**
+   * Change the maximum number of async requests in flight at the same time. Requests beyond this
+   * limit are queued until a previous one completes.
+   *
+   * @param maxRequests The maximum number of async requests in flight.
+   */
+  void setMaxAsyncRequests(std::size_t maxRequests);
+
+  /**
+   * @param command Name of the command, for example "getTrytes".
+   *
+   * @return The maximum number of items sent in a single request for this command, 0 if the
+   * command is never split.
+   */
+  std::size_t getChunkSize(const std::string& command) const;
+
+  /**
+   * Change the maximum number of items sent in a single request for a command. Should be set
+   * before the api object is shared between threads.
+   *
+   * @param command Name of the command, for example "getTrytes".
+   * @param chunkSize The maximum number of items per request, 0 to never split the command.
+   */
+  void setChunkSize(const std::string& command, std::size_t chunkSize);
+
+  /**
+   * @return The maximum number of chunks of a single call sent at the same time.
+   */
+  std::size_t getMaxChunksInFlight() const;
+
+  /**
+   * @param maxChunks The maximum number of chunks of a single call sent at the same time.
+   */
+  void setMaxChunksInFlight(std::size_t maxChunks);
+
+  /**
+   * Cache the trytes returned by getTrytes, so that transactions are only fetched once. Trytes of a
+   * transaction never change, unknown transactions are not cached. The cache is shared with copies
+   * of this api object. Should be set before the api object is shared between threads.
+   *
+   * @param capacity Maximum number of cached transactions, 0 to disable the cache.
+   */
+  void enableTrytesCache(std::size_t capacity);
+
+  /**
+   * @return The trytes cache, null if disabled.
+   */
+  const std::shared_ptr<TrytesCache>& getTrytesCache() const;
+
+  /**
+   * Answer getTrytes from a local store of transactions first, and add the transactions fetched
+   * from the node to it. The store is shared with copies of this api object. Should be set before
+   * the api object is shared between threads.
+   *
+   * findTransactions is always answered by the node: new transactions keep matching the same
+   * addresses, tags, approvees and bundles, so no query result is final.
+   *
+   * @param store The store, null to disable it.
+   */
+  void setTangleStore(const std::shared_ptr<TangleStore>& store);
+
+  /**
+   * @return The tangle store, null if disabled.
+   */
+  const std::shared_ptr<TangleStore>& getTangleStore() const;
+
+  /**
+   * Nodes used by this api object. Nodes can be added to it, see Service for the routing of the
+   * requests between them. Should be configured before the api object is shared between threads.
+   *
+   * @return The service.
+   */
+  Service& getService();
+
+  /**
+   * @return The service.
+   */
+  const Service& getService() const;
+
+protected:
+  /**
+   * @return Whether objects identified by this hash can be cached.
+   */
+  static bool isCacheableHash(const Types::Trytes& hash);
+
+  /**
+   * @param command Name of the command, for example "getTrytes".
+   * @param size Number of items sent.
+   *
+   * @return Whether the items fit in a single request, see getChunkSize.
+   */
+  bool isSingleChunk(const std::string& command, std::size_t size) const;
+
+  /**
+   * Run a task on the async executor. The task is given a copy of api, which shares its nodes and
+   * caches, so that it never touches this object, whose members may be destroyed first.
+   *
+   * @param api The api the task runs on, usually *this.
+   * @param fn The task, called with the copy of api.
+   *
+   * @return A future holding the result of the task.
+   */
+  template <typename Api, typename F>
+  std::future<typename std::result_of<F(const Api&)>::type>
+  async(const Api& api, const F& fn) const {
+    auto copy = std::make_shared<const Api>(api);
+
+    return executor_->submit([copy, fn]() { return fn(*copy); });
+  }
+
+  /**
+   * Run fn for each chunk index, on at most getMaxChunksInFlight threads. Returns once all the
+   * chunks are done, rethrowing the first exception raised by fn.
+   *
+   * @param nbChunks Number of chunks.
+   * @param fn Function processing the chunk at the given index.
+   */
+  void dispatchChunks(std::size_t nbChunks, const std::function<void(std::size_t)>& fn) const;
+
+private:
+  /**
+   * Look up the trytes of a transaction in the cache, then in the tangle store.
+   *
+   * @param hash Hash of the transaction.
+   * @param trytes Where to copy the trytes, if found.
+   *
+   * @return true if the trytes were found.
+   */
+  bool lookupTrytes(const Types::Trytes& hash, Types::Trytes& trytes) const;
+
+  /**
+   * getTrytes, bypassing the cache.
+   */
+  Responses::GetTrytes fetchTrytes(const std::vector<Types::Trytes>& hashes) const;
+
+  /**
+   * Streaming getTrytes, bypassing the cache.
+   */
+  Responses::Base streamTrytes(const std::vector<Types::Trytes>& hashes,
+                               const TrytesConsumer&             consumer) const;
+
+
+  /**
+   * Cache and store the trytes of a transaction fetched from the node, unless the transaction is
+   * unknown.
+   *
+   * @param hash Hash of the transaction.
+   * @param trytes Trytes returned by the node.
+   */
+  void cacheTrytes(const Types::Trytes& hash, const Types::Trytes& trytes) const;
+
 private:
   /**
    * Internal service for api calls.
@@ -290,6 +557,27 @@ private:
    * Defines whether PoW is done locally or remotely.
    */
   bool localPow_;
+  /**
+   * Maximum number of items per request, by command.
+   */
+  std::map<std::string, std::size_t> chunkSizes_;
+  /**
+   * Maximum number of chunks of a single call sent at the same time.
+   */
+  std::size_t maxChunksInFlight_;
+  /**
+   * Cache of trytes by hash, null if disabled.
+   */
+  std::shared_ptr<TrytesCache> trytesCache_;
+  /**
+   * Local store of transactions, null if disabled.
+   */
+  std::shared_ptr<TangleStore> tangleStore_;
+  /**
+   * Executor for async calls. Its tasks run on copies of the api (see async), so they may outlive
+   * the members of this object.
+   */
+  std::unique_ptr<Utils::ThreadPool> executor_;
 };
 
 }  // namespace API
@@ -25,7 +25,15 @@
 
 #pragma once
 
+#include <chrono>
+#include <memory>
+#include <mutex>
+
 #include <iota/api/core.hpp>
+#include <iota/api/spent_address_store.hpp>
+#include <iota/api/tip_pool.hpp>
+#include <iota/constants.hpp>
+#include <iota/models/bundle.hpp>
 #include <iota/models/fwd.hpp>
 #include <iota/utils/stop_watch.hpp>
 
@@ -39,6 +47,17 @@ namespace API {
  * https://github.com/iotaledger/wiki/blob/master/api-proposal.md#proposed-api-calls
  */
 class Extended : public Core {
+public:
+  /**
+   * Cache of verified bundles by tail transaction hash.
+   */
+  using BundleCache = Utils::LRUCache<Types::Hash, Models::Bundle>;
+
+  /**
+   * Set of transactions known to be confirmed.
+   */
+  using ConfirmedTailsCache = Utils::LRUCache<Types::Hash, bool>;
+
 public:
   /**
    * Full init ctor.
@@ -59,6 +78,7 @@ public:
    * Gets all possible inputs of a seed and returns them with the total balance. This is either done
    * deterministically (by genearating all addresses until findTransactions is empty and doing
    * getBalances), or by providing a key range to use for searching through.
+   * Addresses already spent from are never used as inputs.
    *
    * @param seed      Seed to be used for address generation.
    * @param start     Starting key index for address generation (included).
@@ -106,6 +126,7 @@ public:
    * Traverse the Bundle by going down the trunkTransactions until
    * the bundle hash of the transaction is no longer the same. In case the input
    * transaction hash is not a tail, return an error.
+   * By default, the whole bundle is fetched at once instead (see setWholeBundleFetch).
    *
    * @param trunkTx    Hash of a trunk or a tail transaction of a bundle.
    *
@@ -145,6 +166,17 @@ public:
   std::vector<Models::Bundle> bundlesFromAddresses(const std::vector<Models::Address>& addresses,
                                                    bool withInclusionStates = false) const;
 
+  /**
+   * Get the bundles the given transactions belong to, reattachments included.
+   *
+   * @param hashes              Hashes of the transactions.
+   * @param withInclusionStates If <code>true</code>, it gets the inclusion states of the transfers.
+   *
+   * @return Valid bundles, sorted.
+   */
+  std::vector<Models::Bundle> bundlesFromTransactions(const std::vector<Types::Trytes>& hashes,
+                                                      bool withInclusionStates = false) const;
+
   /**
    * Lookup transactions for given addresses and return a list of transaction objects
    *
@@ -166,6 +198,17 @@ public:
   std::vector<Models::Transaction> getTransactionsObjects(
       const std::vector<IOTA::Types::Trytes>& trx_hashes) const;
 
+  /**
+   * Same as getTransactionsObjects, but returns lightweight views over the raw trytes. Fields are
+   * only decoded when accessed, which is cheaper when only a few of them are needed.
+   *
+   * @param hashes Hashes of the transactions to find
+   *
+   * @return Transactions views.
+   **/
+  std::vector<Models::TransactionView> getTransactionsViews(
+      const std::vector<IOTA::Types::Trytes>& hashes) const;
+
   /**
    * Same as findTransactionObjects, but based on bundle hash
    *
@@ -177,11 +220,14 @@ public:
       const std::vector<IOTA::Types::Trytes>& input) const;
 
   /**
-   * Get inclusion states for the given transactions.
+   * Get inclusion states for the given transactions, against the latest solid milestone.
+   * The milestone is refreshed at most once per getMilestoneRefreshInterval, and only the
+   * transactions not yet known to be confirmed are sent to the node.
    *
    * @param hashes Hash of the transactions for which the inclusion states will be retrieved.
    *
-   * @return Inclusion states.
+   * @return Inclusion states, one per hash. Throws IllegalState if the node answers with another
+   * number of states.
    */
   Responses::GetInclusionStates getLatestInclusion(const std::vector<Types::Trytes>& hashes) const;
 
@@ -271,6 +317,15 @@ public:
                                               const unsigned int&               minWeightMagnitude,
                                               const Types::Trytes& reference = "") const;
 
+  /**
+   * Async variant of sendTrytes. Proof of work, when done locally, also runs on the async executor.
+   *
+   * @return A future holding the transactions, or the exception raised while sending them.
+   */
+  std::future<std::vector<Models::Transaction>> sendTrytesAsync(
+      const std::vector<Types::Trytes>& trytes, const unsigned int& depth,
+      const unsigned int& minWeightMagnitude, const Types::Trytes& reference = "") const;
+
   /**
    * Wrapper function that does broadcastTransactions and storeTransactions.
    *
@@ -364,6 +419,18 @@ public:
   Responses::ReplayBundle replayBundle(const Types::Trytes& transaction, int depth,
                                        int minWeightMagnitude) const;
 
+  /**
+   * Reattaches a bundle by doing Proof of Work again, like replayBundle.
+   *
+   * @param tail               Hash of the tail transaction of the bundle.
+   * @param depth              The depth.
+   * @param minWeightMagnitude The minimum weight magnitude.
+   *
+   * @return The reattached transactions.
+   */
+  std::vector<Models::Transaction> reattachBundle(const Types::Trytes& tail, int depth,
+                                                  int minWeightMagnitude) const;
+
   /**
    * Prepares transfer by generating the bundle with the corresponding cosigner transactions.
    * Does not contain signatures.
@@ -416,7 +483,132 @@ public:
    **/
   std::vector<bool> isReattachable(const std::vector<Models::Address>& addresses);
 
+  /**
+   * Cache the bundles verified by getBundle and bundlesFromAddresses, so that a bundle is only
+   * fetched and verified once. Inclusion states are not cached. The cache is shared with copies of
+   * this api object. Should be set before the api object is shared between threads.
+   *
+   * @param capacity Maximum number of cached bundles, 0 to disable the cache.
+   */
+  void enableBundleCache(std::size_t capacity);
+
+  /**
+   * @return The bundle cache, null if disabled.
+   */
+  const std::shared_ptr<BundleCache>& getBundleCache() const;
+
+  /**
+   * Select how traverseBundles, getBundle and bundlesFromAddresses fetch bundles. When enabled,
+   * all the transactions sharing the bundle hashes are fetched at once and each bundle is
+   * reassembled locally by following the trunk chain of its tail, which tells reattachments
+   * apart. Otherwise, bundles are fetched trunk by trunk, one request per transaction index.
+   *
+   * @param enabled true to fetch whole bundles (default), false to traverse trunk by trunk.
+   */
+  void setWholeBundleFetch(bool enabled);
+
+  /**
+   * @return true if whole bundles are fetched at once.
+   */
+  bool getWholeBundleFetch() const;
+
+  /**
+   * Prefetch trunk/branch pairs in the background, so that sendTrytes does not wait for
+   * getTransactionsToApprove when no reference is given. The pool is shared with copies of this
+   * api object, and fetches through its own copy of the core api, so that it never refers to an
+   * api object destroyed before its copies. Should be set before the api object is shared between
+   * threads.
+   *
+   * @param poolSize Number of pairs kept per depth, 0 to disable the pool.
+   * @param maxAge Maximum age of a pair, in milliseconds.
+   */
+  void enableTipPool(std::size_t poolSize, int64_t maxAge = TipPool::DefaultMaxAge);
+
+  /**
+   * @return The tip pool, null if disabled.
+   */
+  const std::shared_ptr<TipPool>& getTipPool() const;
+
+  /**
+   * Set how long the latest solid milestone used by getLatestInclusion is reused before being
+   * fetched again with getNodeInfo. The milestone and the confirmed transactions are shared with
+   * copies of this api object.
+   *
+   * @param interval Interval in milliseconds, 0 to fetch the milestone on every call.
+   */
+  void setMilestoneRefreshInterval(int64_t interval);
+
+  /**
+   * @return The milestone refresh interval, in milliseconds.
+   */
+  int64_t getMilestoneRefreshInterval() const;
+
+  /**
+   * @return The transactions known to be confirmed.
+   */
+  const ConfirmedTailsCache& getConfirmedTails() const;
+
+  /**
+   * Keep track of the addresses known to be spent from, so that getNewAddresses and getInputs only
+   * ask the node about the other addresses. The store is shared with copies of this api object.
+   *
+   * @param store The store, null to always ask the node.
+   */
+  void setSpentAddressStore(const std::shared_ptr<SpentAddressStore>& store);
+
+  /**
+   * @return The spent address store, null if not set.
+   */
+  const std::shared_ptr<SpentAddressStore>& getSpentAddressStore() const;
+
 private:
+  /**
+   * Whether addresses were spent from. Addresses known to be spent by the store are not sent to
+   * the node, and the store is updated with the addresses the node reports as spent.
+   *
+   * @param addresses The addresses.
+   *
+   * @return The spent state of each address.
+   */
+  std::vector<bool> getSpentStates(const std::vector<Models::Address>& addresses) const;
+
+  /**
+   * Add the inputs and the remainder to the given builder, then finalize and sign the bundle.
+   *
+   * @param seed             Seed to be used for address generation.
+   * @param inputs           Inputs used for funding the transfer.
+   * @param builder          The builder, holding the outputs.
+   * @param tag              Tag of the transactions.
+   * @param totalValue       The total value to be transfered.
+   * @param remainderAddress If set, address the remainder value is sent to.
+   *
+   * @return Vector of trytes.
+   */
+  std::vector<Types::Trytes> addRemainder(const Models::Seed&                 seed,
+                                          const std::vector<Models::Address>& inputs,
+                                          Models::BundleBuilder&              builder,
+                                          const Models::Tag&                  tag,
+                                          int64_t                             totalValue,
+                                          const Models::Address& remainderAddress) const;
+
+
+  /**
+   * @return The latest solid milestone, fetched again if older than the refresh interval.
+   */
+  Types::Trytes getLatestSolidMilestone() const;
+
+  /**
+   * Fill the bundles of the given tail transactions, either by fetching the whole bundles at once
+   * or by traversing them trunk by trunk, depending on the whole bundle fetch setting.
+   *
+   * @param tails Hashes of the tail transactions.
+   * @param bundles Bundles to fill, one per tail.
+   * @param throwOnFail if true, throw on invalid tails. Otherwise, clear the bundle instead.
+   */
+  void fetchBundles(const std::vector<Types::Trytes>&                          tails,
+                    const std::vector<std::reference_wrapper<Models::Bundle>>& bundles,
+                    bool throwOnFail) const;
+
   void traverseBundles(const std::vector<Types::Trytes>&                          trxs,
                        const std::vector<std::reference_wrapper<Models::Bundle>>& bundles,
                        bool throwOnFail) const;
@@ -425,6 +617,66 @@ private:
    * @return true if all transfers are valid, false otherwise
    */
   static bool isTransfersCollectionValid(const std::vector<Models::Transfer>& transfers);
+
+  /**
+   * Look up a verified bundle in the cache.
+   *
+   * @param tail Hash of the tail transaction of the bundle.
+   * @param bundle Where to copy the bundle, if found.
+   *
+   * @return true if the bundle was found.
+   */
+  bool getCachedBundle(const Types::Trytes& tail, Models::Bundle& bundle) const;
+
+  /**
+   * Cache a verified bundle, if the cache is enabled.
+   *
+   * @param tail Hash of the tail transaction of the bundle.
+   * @param bundle The bundle.
+   */
+  void cacheBundle(const Types::Trytes& tail, const Models::Bundle& bundle) const;
+
+private:
+  /**
+   * Cache of verified bundles by tail hash, null if disabled.
+   */
+  std::shared_ptr<BundleCache> bundleCache_;
+
+  /**
+   * Whether bundles are fetched whole rather than trunk by trunk.
+   */
+  bool wholeBundleFetch_ = true;
+
+  /**
+   * Prefetched trunk/branch pairs, null if disabled.
+   */
+  std::shared_ptr<TipPool> tipPool_;
+
+  /**
+   * Latest solid milestone and confirmed transactions, shared between copies.
+   */
+  struct InclusionCache {
+    explicit InclusionCache(std::size_t capacity) : confirmedTails(capacity) {
+    }
+
+    std::mutex                milestoneMtx;
+    Types::Trytes             milestone;
+    std::chrono::milliseconds fetchedAt;
+    ConfirmedTailsCache       confirmedTails;
+  };
+
+  std::shared_ptr<InclusionCache> inclusionCache_ =
+      std::make_shared<InclusionCache>(DefaultConfirmedTailsCapacity);
+
+  /**
+   * How long the latest solid milestone is reused, in milliseconds.
+   */
+  int64_t milestoneRefreshInterval_ = DefaultMilestoneRefreshInterval;
+
+  /**
+   * Addresses known to be spent from, null if not set.
+   */
+  std::shared_ptr<SpentAddressStore> spentAddresses_;
 };
 
 }  // namespace API
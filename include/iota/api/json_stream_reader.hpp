@@ -0,0 +1,179 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <functional>
+#include <string>
+
+namespace IOTA {
+
+namespace API {
+
+/**
+ * Incremental reader for the json object returned by the node.
+ *
+ * The input can be fed in pieces of any size, as it arrives. Each scalar field of the top-level
+ * object, and each scalar element of a top-level array, is handed to the handler as soon as it is
+ * complete, together with the name of the field. Nested objects and arrays are skipped. Only the
+ * token being read is buffered, so memory does not grow with the size of the response.
+ *
+ * Strings are unescaped, other scalars (numbers, true, false, null) are passed as written.
+ */
+class JsonStreamReader {
+public:
+  /**
+   * Receives the name of a field and one of its values. The value can be moved from.
+   */
+  using Handler = std::function<void(const std::string& field, std::string&& value)>;
+
+public:
+  /**
+   * Full init ctor.
+   *
+   * @param handler Handler receiving the values of the response.
+   */
+  explicit JsonStreamReader(const Handler& handler);
+  /**
+   * Default dtor.
+   */
+  ~JsonStreamReader() = default;
+
+public:
+  /**
+   * Read the next piece of the input.
+   *
+   * @param data The input.
+   * @param size The size of the input.
+   */
+  void feed(const char* data, std::size_t size);
+
+  /**
+   * Check that the whole object has been read. Throws Errors::Unrecognized otherwise.
+   */
+  void finish() const;
+
+private:
+  /**
+   * Parser states.
+   */
+  enum class State {
+    ObjectStart,
+    KeyOrEnd,
+    Key,
+    Colon,
+    Value,
+    ElementOrEnd,
+    String,
+    Scalar,
+    Skip,
+    AfterValue,
+    AfterElement,
+    Done
+  };
+
+  /**
+   * Process one character.
+   *
+   * @param c The character.
+   *
+   * @return false if the character must be processed again in the new state.
+   */
+  bool step(char c);
+
+  /**
+   * Process one character of a string, handling escape sequences.
+   *
+   * @param c The character.
+   *
+   * @return true when the closing quote has been read.
+   */
+  bool readString(char c);
+
+  /**
+   * Start reading a value, either a top-level value or an array element.
+   *
+   * @param c The first character of the value.
+   */
+  void startValue(char c);
+
+  /**
+   * Hand the current value to the handler and move to the next state.
+   */
+  void endValue();
+
+  /**
+   * Throw an Errors::Unrecognized error.
+   *
+   * @param c The unexpected character.
+   */
+  [[noreturn]] void unexpected(char c) const;
+
+private:
+  /**
+   * Handler receiving the values.
+   */
+  Handler handler_;
+  /**
+   * Current state.
+   */
+  State state_;
+  /**
+   * Whether the value being read is an array element.
+   */
+  bool inArray_;
+  /**
+   * Name of the current field.
+   */
+  std::string field_;
+  /**
+   * Current token.
+   */
+  std::string token_;
+  /**
+   * Whether a backslash was just read in a string.
+   */
+  bool escape_;
+  /**
+   * Remaining hex digits of a \u escape sequence.
+   */
+  int unicodeDigits_;
+  /**
+   * Code point of the current \u escape sequence.
+   */
+  unsigned int unicode_;
+  /**
+   * Nesting depth of a skipped value.
+   */
+  int depth_;
+  /**
+   * Whether the skipped value is in a string.
+   */
+  bool skipInString_;
+};
+
+}  // namespace API
+
+}  // namespace IOTA
@@ -0,0 +1,179 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace IOTA {
+
+namespace API {
+
+/**
+ * Writer emitting compact json directly into a string, without building a document.
+ *
+ * Separators are inserted automatically: a value following a key is written as the value of that
+ * key, any other value is written as the next element of the enclosing array. The buffer is only
+ * appended to, so a caller can reuse the same string (and its capacity) for several documents by
+ * clearing it between them.
+ */
+class JsonWriter {
+public:
+  /**
+   * Full init ctor.
+   *
+   * @param buffer Where to append the json.
+   */
+  explicit JsonWriter(std::string& buffer);
+  /**
+   * Default dtor.
+   */
+  ~JsonWriter() = default;
+
+public:
+  /**
+   * Open an object.
+   */
+  void beginObject();
+
+  /**
+   * Close the current object.
+   */
+  void endObject();
+
+  /**
+   * Open an array.
+   */
+  void beginArray();
+
+  /**
+   * Close the current array.
+   */
+  void endArray();
+
+  /**
+   * Write the key of the next object member.
+   *
+   * @param name The key.
+   */
+  void key(const std::string& name);
+
+  /**
+   * Write a string value, escaped if needed.
+   *
+   * @param str The value.
+   */
+  void value(const std::string& str);
+
+  /**
+   * Write a string value, escaped if needed.
+   *
+   * @param str The value.
+   */
+  void value(const char* str);
+
+  /**
+   * Write an integer value.
+   *
+   * @param number The value.
+   */
+  void value(int64_t number);
+
+  /**
+   * Write an integer value.
+   *
+   * @param number The value.
+   */
+  void value(int number);
+
+  /**
+   * Write a boolean value.
+   *
+   * @param boolean The value.
+   */
+  void value(bool boolean);
+
+  /**
+   * Write an array of values.
+   *
+   * @param values The values.
+   */
+  template <typename T>
+  void
+  value(const std::vector<T>& values) {
+    beginArray();
+    for (const auto& v : values) {
+      value(v);
+    }
+    endArray();
+  }
+
+  /**
+   * Write an object member.
+   *
+   * @param name The key.
+   * @param v The value.
+   */
+  template <typename T>
+  void
+  field(const std::string& name, const T& v) {
+    key(name);
+    value(v);
+  }
+
+private:
+  /**
+   * Write the separator needed before a new value or key.
+   */
+  void separate();
+
+  /**
+   * Write a quoted and escaped string.
+   *
+   * @param str The string.
+   * @param length The length of the string.
+   */
+  void writeString(const char* str, std::size_t length);
+
+private:
+  /**
+   * Where the json is written.
+   */
+  std::string& buffer_;
+  /**
+   * For each open object or array, whether it is still empty.
+   */
+  std::vector<bool> empty_;
+  /**
+   * Whether a key has just been written.
+   */
+  bool afterKey_;
+};
+
+}  // namespace API
+
+}  // namespace IOTA
@@ -0,0 +1,201 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <cpr/cpr.h>
+
+#include <iota/api/session_pool.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+/**
+ * A node of a Service, with its sessions and its latency and health statistics.
+ *
+ * Latency is tracked as an exponentially weighted moving average, plus windows of recent samples
+ * used to compute percentiles, one over all the commands and one for each command. A node is
+ * unhealthy after several consecutive failures, until a
+ * retry delay has elapsed.
+ */
+class Node {
+public:
+  /**
+   * Number of recent latency samples kept for percentiles, for all the commands and for each one.
+   */
+  static constexpr std::size_t LatencyWindow = 64;
+  /**
+   * Number of consecutive failures after which a node is considered unhealthy.
+   */
+  static constexpr unsigned int MaxFailures = 3;
+  /**
+   * Delay after which an unhealthy node is tried again.
+   */
+  static constexpr std::chrono::seconds RetryDelay = std::chrono::seconds(30);
+
+public:
+  /**
+   * Full init ctor.
+   *
+   * @param url Url of the node.
+   * @param timeout Request timeout, in seconds.
+   * @param user Username for authenticated requests.
+   * @param pass Password for authenticated requests.
+   * @param maxIdle Maximum number of idle sessions kept for this node.
+   */
+  Node(const std::string& url, int timeout, const std::string& user = "",
+       const std::string& pass = "", std::size_t maxIdle = SessionPool::DefaultMaxIdle);
+  /**
+   * Default dtor.
+   */
+  ~Node() = default;
+
+public:
+  /**
+   * Post a json body to the node, recording the latency or the failure.
+   *
+   * @param body The json body.
+   * @param command The command of the request, whose latency is also tracked on its own.
+   *
+   * @return The raw http response.
+   */
+  cpr::Response post(std::string body, const std::string& command = "");
+
+  /**
+   * @return The url of the node.
+   */
+  const std::string& getUrl() const;
+
+  /**
+   * @return The sessions of the node.
+   */
+  SessionPool& getSessionPool();
+
+  /**
+   * Record a successful request.
+   *
+   * @param latency The latency of the request.
+   * @param command The command of the request, empty if unknown.
+   */
+  void recordSuccess(std::chrono::milliseconds latency, const std::string& command = "");
+
+  /**
+   * Record a failed request.
+   */
+  void recordFailure();
+
+  /**
+   * @return Whether the node should receive requests.
+   */
+  bool isHealthy() const;
+
+  /**
+   * @return The moving average of the latency, in milliseconds. 0 if never measured.
+   */
+  double getLatency() const;
+
+  /**
+   * @param percentile Percentile between 0 and 1.
+   * @param command The command whose samples are used, empty for all the commands.
+   *
+   * @return The latency percentile over the recent samples, in milliseconds. 0 if never measured.
+   */
+  double getLatencyPercentile(double percentile, const std::string& command = "") const;
+
+  /**
+   * @param command The command whose samples are counted, empty for all the commands.
+   *
+   * @return The number of latency samples recorded.
+   */
+  std::size_t getSamples(const std::string& command = "") const;
+
+  /**
+   * @return The number of consecutive failures.
+   */
+  unsigned int getFailures() const;
+
+private:
+  /**
+   * Recent latency samples, in milliseconds, used as a ring buffer.
+   */
+  struct Window {
+    /**
+     * Record a sample, replacing the oldest one once the window is full.
+     *
+     * @param sample The latency, in milliseconds.
+     */
+    void add(double sample);
+
+    /**
+     * The latest samples.
+     */
+    std::vector<double> samples;
+    /**
+     * Total number of samples.
+     */
+    std::size_t count = 0;
+  };
+
+private:
+  /**
+   * Url of the node.
+   */
+  std::string url_;
+  /**
+   * Pool of persistent sessions to the node.
+   */
+  SessionPool sessions_;
+  /**
+   * Moving average of the latency, in milliseconds.
+   */
+  double latency_;
+  /**
+   * Latency windows by command, the empty command holding the samples of all the commands.
+   */
+  std::map<std::string, Window> windows_;
+  /**
+   * Number of consecutive failures.
+   */
+  unsigned int failures_;
+  /**
+   * Time of the last failure.
+   */
+  std::chrono::steady_clock::time_point lastFailure_;
+  /**
+   * Protects the statistics.
+   */
+  mutable std::mutex mtx_;
+};
+
+}  // namespace API
+
+}  // namespace IOTA
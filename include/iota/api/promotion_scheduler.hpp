@@ -0,0 +1,252 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <iota/api/extended.hpp>
+#include <iota/models/transfer.hpp>
+#include <iota/types/trytes.hpp>
+#include <iota/utils/thread_pool.hpp>
+#include <iota/utils/timer_wheel.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+/**
+ * Promotes or reattaches pending bundles until they are confirmed.
+ *
+ * All the tracked bundles are held on a timer wheel driven by a single thread. When their timers
+ * expire, bundles are checked together: one getInclusionStates call for all their tails, and
+ * checkConsistency calls on the whole set, only split in halves when it is inconsistent. Confirmed
+ * bundles are dropped, consistent ones are promoted and the others reattached. Promotions and
+ * reattachments run on a shared pool, bounding the number of concurrent proof of work.
+ */
+class PromotionScheduler {
+public:
+  /**
+   * Called with the tracked tail of a bundle when the bundle is confirmed.
+   */
+  using Callback = std::function<void(const Types::Trytes& tail)>;
+
+  /**
+   * Default delay between two checks of a bundle, in milliseconds.
+   */
+  static constexpr int64_t DefaultInterval = 30000;
+
+  /**
+   * Default number of concurrent promotions and reattachments.
+   */
+  static constexpr std::size_t DefaultMaxPow = 2;
+
+  /**
+   * Duration of a tick of the timer wheel, in milliseconds.
+   */
+  static constexpr int64_t Tick = 500;
+
+  /**
+   * Number of slots of the timer wheel.
+   */
+  static constexpr std::size_t WheelSlots = 128;
+
+public:
+  /**
+   * Full init ctor. Starts the scheduler thread.
+   *
+   * @param api The api used to check, promote and reattach, must outlive this object.
+   * @param promotion The zero-value transfer sent to promote a bundle.
+   * @param depth The depth.
+   * @param minWeightMagnitude The minimum weight magnitude.
+   * @param interval Delay between two checks of a bundle, in milliseconds.
+   * @param maxPow Number of concurrent promotions and reattachments.
+   */
+  PromotionScheduler(const Extended& api, const Models::Transfer& promotion, int depth,
+                     int minWeightMagnitude, int64_t interval = DefaultInterval,
+                     std::size_t maxPow = DefaultMaxPow);
+  /**
+   * Dtor. Stops the scheduler thread and waits for the promotions and reattachments in progress.
+   */
+  ~PromotionScheduler();
+
+  /**
+   * Non-copyable.
+   */
+  PromotionScheduler(const PromotionScheduler&) = delete;
+  PromotionScheduler& operator=(const PromotionScheduler&) = delete;
+
+public:
+  /**
+   * Track a bundle until it is confirmed. It is first checked after one interval.
+   *
+   * @param tail Hash of the tail transaction of the bundle.
+   */
+  void track(const Types::Trytes& tail);
+
+  /**
+   * Stop tracking a bundle.
+   *
+   * @param tail Hash of the tail transaction the bundle was tracked with.
+   */
+  void untrack(const Types::Trytes& tail);
+
+  /**
+   * @param callback Called when a tracked bundle is confirmed, from the scheduler thread.
+   */
+  void setOnConfirmed(const Callback& callback);
+
+  /**
+   * @return Number of tracked bundles.
+   */
+  std::size_t getPending() const;
+
+  /**
+   * @return Number of promotions sent.
+   */
+  std::size_t getPromotions() const;
+
+  /**
+   * @return Number of reattachments sent.
+   */
+  std::size_t getReattachments() const;
+
+private:
+  /**
+   * A tracked bundle.
+   */
+  struct Pending {
+    /**
+     * Tails of the bundle, the tracked one first, then the reattachments.
+     */
+    std::vector<Types::Trytes> tails;
+    /**
+     * Whether a promotion or reattachment is in progress.
+     */
+    bool busy = false;
+    /**
+     * Number of the timer of the next check. Other timers of the same tail, left on the wheel when
+     * it was untracked, are ignored.
+     */
+    std::size_t timer = 0;
+  };
+
+  /**
+   * A timer on the wheel: tracked tail of the bundle, and number of the timer.
+   */
+  using Timer = std::pair<Types::Trytes, std::size_t>;
+
+private:
+  /**
+   * Scheduler thread loop.
+   */
+  void run();
+
+  /**
+   * Check the bundles whose timers expired, and promote, reattach or drop them.
+   *
+   * @param due The expired timers.
+   */
+  void process(const std::vector<Timer>& due);
+
+  /**
+   * Check consistency of tails [first, last), splitting the range while inconsistent.
+   *
+   * @param tails The tails.
+   * @param first First tail to check.
+   * @param last End of the tails to check.
+   * @param promotable Set to true for each consistent tail.
+   */
+  void checkConsistency(const std::vector<Types::Trytes>& tails, std::size_t first,
+                        std::size_t last, std::vector<bool>& promotable) const;
+
+  /**
+   * Promote or reattach a bundle on the pool, then schedule its next check.
+   *
+   * @param id Tracked tail of the bundle.
+   * @param tail Latest tail of the bundle.
+   * @param promote true to promote, false to reattach.
+   */
+  void dispatch(const Types::Trytes& id, const Types::Trytes& tail, bool promote);
+
+  /**
+   * Schedule the next check of a tracked bundle, replacing its previous timer. Must be called with
+   * the lock held.
+   */
+  void schedule(const Types::Trytes& id);
+
+private:
+  const Extended&               api_;
+  std::vector<Models::Transfer> promotion_;
+  int                           depth_;
+  int                           minWeightMagnitude_;
+  std::chrono::milliseconds     interval_;
+
+  /**
+   * Tracked bundles, by tracked tail.
+   */
+  std::map<Types::Trytes, Pending> pending_;
+  /**
+   * Next check of each tracked bundle.
+   */
+  Utils::TimerWheel<Timer> wheel_;
+  /**
+   * Number of timers scheduled so far.
+   */
+  std::size_t timers_;
+
+  Callback    onConfirmed_;
+  std::size_t promotions_;
+  std::size_t reattachments_;
+  bool        stop_;
+
+  /**
+   * Protects the whole state of the scheduler.
+   */
+  mutable std::mutex      mtx_;
+  std::condition_variable cv_;
+
+  /**
+   * Promotions and reattachments, destroyed before the state they update.
+   */
+  Utils::ThreadPool pow_;
+
+  /**
+   * Scheduler thread, started last.
+   */
+  std::thread thread_;
+};
+
+}  // namespace API
+
+}  // namespace IOTA
@@ -27,6 +27,8 @@
 
 #include <nlohmann/json.hpp>
 
+#include <iota/api/json_writer.hpp>
+
 using json = nlohmann::json;
 
 namespace IOTA {
@@ -60,6 +62,19 @@ public:
    */
   virtual void serialize(json& data) const;
 
+  /**
+   * Serialize object directly as json text, without building a json document. Writes the members
+   * of the request object, the caller opens and closes the object.
+   *
+   * @param writer where to write serialisation.
+   */
+  virtual void serialize(JsonWriter& writer) const;
+
+  /**
+   * @return The command name.
+   */
+  const std::string& getCommand() const;
+
 private:
   /**
    * The command name.
@@ -69,6 +69,13 @@ public:
    */
   void serialize(json& data) const override;
 
+  /**
+   * Serialize object directly as json text, without building a json document.
+   *
+   * @param writer where to write serialisation.
+   */
+  void serialize(JsonWriter& writer) const override;
+
 private:
   /**
    * List of addresses you want to get the confirmed balance from.
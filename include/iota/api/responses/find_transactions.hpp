@@ -79,6 +79,13 @@ public:
    */
   const std::vector<Types::Trytes>& getHashes() const;
 
+  /**
+   * Non-const getHashes, allows callers to move or extend the hashes of the response.
+   *
+   * @return hashes.
+   */
+  std::vector<Types::Trytes>& getHashes();
+
 private:
   /**
    * The transaction hashes which are returned depend on your input. For each specified input value,
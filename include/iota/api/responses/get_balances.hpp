@@ -93,6 +93,13 @@ public:
    */
   const std::vector<std::string>& getBalances() const;
 
+  /**
+   * Non-const getBalances, allows callers to move or extend the balances of the response.
+   *
+   * @return balances.
+   */
+  std::vector<std::string>& getBalances();
+
   /**
    * @return referencing tips (or milestone)
    */
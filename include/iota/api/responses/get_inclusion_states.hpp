@@ -80,6 +80,13 @@ public:
    */
   const std::vector<bool>& getStates() const;
 
+  /**
+   * Non-const getStates, allows callers to move or extend the states of the response.
+   *
+   * @return Inclusion states of the set of transactions.
+   */
+  std::vector<bool>& getStates();
+
 private:
   /**
    * List of boolean values in the same order as the transaction list you submitted, thus you get a
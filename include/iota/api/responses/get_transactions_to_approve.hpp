@@ -26,7 +26,7 @@
 #pragma once
 
 #include <iota/api/responses/base.hpp>
-#include <iota/types/trytes.hpp>
+#include <iota/types/hash.hpp>
 
 namespace IOTA {
 
@@ -52,8 +52,8 @@ public:
    * @param trunkTransaction The trunk transaction.
    * @param branchTransaction The branch transaction.
    */
-  explicit GetTransactionsToApprove(const Types::Trytes& trunkTransaction  = "",
-                                    const Types::Trytes& branchTransaction = "");
+  explicit GetTransactionsToApprove(const Types::Hash& trunkTransaction  = {},
+                                    const Types::Hash& branchTransaction = {});
 
   /**
    * Json-based ctor.
@@ -79,22 +79,22 @@ public:
   /**
    * @return trunk transaction.
    */
-  const Types::Trytes& getTrunkTransaction() const;
+  const Types::Hash& getTrunkTransaction() const;
 
   /**
    * @return branch transaction.
    */
-  const Types::Trytes& getBranchTransaction() const;
+  const Types::Hash& getBranchTransaction() const;
 
 private:
   /**
    * Trunk transaction.
    */
-  Types::Trytes trunkTransaction_;
+  Types::Hash trunkTransaction_;
   /**
    * Branch transaction.
    */
-  Types::Trytes branchTransaction_;
+  Types::Hash branchTransaction_;
 };
 
 }  // namespace Responses
@@ -77,6 +77,13 @@ public:
    */
   const std::vector<Types::Trytes>& getTrytes() const;
 
+  /**
+   * Non-const getTrytes, allows callers to move the trytes out of the response.
+   *
+   * @return trytes.
+   */
+  std::vector<Types::Trytes>& getTrytes();
+
 private:
   /**
    * Raw transaction data (trytes) of the transaction.
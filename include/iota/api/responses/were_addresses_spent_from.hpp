@@ -75,6 +75,13 @@ public:
    */
   const std::vector<bool>& getStates() const;
 
+  /**
+   * Non-const getStates, allows callers to move or extend the states of the response.
+   *
+   * @return Inclusion states of the set of transactions.
+   */
+  std::vector<bool>& getStates();
+
 private:
   /**
    * List of state if addresses were spent from.
@@ -0,0 +1,242 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <iota/api/extended.hpp>
+#include <iota/api/responses/send_transfer.hpp>
+#include <iota/models/address.hpp>
+#include <iota/models/seed.hpp>
+#include <iota/models/transfer.hpp>
+#include <iota/types/trytes.hpp>
+#include <iota/utils/blocking_queue.hpp>
+#include <iota/utils/stop_watch.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+/**
+ * Pipelined equivalent of Extended::sendTransfer, for sending many bundles.
+ *
+ * Each stage runs on its own thread and hands bundles to the next one through a bounded queue:
+ *  * prepare: prepareTransfers, including signing,
+ *  * tips: getTransactionsToApprove, prefetched ahead of the pow stage,
+ *  * pow: attachToTangle,
+ *  * broadcast: broadcastAndStore, then a single confirmation check per bundle.
+ * Bundle k+1 is thus prepared while bundle k is attached and bundle k-1 is broadcast.
+ *
+ * Bundles are prepared concurrently with the previous ones being sent, before the node reports the
+ * inputs of the previous ones as spent. Automatic input selection would pick and sign the same
+ * addresses again, so value transfers must be given their inputs explicitly, disjoint between
+ * bundles.
+ */
+class SendPipeline {
+public:
+  /**
+   * Pipeline stages, in order.
+   */
+  enum class Stage { Prepare, Tips, Pow, Broadcast };
+
+  /**
+   * Latency statistics of a stage.
+   */
+  struct StageStats {
+    /**
+     * Number of bundles that went through the stage.
+     */
+    std::size_t count = 0;
+    /**
+     * Total time spent in the stage, in milliseconds.
+     */
+    int64_t totalDuration = 0;
+    /**
+     * Longest time spent in the stage by one bundle, in milliseconds.
+     */
+    int64_t maxDuration = 0;
+  };
+
+  /**
+   * Default number of bundles buffered between two stages.
+   */
+  static constexpr std::size_t DefaultQueueCapacity = 4;
+
+  /**
+   * Tips older than this are discarded instead of being attached to, in milliseconds.
+   */
+  static constexpr int64_t MaxTipsAge = 30000;
+
+public:
+  /**
+   * Full init ctor. Starts the stage threads.
+   *
+   * @param api The api used to send, must outlive this object.
+   * @param depth The depth used for tip selection.
+   * @param minWeightMagnitude The minimum weight magnitude.
+   * @param reference Hash of transaction to start random-walk from, empty for none.
+   * @param queueCapacity Number of bundles buffered between two stages.
+   */
+  SendPipeline(const Extended& api, int depth, int minWeightMagnitude,
+               const Types::Trytes& reference = "",
+               std::size_t          queueCapacity = DefaultQueueCapacity);
+  /**
+   * Dtor. Sends the bundles already submitted, then stops the stage threads.
+   */
+  ~SendPipeline();
+
+  /**
+   * Non-copyable.
+   */
+  SendPipeline(const SendPipeline&) = delete;
+  SendPipeline& operator=(const SendPipeline&) = delete;
+
+public:
+  /**
+   * Queue a bundle for sending. Blocks while the prepare stage is full.
+   * Throws if the transfers have a value but no inputs are given.
+   *
+   * @param seed      Seed to be used for address generation and signing.
+   * @param transfers Array of transfer objects.
+   * @param inputs    Inputs, required for value transfers. Only zero-value transfers may leave it
+   * empty.
+   * @param remainder Address for the remainder value. Leave empty to automatically choose one.
+   *
+   * @return Future of the result, as returned by Extended::sendTransfer. Holds the exception
+   * thrown by any stage if the bundle could not be sent.
+   */
+  std::future<Responses::SendTransfer> submit(const Models::Seed&                  seed,
+                                              const std::vector<Models::Transfer>& transfers,
+                                              const std::vector<Models::Address>&  inputs = {},
+                                              const Models::Address& remainder = {});
+
+  /**
+   * @param stage The stage.
+   *
+   * @return The latency statistics of the stage.
+   */
+  StageStats getStageStats(Stage stage) const;
+
+  /**
+   * @return Number of bundles sent, successfully or not.
+   */
+  std::size_t getCompleted() const;
+
+  /**
+   * @return Number of bundles sent per second since the pipeline started.
+   */
+  double getThroughput() const;
+
+private:
+  /**
+   * A bundle going through the pipeline.
+   */
+  struct Job {
+    Models::Seed                          seed;
+    std::vector<Models::Transfer>         transfers;
+    std::vector<Models::Address>          inputs;
+    Models::Address                       remainder;
+    std::vector<Types::Trytes>            trytes;
+    std::promise<Responses::SendTransfer> promise;
+    Utils::StopWatch                      stopWatch;
+  };
+
+  /**
+   * Tips fetched ahead of the pow stage.
+   */
+  struct Tips {
+    Types::Trytes             trunk;
+    Types::Trytes             branch;
+    std::chrono::milliseconds fetchedAt;
+    std::exception_ptr        error;
+  };
+
+private:
+  void prepareStage();
+  void tipsStage();
+  void powStage();
+  void broadcastStage();
+
+  /**
+   * @return Tips, fetched now.
+   */
+  Tips fetchTips();
+
+  /**
+   * Account the time spent by a bundle in a stage.
+   */
+  void record(Stage stage, int64_t duration);
+
+  /**
+   * Fail a bundle, and account it as completed.
+   */
+  void fail(std::unique_ptr<Job>& job, std::exception_ptr error);
+
+  /**
+   * Account a bundle as completed.
+   */
+  void complete();
+
+private:
+  const Extended& api_;
+  int             depth_;
+  int             minWeightMagnitude_;
+  Types::Trytes   reference_;
+
+  Utils::BlockingQueue<std::unique_ptr<Job>> prepareQueue_;
+  Utils::BlockingQueue<Tips>                 tipsQueue_;
+  Utils::BlockingQueue<std::unique_ptr<Job>> powQueue_;
+  Utils::BlockingQueue<std::unique_ptr<Job>> broadcastQueue_;
+
+  /**
+   * Started with the pipeline, for the throughput.
+   */
+  Utils::StopWatch stopWatch_;
+
+  /**
+   * Protects the statistics.
+   */
+  mutable std::mutex        statsMtx_;
+  std::array<StageStats, 4> stats_;
+  std::size_t               completed_;
+
+  /**
+   * Stage threads, started last.
+   */
+  std::vector<std::thread> threads_;
+};
+
+}  // namespace API
+
+}  // namespace IOTA
@@ -25,10 +25,16 @@
 
 #pragma once
 
+#include <memory>
+#include <vector>
+
 #include <cpr/cpr.h>
 #include <cpr/auth.h>
 #include <nlohmann/json.hpp>
 
+#include <iota/api/json_stream_reader.hpp>
+#include <iota/api/node.hpp>
+#include <iota/api/requests/base.hpp>
 #include <iota/constants.hpp>
 #include <iota/errors/bad_request.hpp>
 #include <iota/errors/internal_server_error.hpp>
@@ -43,9 +49,26 @@ namespace IOTA {
 namespace API {
 
 /**
- * Service to contact a IOTA node.
+ * Service to contact one or several IOTA nodes.
+ *
+ * Requests go through pools of persistent HTTP sessions, so connections to the nodes are reused
+ * across calls and across threads. Copies of a service share the same nodes.
+ *
+ * With several nodes, read-only commands go to the fastest healthy node, and fail over to the
+ * next ones on network errors. When a read takes longer than the chosen latency percentile of its
+ * node for this command, a duplicate request is sent to the next fastest node and the first answer
+ * wins. Hedged reads run on a bounded number of threads, shared by copies of the service, and reads
+ * beyond that bound are not hedged.
+ * broadcastTransactions and storeTransactions can be sent to all nodes at once. Commands about a
+ * node itself (neighbors, remote proof of work and its interruption) always go to the first node.
  */
 class Service {
+public:
+  /**
+   * Maximum number of requests sent by hedged reads at the same time.
+   */
+  static constexpr std::size_t MaxHedgedRequests = 16;
+
 public:
   /**
    * Full init ctor.
@@ -72,74 +95,170 @@ public:
   Response request(Args&&... args) const {
     auto request = Request{ args... };
 
-    json data;
-    request.serialize(data);
-
-    auto url     = cpr::Url{ host_ + ":" + std::to_string(port_) };
-    auto body    = cpr::Body{ data.dump() };
-    auto headers = cpr::Header{ { "Content-Type", "application/json" },
-                                { "Content-Length", std::to_string(body.size()) },
-                                { "X-IOTA-API-Version", APIVersion } };
-    cpr::Response res;
-    if(!user_.empty() && !pass_.empty() && host_.compare(0,5,"https") == 0){
-      res = cpr::Post(url, body, headers, cpr::Timeout{ timeout_ * 1000 }, cpr::Authentication{user_, pass_});
-    }
-    else
-      res = cpr::Post(url, body, headers, cpr::Timeout{ timeout_ * 1000 });
-    if (res.error.code != cpr::ErrorCode::OK)
-      throw Errors::Network(res.error.message);
-
-    json        resJson;
-    std::string error;
-
-    try {
-      resJson = json::parse(res.text);
-
-      if (resJson.count("error")) {
-        error = resJson["error"].get<decltype(error)>();
-      }
-    } catch (const std::runtime_error&) {
-      if (res.elapsed >= timeout_) {
-        throw Errors::Network("Time out after " + std::to_string(timeout_) + "s");
-      }
-
-      throw Errors::Unrecognized("Invalid reply from node (unrecognized format): " + res.text);
-    }
-
-    Response response;
-    switch (res.status_code) {
-      case 200:
-        return Response{ resJson };
-      case 400:
-        throw Errors::BadRequest(error);
-      case 401:
-        throw Errors::Unauthorized(error);
-      case 500:
-        throw Errors::InternalServerError(error);
-      default:
-        if (res.elapsed >= timeout_) {
-          throw Errors::Network("Time out after " + std::to_string(timeout_) + "s");
-        }
-
-        throw Errors::Unrecognized(error);
-    }
-
-    return response;
+    return Response{ parse(post(serialize(request), request.getCommand())) };
+  }
+
+  /**
+   * Request to the node, decoding the response as it is read instead of building a json document.
+   * Errors are reported the same way as for request.
+   *
+   * @param reader Reader receiving the fields of the response.
+   * @param args The request parameters.
+   */
+  template <typename Request, typename... Args>
+  void stream(JsonStreamReader& reader, Args&&... args) const {
+    auto request = Request{ args... };
+
+    read(post(serialize(request), request.getCommand()), reader);
   }
 
+  /**
+   * Add a node to the service. Should be called before the service is shared between threads.
+   *
+   * @param host Host of the node.
+   * @param port Port of the node.
+   */
+  void addNode(const std::string& host, const uint16_t& port);
+
+  /**
+   * @return The nodes of the service, the first one being the one given at construction.
+   */
+  const std::vector<std::shared_ptr<Node>>& getNodes() const;
+
+  /**
+   * @return The healthy nodes, fastest first. All the nodes in order if none is healthy.
+   */
+  std::vector<std::shared_ptr<Node>> rankNodes() const;
+
+  /**
+   * Measure the latency of every node with a getNodeInfo request, sent to all nodes in parallel.
+   */
+  void probe() const;
+
+  /**
+   * @param broadcast Whether broadcastTransactions and storeTransactions are sent to all nodes.
+   */
+  void setBroadcastToAllNodes(bool broadcast);
+
+  /**
+   * @return Whether broadcastTransactions and storeTransactions are sent to all nodes.
+   */
+  bool getBroadcastToAllNodes() const;
+
+  /**
+   * @param percentile Latency percentile of a node, between 0 and 1, after which a read is sent
+   * again to the next fastest node. 0 disables hedged reads.
+   */
+  void setHedgePercentile(double percentile);
+
+  /**
+   * @return The latency percentile after which reads are hedged, 0 if disabled.
+   */
+  double getHedgePercentile() const;
+
+  /**
+   * Keep at least this number of idle sessions for each node.
+   *
+   * @param maxIdle The number of idle sessions.
+   */
+  void reserveSessions(std::size_t maxIdle);
+
 private:
   /**
-   * Host of the node.
+   * Serialize a request directly as json text.
+   *
+   * @param request The request.
+   *
+   * @return The json body of the request.
    */
-  std::string host_;
+  static std::string serialize(const Requests::Base& request);
+
   /**
-   * Port of the node.
+   * How a command is sent to the nodes.
    */
-  unsigned int port_;
+  enum class Routing {
+    //! fastest node, hedged, with failover
+    Read,
+    //! fastest node with failover, or all nodes if broadcasting to all nodes
+    Write,
+    //! first node only
+    Primary
+  };
+
+  /**
+   * @param command The command name.
+   *
+   * @return How the command is sent to the nodes.
+   */
+  static Routing routingOf(const std::string& command);
+
+  /**
+   * Post a serialized request to the nodes, routed according to its command.
+   *
+   * @param body The json body of the request.
+   * @param command The command of the request.
+   *
+   * @return The raw http response.
+   */
+  cpr::Response post(std::string&& body, const std::string& command) const;
+
+  /**
+   * Post a request to the fastest node, trying the next ones on failure.
+   *
+   * @param body The json body of the request.
+   * @param command The command of the request.
+   * @param hedge Whether the request may be hedged.
+   *
+   * @return The raw http response.
+   */
+  cpr::Response postWithFailover(const std::string& body, const std::string& command,
+                                 bool hedge) const;
+
+  /**
+   * Post a request to a node, and to a second one if the first is slower than its latency
+   * percentile for the command or fails. Both requests run on the hedging threads, whose two slots
+   * must have been acquired by the caller.
+   *
+   * @return The first successful response, or the last failure.
+   */
+  cpr::Response postHedged(const std::shared_ptr<Node>& primary,
+                           const std::shared_ptr<Node>& secondary, const std::string& body,
+                           const std::string& command) const;
+
+  /**
+   * Post a request to all nodes in parallel.
+   *
+   * @return The first successful response in node order, or the last failure.
+   */
+  cpr::Response postToAll(const std::string& body, const std::string& command) const;
+
+  /**
+   * Parse the response of the node, throwing the matching error if the request failed.
+   *
+   * @param res The raw http response.
+   *
+   * @return The json response.
+   */
+  json parse(const cpr::Response& res) const;
+
+  /**
+   * Feed the response of the node to a reader, throwing the matching error if the request failed.
+   *
+   * @param res The raw http response.
+   * @param reader The reader.
+   */
+  void read(const cpr::Response& res, JsonStreamReader& reader) const;
+
+  /**
+   * Threads running hedged reads, with the count of their requests.
+   */
+  struct Hedges;
+
+private:
   /**
    * Timeout for requests.
    */
-  const int timeout_;
+  int timeout_;
   /**
    * Username for authenticated requests.
    */
@@ -148,6 +267,26 @@ private:
    * Password for authenticated requests.
    */
   std::string pass_;
+  /**
+   * Number of idle sessions kept for each node.
+   */
+  std::size_t maxIdle_;
+  /**
+   * Nodes of the service.
+   */
+  std::vector<std::shared_ptr<Node>> nodes_;
+  /**
+   * Whether writes are sent to all nodes.
+   */
+  bool broadcastToAll_;
+  /**
+   * Latency percentile after which reads are hedged, 0 if disabled.
+   */
+  double hedgePercentile_;
+  /**
+   * Threads running hedged reads, shared by copies.
+   */
+  std::shared_ptr<Hedges> hedges_;
 };
 
 }  // namespace API
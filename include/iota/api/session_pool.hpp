@@ -0,0 +1,141 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <cpr/cpr.h>
+
+namespace IOTA {
+
+namespace API {
+
+/**
+ * Thread-safe pool of reusable HTTP sessions to a single node.
+ *
+ * Each session keeps its underlying connection open between requests (keep-alive), so that
+ * consecutive calls avoid a new TCP/TLS handshake. Sessions are created on demand when the pool is
+ * empty and returned to it after use, up to a maximum number of idle sessions.
+ */
+class SessionPool {
+public:
+  /**
+   * Default maximum number of idle sessions kept in the pool.
+   */
+  static constexpr std::size_t DefaultMaxIdle = 16;
+
+public:
+  /**
+   * Full init ctor.
+   *
+   * @param url Url of the node.
+   * @param timeout Request timeout, in seconds.
+   * @param user Username for authenticated requests.
+   * @param pass Password for authenticated requests.
+   * @param maxIdle Maximum number of idle sessions kept in the pool.
+   */
+  SessionPool(const std::string& url, int timeout, const std::string& user = "",
+              const std::string& pass = "", std::size_t maxIdle = DefaultMaxIdle);
+  /**
+   * Default dtor.
+   */
+  ~SessionPool() = default;
+
+  /**
+   * Non-copyable.
+   */
+  SessionPool(const SessionPool&) = delete;
+  SessionPool& operator=(const SessionPool&) = delete;
+
+public:
+  /**
+   * Take a session out of the pool, or create a new one if none is idle.
+   * The session is already configured with the url, timeout and credentials.
+   *
+   * @return The session, to be given back with release.
+   */
+  std::unique_ptr<cpr::Session> acquire();
+
+  /**
+   * Give a session back to the pool. The session is destroyed if the pool is full.
+   *
+   * @param session The session to give back.
+   */
+  void release(std::unique_ptr<cpr::Session> session);
+
+  /**
+   * @return The number of idle sessions currently in the pool.
+   */
+  std::size_t idle() const;
+
+  /**
+   * @return The maximum number of idle sessions kept in the pool.
+   */
+  std::size_t getMaxIdle() const;
+
+  /**
+   * @param maxIdle The maximum number of idle sessions kept in the pool. Idle sessions in excess
+   * are destroyed.
+   */
+  void setMaxIdle(std::size_t maxIdle);
+
+private:
+  /**
+   * Url of the node.
+   */
+  std::string url_;
+  /**
+   * Timeout for requests, in seconds.
+   */
+  int timeout_;
+  /**
+   * Username for authenticated requests.
+   */
+  std::string user_;
+  /**
+   * Password for authenticated requests.
+   */
+  std::string pass_;
+  /**
+   * Maximum number of idle sessions.
+   */
+  std::size_t maxIdle_;
+  /**
+   * Idle sessions.
+   */
+  std::vector<std::unique_ptr<cpr::Session>> sessions_;
+  /**
+   * Protects sessions_ and maxIdle_.
+   */
+  mutable std::mutex mtx_;
+};
+
+}  // namespace API
+
+}  // namespace IOTA
@@ -0,0 +1,170 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <iota/constants.hpp>
+#include <iota/types/trytes.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+/**
+ * Local index of the addresses known to have been spent from.
+ *
+ * An address never goes back from spent to unspent, so once the node reported an address as spent
+ * there is no need to ask again. Addresses are stored as 48-byte records (the Kerl byte encoding of
+ * their first 242 trits, the last trit of an address always being 0).
+ *
+ * When backed by a file, the records are kept sorted in that file and looked up by binary search,
+ * while new records are appended to a journal (the path suffixed by ".log") and kept sorted in
+ * memory until they are merged into the file by compact. The journal is merged when the store is
+ * opened, so that an interrupted process never loses a record. Without a file, all the records are
+ * kept in memory.
+ *
+ * An in-memory Bloom filter answers most of the lookups of unspent addresses without touching the
+ * file.
+ *
+ * Thread-safe.
+ */
+class SpentAddressStore {
+public:
+  /**
+   * Binary encoding of an address.
+   */
+  using Record = std::array<uint8_t, ByteHashLength>;
+
+  /**
+   * Number of journaled records that triggers a compaction.
+   */
+  static constexpr std::size_t DefaultCompactThreshold = 4096;
+
+public:
+  /**
+   * Full init ctor. Opens the store, creating it if needed, and merges its journal.
+   *
+   * @param path Path of the file backing the store, empty to keep the store in memory.
+   * @param compactThreshold Number of journaled records that triggers a compaction.
+   */
+  explicit SpentAddressStore(const std::string& path             = "",
+                             std::size_t        compactThreshold = DefaultCompactThreshold);
+  /**
+   * Default dtor.
+   */
+  ~SpentAddressStore() = default;
+
+  SpentAddressStore(const SpentAddressStore&) = delete;
+  SpentAddressStore& operator=(const SpentAddressStore&) = delete;
+
+public:
+  /**
+   * @param address The address, checksum is ignored.
+   *
+   * @return true if the address is known to be spent.
+   */
+  bool contains(const Types::Trytes& address) const;
+
+  /**
+   * Mark an address as spent.
+   *
+   * @param address The address, checksum is ignored.
+   */
+  void add(const Types::Trytes& address);
+
+  /**
+   * Mark addresses as spent.
+   *
+   * @param addresses The addresses, checksums are ignored.
+   */
+  void add(const std::vector<Types::Trytes>& addresses);
+
+  /**
+   * @return Number of addresses in the store.
+   */
+  std::size_t size() const;
+
+  /**
+   * Merge the journal into the sorted file. No-op for a store kept in memory.
+   */
+  void compact();
+
+  /**
+   * @param address The address, checksum is ignored.
+   *
+   * @return The binary encoding of the address.
+   */
+  static Record toRecord(const Types::Trytes& address);
+
+private:
+  void addRecord(const Record& record);
+  bool containsRecord(const Record& record) const;
+  bool fileContains(const Record& record) const;
+  void compactRecords();
+
+  /**
+   * Size the Bloom filter for the given number of records, and fill it again.
+   */
+  void resizeFilter(std::size_t capacity);
+  void addToFilter(const Record& record);
+  bool filterContains(const Record& record) const;
+
+  std::string journalPath() const;
+
+private:
+  mutable std::mutex mtx_;
+
+  std::string path_;
+  std::size_t compactThreshold_;
+
+  /**
+   * Sorted file, and number of records it holds.
+   */
+  mutable std::ifstream file_;
+  std::size_t           fileCount_ = 0;
+
+  /**
+   * Journal, and its records sorted (all the records for a store kept in memory).
+   */
+  std::ofstream       journal_;
+  std::vector<Record> pending_;
+
+  /**
+   * Bloom filter, and the number of records it was sized for.
+   */
+  std::vector<uint64_t> filter_;
+  std::size_t           filterCapacity_ = 0;
+};
+
+}  // namespace API
+
+}  // namespace IOTA
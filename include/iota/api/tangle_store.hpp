@@ -0,0 +1,167 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <iota/models/compact_transaction.hpp>
+#include <iota/models/fwd.hpp>
+#include <iota/types/hash.hpp>
+#include <iota/types/trytes.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+/**
+ * Embedded, append-only store of transactions, indexed by hash, address, bundle, tag and approvee
+ * (trunk and branch transactions).
+ *
+ * Transactions are stored in their CompactTransaction binary form, one fixed-size record after the
+ * other. When backed by a file, records are appended to the file and read back from it on lookups,
+ * only the indexes are kept in memory and they are rebuilt by scanning the file when the store is
+ * opened. Without a file, the records are kept in memory.
+ *
+ * See Core::setTangleStore to answer getTrytes from the store.
+ *
+ * Thread-safe.
+ */
+class TangleStore {
+public:
+  /**
+   * Full init ctor. Opens the store, creating it if needed, and indexes its transactions.
+   *
+   * @param path Path of the file backing the store, empty to keep the store in memory.
+   */
+  explicit TangleStore(const std::string& path = "");
+  /**
+   * Default dtor.
+   */
+  ~TangleStore() = default;
+
+  TangleStore(const TangleStore&) = delete;
+  TangleStore& operator=(const TangleStore&) = delete;
+
+public:
+  /**
+   * Store a transaction, unless already known.
+   *
+   * @param hash Hash of the transaction.
+   * @param trytes Trytes of the transaction.
+   *
+   * @return true if the transaction was added.
+   */
+  bool add(const Types::Trytes& hash, const Types::Trytes& trytes);
+
+  /**
+   * Store a transaction, unless already known.
+   *
+   * @param trx The transaction.
+   *
+   * @return true if the transaction was added.
+   */
+  bool add(const Models::CompactTransaction& trx);
+
+  /**
+   * @param hash Hash of a transaction.
+   *
+   * @return true if the transaction is in the store.
+   */
+  bool contains(const Types::Hash& hash) const;
+
+  /**
+   * @param hash Hash of a transaction.
+   * @param trytes Where to copy the trytes of the transaction, if found.
+   *
+   * @return true if the transaction is in the store.
+   */
+  bool getTrytes(const Types::Hash& hash, Types::Trytes& trytes) const;
+
+  /**
+   * Find the stored transactions matching the given values. As for the node, a transaction must
+   * match one of the values of each non empty field.
+   *
+   * @param addresses Addresses of the transactions.
+   * @param tags Tags of the transactions.
+   * @param approvees Transactions approved by the transactions.
+   * @param bundles Bundle hashes of the transactions.
+   *
+   * @return Hashes of the matching transactions, in the order they were stored.
+   */
+  std::vector<Types::Trytes> findTransactions(const std::vector<Models::Address>& addresses,
+                                              const std::vector<Models::Tag>&     tags,
+                                              const std::vector<Types::Trytes>&   approvees,
+                                              const std::vector<Types::Trytes>&   bundles) const;
+
+  /**
+   * @return Number of stored transactions.
+   */
+  std::size_t size() const;
+
+private:
+  using Index = std::unordered_map<Types::Hash, std::vector<uint32_t>>;
+
+  bool addRecord(const Models::CompactTransaction& trx);
+  void indexRecord(const Models::CompactTransaction& trx, uint32_t record);
+  Models::CompactTransaction readRecord(uint32_t record) const;
+
+  /**
+   * Add the records indexed under the given values to a sorted set of records.
+   */
+  static void collect(const Index& index, const std::vector<Types::Hash>& values,
+                      std::vector<uint32_t>& records);
+
+private:
+  mutable std::mutex mtx_;
+
+  std::string path_;
+
+  /**
+   * File backing the store, and records when kept in memory.
+   */
+  mutable std::fstream file_;
+  std::vector<uint8_t> records_;
+
+  /**
+   * Record of each hash, and hash of each record.
+   */
+  std::unordered_map<Types::Hash, uint32_t> hashes_;
+  std::vector<Types::Hash>                  recordHashes_;
+
+  Index addresses_;
+  Index bundles_;
+  Index tags_;
+  Index approvees_;
+};
+
+}  // namespace API
+
+}  // namespace IOTA
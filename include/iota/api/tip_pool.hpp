@@ -0,0 +1,203 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+
+#include <iota/api/core.hpp>
+#include <iota/types/trytes.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+/**
+ * Background prefetcher of trunk/branch pairs.
+ *
+ * Keeps a small pool of fresh pairs per depth, so that sends do not wait for
+ * getTransactionsToApprove. A background thread refills the pools on a timer, or as soon as a pair
+ * is taken. Pairs are evicted once older than the maximum age, or when a new milestone is seen.
+ *
+ * A depth is only prefetched once a pair was requested for it. Destruction waits for the request
+ * in flight, if any.
+ */
+class TipPool {
+public:
+  /**
+   * A trunk/branch pair.
+   */
+  struct Tips {
+    Types::Trytes             trunk;
+    Types::Trytes             branch;
+    std::chrono::milliseconds fetchedAt;
+  };
+
+  /**
+   * Default number of pairs kept per depth.
+   */
+  static constexpr std::size_t DefaultPoolSize = 4;
+
+  /**
+   * Default maximum age of a pair, in milliseconds.
+   */
+  static constexpr int64_t DefaultMaxAge = 20000;
+
+  /**
+   * Default delay between two refreshes, in milliseconds.
+   */
+  static constexpr int64_t DefaultRefreshInterval = 2000;
+
+public:
+  /**
+   * Full init ctor. Starts the background thread.
+   *
+   * @param api The api used to fetch the pairs. It is copied, so that the pool never refers to it.
+   * @param poolSize Number of pairs kept per depth.
+   * @param maxAge Maximum age of a pair, in milliseconds.
+   * @param refreshInterval Delay between two refreshes, in milliseconds.
+   */
+  TipPool(const Core& api, std::size_t poolSize = DefaultPoolSize, int64_t maxAge = DefaultMaxAge,
+          int64_t refreshInterval = DefaultRefreshInterval);
+  /**
+   * Dtor. Stops the background thread.
+   */
+  ~TipPool();
+
+  /**
+   * Non-copyable.
+   */
+  TipPool(const TipPool&) = delete;
+  TipPool& operator=(const TipPool&) = delete;
+
+public:
+  /**
+   * Take the freshest pair for a depth, and trigger a refill. The depth is prefetched from now on.
+   *
+   * @param depth The depth.
+   * @param tips Where to move the pair, if any.
+   *
+   * @return true if a fresh pair was available.
+   */
+  bool take(int depth, Tips& tips);
+
+  /**
+   * Start prefetching pairs for a depth, without taking any.
+   *
+   * @param depth The depth.
+   */
+  void watch(int depth);
+
+  /**
+   * @param depth The depth.
+   *
+   * @return Number of pairs available for the depth.
+   */
+  std::size_t size(int depth) const;
+
+  /**
+   * @return Number of requests served from the pool.
+   */
+  std::size_t getHits() const;
+
+  /**
+   * @return Number of requests that found the pool empty.
+   */
+  std::size_t getMisses() const;
+
+private:
+  /**
+   * Background thread loop.
+   */
+  void run();
+
+  /**
+   * Evict stale pairs and refill the pools.
+   */
+  void refresh();
+
+  /**
+   * Evict the pairs older than the maximum age. Must be called with the lock held.
+   */
+  void evict();
+
+private:
+  /**
+   * The api used to fetch the pairs.
+   */
+  Core api_;
+
+  /**
+   * Number of pairs kept per depth.
+   */
+  const std::size_t poolSize_;
+  /**
+   * Maximum age of a pair.
+   */
+  const std::chrono::milliseconds maxAge_;
+  /**
+   * Delay between two refreshes.
+   */
+  const std::chrono::milliseconds refreshInterval_;
+
+  /**
+   * Pairs per depth, oldest first.
+   */
+  std::map<int, std::deque<Tips>> pools_;
+  /**
+   * Latest milestone when the pools were last refreshed.
+   */
+  Types::Trytes milestone_;
+
+  std::size_t hits_;
+  std::size_t misses_;
+
+  /**
+   * Whether the background thread should refresh before the end of the interval, or stop.
+   */
+  bool wake_;
+  bool stop_;
+
+  /**
+   * Protects the whole state of the pool.
+   */
+  mutable std::mutex      mtx_;
+  std::condition_variable cv_;
+
+  /**
+   * Background thread, started last.
+   */
+  std::thread thread_;
+};
+
+}  // namespace API
+
+}  // namespace IOTA
@@ -50,6 +50,7 @@ constexpr unsigned int TritHashLength            = 243;
 constexpr unsigned int MaxTrxMsgLength           = 2187;
 constexpr unsigned int TxLength                  = 8019;
 constexpr unsigned int TrxTrytesLength           = 2673;
+constexpr unsigned int BundleEssenceLength       = 162;
 
 //! Default values
 const Types::Trytes EmptyHash(HashLength, '9');
@@ -63,6 +64,12 @@ constexpr int PowNumberOfRounds = 81;
 //! Misc
 constexpr int TrinaryBase                                 = 3;
 constexpr int GetBalancesRecommandedConfirmationThreshold = 100;
+constexpr int DefaultMaxAsyncRequests                     = 16;
+constexpr int DefaultRequestChunkSize                     = 1000;
+constexpr int DefaultMaxChunksInFlight                    = 4;
+constexpr int BundlesFetchBatchSize                       = 250;
+constexpr int DefaultMilestoneRefreshInterval             = 1000;
+constexpr int DefaultConfirmedTailsCapacity               = 100000;
 
 //! IRI API version
 const std::string APIVersion = "1.2.0";
@@ -0,0 +1,111 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include <iota/constants.hpp>
+#include <iota/types/trytes.hpp>
+
+namespace IOTA {
+
+namespace Crypto {
+
+/**
+ * Curl hashing of up to 64 messages of the same length at once.
+ *
+ * The state is bit-sliced as in Pow: each trit of the state is held by two 64-bit words, bit i of
+ * these words holding the trit of the i-th message (lane). A transformation thus costs the same for
+ * 64 messages as for one. Messages are absorbed as trytes, so that transaction trytes are hashed
+ * without being converted to trits first.
+ *
+ * Absorbing and squeezing behave as for Curl: the hash of a transaction is the first squeeze after
+ * absorbing its trytes.
+ */
+class BatchCurl {
+public:
+  /**
+   * Maximum number of messages hashed at once.
+   */
+  static constexpr std::size_t BatchSize = 64;
+
+public:
+  /**
+   * Default ctor.
+   */
+  BatchCurl();
+  /**
+   * Default dtor.
+   */
+  ~BatchCurl() = default;
+
+public:
+  /**
+   * Reset current state of the crypto algorithm.
+   */
+  void reset();
+
+  /**
+   * Absorb one message per lane into the current state.
+   *
+   * @param trytes Trytes of the messages, at most BatchSize. Must only hold valid trytes.
+   * @param length Number of trytes of each message, a multiple of HashLength.
+   */
+  void absorb(const std::vector<const char*>& trytes, std::size_t length);
+
+  /**
+   * Squeeze HashLength trytes for each lane.
+   *
+   * @param nbLanes Number of lanes to squeeze, at most BatchSize.
+   *
+   * @return The trytes squeezed for each lane.
+   */
+  std::vector<Types::Trytes> squeeze(std::size_t nbLanes);
+
+private:
+  /**
+   * Apply sponge fonction transformation algorithm to all the lanes.
+   */
+  void transform();
+
+private:
+  /**
+   * Constant: state length.
+   */
+  static constexpr std::size_t StateLength = 3 * TritHashLength;
+
+  /**
+   * Current state, low and high bits of each trit.
+   */
+  std::array<uint64_t, StateLength> stateLow_;
+  std::array<uint64_t, StateLength> stateHigh_;
+};
+
+}  // namespace Crypto
+
+}  // namespace IOTA
@@ -26,6 +26,7 @@
 #pragma once
 
 #include <iota/models/address.hpp>
+#include <iota/models/bundle.hpp>
 
 namespace IOTA {
 
@@ -90,6 +90,17 @@ std::vector<uint8_t> digest(const std::vector<int8_t>&  normalizedBundleFragment
 Types::Trits signatureFragment(const std::vector<int8_t>& normalizedBundleFragment,
                                const Types::Trits&        keyFragment);
 
+/**
+ * Sign the inputs of a finalized bundle in place: the transactions spending an input, and the
+ * following ones of the same address, get the signature fragments.
+ *
+ * @param seed The seed owning the inputs.
+ * @param inputs The inputs, with their key index and security.
+ * @param bundle The bundle.
+ */
+void signBundle(const Models::Seed& seed, const std::vector<Models::Address>& inputs,
+                Models::Bundle& bundle);
+
 std::vector<Types::Trytes> signInputs(const Models::Seed&                 seed,
                                       const std::vector<Models::Address>& inputs,
                                       Models::Bundle&                     bundle,
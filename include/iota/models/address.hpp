@@ -27,18 +27,25 @@
 
 #include <memory>
 
-#include <iota/crypto/kerl.hpp>
+#include <iota/types/hash.hpp>
 #include <iota/types/trinary.hpp>
+#include <iota/utils/deprecated.hpp>
+#include <iota/utils/lazy_value.hpp>
 
 namespace IOTA {
 
 namespace Models {
 
+class MultisigAddressBuilder;
+
 /**
  * Used to store addresses.
  * Provides validity checks at construction / value set.
  * Provides checksum generation.
  * Any addresses stored represented with this class are ensured to be valid.
+ *
+ * Addresses are stored inline and do not allocate, making them cheap to copy. Multisig addresses
+ * are built with MultisigAddressBuilder.
  */
 class Address {
 public:
@@ -83,11 +90,11 @@ public:
   /**
    * @return address as a trytes string, without the checksum
    */
-  const Types::Trytes& toTrytes() const;
+  Types::Trytes toTrytes() const;
 
   /**
    * This function returns the address as a trytes string, including a checksum.
-   * The returned checksum is generated the first time this function, or getChecksum, is called.
+   * Unless the address was built with a checksum, it is computed once and cached, see getChecksum.
    * If the object was built with an address containing a checksum, this checksum will be used even
    * though it may be invalid, unless validChecksum is set to true.
    *
@@ -95,7 +102,7 @@ public:
    * explanations above)
    * @return address as a trytes string including a checksum.
    */
-  Types::Trytes toTrytesWithChecksum(bool validChecksum = false);
+  Types::Trytes toTrytesWithChecksum(bool validChecksum = false) const;
 
   /**
    * Set the address value
@@ -106,8 +113,8 @@ public:
 
   /**
    * This function returns the address checksum.
-   * The returned checksum is generated the first time this function, or toTrytesWithChecksum, is
-   * called.
+   * Unless the address was built with a checksum, it is computed on the first call and cached,
+   * which is safe even when a const address is read concurrently.
    * If the object was built with an address containing a checksum, this checksum will be
    * used even though it may be invalid, unless validChecksum is set to true.
    *
@@ -115,15 +122,21 @@ public:
    * explanations above)
    * @return address checksum as trytes string.
    */
-  const Types::Trytes& getChecksum(bool validChecksum = false);
+  const Types::Trytes& getChecksum(bool validChecksum = false) const;
 
   /**
    * @return whether the address is empty or not.
    */
   bool empty() const;
 
+  /**
+   * @return Type of the address (normal/multisig).
+   */
+  const Type& getType() const;
+
   /**
    * Multisig address related methods.
+   * Deprecated, use MultisigAddressBuilder instead.
    */
 public:
   /**
@@ -132,12 +145,12 @@ public:
    *
    * @param digests The key digests in bytes.
    **/
-  void absorbDigests(const std::vector<uint8_t>& digests);
+  DEPRECATED void absorbDigests(const std::vector<uint8_t>& digests);
 
   /**
    * Finalizes and set the multisig address.
    **/
-  void finalize();
+  DEPRECATED void finalize();
 
   /**
    * Validates a generated multisig address.
@@ -146,7 +159,7 @@ public:
    *
    * @return whether the multisig address is valid or not.
    **/
-  bool validate(const std::vector<std::vector<uint8_t>>& digests);
+  DEPRECATED bool validate(const std::vector<std::vector<uint8_t>>& digests);
 
 public:
   /**
@@ -223,7 +236,7 @@ private:
   /**
    * address value without checksum
    */
-  Types::Trytes address_;
+  Types::Hash address_;
 
   /**
    * The balance.
@@ -246,15 +259,21 @@ private:
   Type type_;
 
   /**
-   * address checksum
+   * address checksum the address was built with, if any (fits in the small string buffer, no
+   * allocation)
    */
   Types::Trytes checksum_;
 
   /**
-   * Instance of Kerl for multisig addresses.
-   * Due to an alignement issue on MSVC15/32bits, kerl has been made a shared_ptr.
+   * valid checksum, computed on the first call to getChecksum that needs it
+   */
+  Utils::LazyValue<Types::Trytes> validChecksum_;
+
+  /**
+   * Builder for the deprecated multisig methods, only allocated when absorbDigests is called on a
+   * multisig address.
    */
-  std::shared_ptr<Crypto::Kerl> k_;
+  std::shared_ptr<MultisigAddressBuilder> multisig_;
 };
 
 std::ostream& operator<<(std::ostream& os, const Address& address);
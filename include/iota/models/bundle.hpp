@@ -25,11 +25,13 @@
 
 #pragma once
 
+#include <iosfwd>
 #include <memory>
 #include <vector>
 
 #include <iota/models/tag.hpp>
 #include <iota/models/transaction.hpp>
+#include <iota/types/hash.hpp>
 #include <iota/types/trytes.hpp>
 
 namespace IOTA {
@@ -73,14 +75,14 @@ public:
   /**
    * @return bundle hash
    */
-  const Types::Trytes& getHash() const;
+  const Types::Hash& getHash() const;
 
   /**
    * Set the hash of the bundle. This does NOT update the underlying transaction.
    *
    * @param hash  New hash for bundle
    */
-  void setHash(const Types::Trytes& hash);
+  void setHash(const Types::Hash& hash);
 
   /**
    * @return The length of the bundle.
@@ -102,6 +104,20 @@ public:
    */
   void addTransaction(const Transaction& transaction, int32_t signatureMessageLength = 1);
 
+  /**
+   * Adds a bundle entry, moving the transaction in.
+   * If multiple signature fragments are required, generates as many transactions as necessary
+   * @param transaction Transaction to be added to the bundle.
+   * @param signatureMessageLength Length of the signature message.
+   */
+  void addTransaction(Transaction&& transaction, int32_t signatureMessageLength = 1);
+
+  /**
+   * Reserve room for the given number of transactions.
+   * @param nbTransactions The number of transactions.
+   */
+  void reserve(std::size_t nbTransactions);
+
   /**
    * Finalizes the bundle.
    */
@@ -114,6 +130,16 @@ public:
    */
   void addTrytes(const std::vector<Types::Trytes>& signatureFragments);
 
+  /**
+   * Decode the message of an output: the signature message fragments of the transaction at the
+   * given index and of the following transactions of the same address without value. Fragments
+   * are decoded one at a time into the stream, trailing '9' padding of the last one is dropped.
+   *
+   * @param index The index of the output transaction.
+   * @param out The stream the decoded message is written to.
+   */
+  void readMessage(std::size_t index, std::ostream& out) const;
+
   /**
    * Normalized the bundle.
    *
@@ -176,7 +202,7 @@ private:
   /**
    * Hash corresponding to this bundle of transactions.
    */
-  Types::Trytes hash_;
+  Types::Hash hash_;
 };
 
 }  // namespace Models
@@ -0,0 +1,202 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <vector>
+
+#include <iota/models/address.hpp>
+#include <iota/models/bundle.hpp>
+#include <iota/models/tag.hpp>
+#include <iota/models/transfer.hpp>
+#include <iota/types/trytes.hpp>
+
+namespace IOTA {
+
+namespace Models {
+
+/**
+ * Builder of bundles with many outputs, such as payouts.
+ *
+ * Room for the transactions is reserved upfront and transfers are moved in. Messages are kept as
+ * given and never split into fragments: each transaction only records which slice of which message
+ * it carries, and the slices are copied straight into the trytes of the transactions by toTrytes.
+ * All the transactions share the timestamp taken when the builder is created.
+ *
+ * Typical use: add the transfers, then the inputs and the remainder, finalize, sign the inputs
+ * (see Crypto::Signing::signBundle) and get the trytes.
+ */
+class BundleBuilder {
+public:
+  /**
+   * Full init ctor.
+   *
+   * @param nbTransactions Number of transactions to reserve room for.
+   */
+  explicit BundleBuilder(std::size_t nbTransactions = 0);
+
+  /**
+   * Initializes a builder from an existing bundle.
+   *
+   * @param bundle The bundle.
+   * @param signatureFragments Signature message fragment of each transaction, set on the
+   * transactions as by Bundle::addTrytes.
+   */
+  BundleBuilder(const Bundle& bundle, const std::vector<Types::Trytes>& signatureFragments);
+
+  /**
+   * Default dtor.
+   */
+  ~BundleBuilder() = default;
+
+public:
+  /**
+   * Reserve room for the given number of transactions.
+   *
+   * @param nbTransactions The number of transactions.
+   */
+  void reserve(std::size_t nbTransactions);
+
+  /**
+   * Add an output, with as many transactions as needed to carry its message.
+   *
+   * @param transfer The transfer, its message is moved from.
+   */
+  void addTransfer(Transfer&& transfer);
+
+  /**
+   * Add an output, with as many transactions as needed to carry its message.
+   *
+   * @param transfer The transfer.
+   */
+  void addTransfer(const Transfer& transfer);
+
+  /**
+   * Add an output whose message is read from the given stream and encoded on the fly, 2 trytes
+   * per character (see Types::stringToTrytes), without holding the plain message in memory.
+   *
+   * @param address The address.
+   * @param value The value sent to the address.
+   * @param message The stream the message is read from, until its end.
+   * @param tag The tag of the transactions.
+   */
+  void addTransfer(const Address& address, int64_t value, std::istream& message, const Tag& tag);
+
+  /**
+   * Add an input spending the whole balance of the address, with one transaction per security
+   * level to hold its signature.
+   *
+   * @param input The input address, with its balance and security.
+   * @param tag The tag of the transactions.
+   */
+  void addInput(const Address& input, const Tag& tag);
+
+  /**
+   * Add an output without message, such as a remainder.
+   *
+   * @param address The address.
+   * @param value The value sent to the address.
+   * @param tag The tag of the transaction.
+   */
+  void addOutput(const Address& address, int64_t value, const Tag& tag);
+
+  /**
+   * Compute the bundle hash, see Bundle::finalize.
+   */
+  void finalize();
+
+  /**
+   * Set the message slices as signature message fragments of the transactions, padded with '9',
+   * and reset the trunk, branch and nonce, as Bundle::addTrytes does. For callers working on the
+   * transactions rather than on the trytes, to be called before signing.
+   */
+  void applyMessages();
+
+  /**
+   * Serialize the transactions in a single pass, message slices being copied straight from the
+   * messages. Should be called once the bundle is finalized and signed.
+   *
+   * @return The trytes of the transactions, by increasing index.
+   */
+  std::vector<Types::Trytes> toTrytes() const;
+
+  /**
+   * @return The sum of the values of the transfers and outputs.
+   */
+  int64_t getTotalValue() const;
+
+  /**
+   * @return The bundle.
+   */
+  const Bundle& getBundle() const;
+
+  /**
+   * Non-const getBundle, used to sign the inputs.
+   *
+   * @return The bundle.
+   */
+  Bundle& getBundle();
+
+private:
+  /**
+   * Add an output carrying the given message.
+   *
+   * @param address The address.
+   * @param value The value sent to the address.
+   * @param message The message, in trytes, moved from.
+   * @param tag The tag of the transactions.
+   */
+  void addMessage(const Address& address, int64_t value, Types::Trytes&& message, const Tag& tag);
+
+private:
+  /**
+   * Slice of a message carried by a transaction.
+   */
+  struct Slice {
+    /**
+     * Index of the message, NoMessage for transactions without message.
+     */
+    std::size_t message;
+    /**
+     * Offset of the slice in the message.
+     */
+    std::size_t offset;
+  };
+
+  static constexpr std::size_t NoMessage = static_cast<std::size_t>(-1);
+
+private:
+  Bundle                     bundle_;
+  std::vector<Types::Trytes> messages_;
+  std::vector<Slice>         slices_;
+  int64_t                    timestamp_;
+  int64_t                    totalValue_ = 0;
+};
+
+}  // namespace Models
+
+}  // namespace IOTA
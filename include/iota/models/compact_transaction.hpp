@@ -0,0 +1,335 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <iota/constants.hpp>
+#include <iota/models/address.hpp>
+#include <iota/models/fwd.hpp>
+#include <iota/models/tag.hpp>
+#include <iota/types/trinary.hpp>
+#include <iota/types/trytes.hpp>
+
+namespace IOTA {
+
+namespace Models {
+
+/**
+ * Compact, fixed-size, heap-free representation of a transaction.
+ *
+ * The 8019 trits of the transaction are packed 5 per byte (1604 bytes), the hash is packed the same
+ * way (49 bytes) and integer fields are decoded once and kept as native integers. The whole object
+ * is about 1.7KB, which makes it suitable to keep large amounts of transactions in memory.
+ *
+ * Conversion to and from trytes is lossless. serialize and deserialize provide a stable, versioned
+ * binary format for local storage and IPC.
+ */
+class CompactTransaction {
+public:
+  /**
+   * Number of bytes of the packed transaction trits.
+   */
+  static constexpr std::size_t PackedTrxLength = Types::packedTritsLength(TrxTrytesLength);
+  /**
+   * Number of bytes of the packed hash trits.
+   */
+  static constexpr std::size_t PackedHashLength = Types::packedTritsLength(HashLength);
+  /**
+   * Version of the binary format written by serialize.
+   */
+  static constexpr uint8_t SerializationVersion = 1;
+  /**
+   * Number of bytes written by serialize: version, packed hash and packed transaction.
+   */
+  static constexpr std::size_t SerializedLength = 1 + PackedHashLength + PackedTrxLength;
+
+public:
+  /**
+   * Initializes an empty transaction, all trytes being '9'.
+   */
+  CompactTransaction();
+
+  /**
+   * Initializes a new instance of the CompactTransaction class from transaction trytes. The hash is
+   * computed.
+   *
+   * @param trytes The transaction trytes.
+   */
+  explicit CompactTransaction(const Types::Trytes& trytes);
+
+  /**
+   * Initializes a new instance of the CompactTransaction class from a transaction view. The hash is
+   * taken from the view.
+   *
+   * @param view The transaction view.
+   */
+  explicit CompactTransaction(const TransactionView& view);
+
+  /**
+   * Initializes a new instance of the CompactTransaction class from a transaction. The hash is
+   * taken from the transaction if set, computed otherwise.
+   *
+   * @param transaction The transaction.
+   */
+  explicit CompactTransaction(const Transaction& transaction);
+
+  /**
+   * Default dtor.
+   */
+  ~CompactTransaction() = default;
+
+public:
+  /**
+   * @return The transaction trytes.
+   */
+  Types::Trytes toTrytes() const;
+
+  /**
+   * Writes the transaction trytes into the given buffer.
+   *
+   * @param trytes The output buffer, must hold at least TrxTrytesLength trytes.
+   */
+  void toTrytes(char* trytes) const;
+
+  /**
+   * @return The corresponding full transaction.
+   */
+  Transaction toTransaction() const;
+
+  /**
+   * Writes the binary representation of the transaction into the given buffer.
+   *
+   * @param bytes The output buffer, must hold at least SerializedLength bytes.
+   */
+  void serialize(uint8_t* bytes) const;
+
+  /**
+   * @return The binary representation of the transaction.
+   */
+  std::vector<uint8_t> serialize() const;
+
+  /**
+   * Reads a transaction from its binary representation, as written by serialize.
+   *
+   * @param bytes The binary representation.
+   * @param length Number of bytes available in bytes.
+   *
+   * @return The transaction.
+   */
+  static CompactTransaction deserialize(const uint8_t* bytes, std::size_t length);
+
+  /**
+   * @param bytes The binary representation.
+   *
+   * @return The transaction.
+   */
+  static CompactTransaction deserialize(const std::vector<uint8_t>& bytes);
+
+public:
+  /**
+   * @return Whether the validity chunk of the value field is empty, as checked by
+   * Transaction::initFromTrytes.
+   */
+  bool isValid() const;
+
+  /**
+   * @return Whether the transaction is a tail transaction or not (getCurrentIndex == 0).
+   */
+  bool isTailTransaction() const;
+
+  /**
+   * @return The hash.
+   */
+  Types::Trytes getHash() const;
+
+  /**
+   * @return The signature fragments.
+   */
+  Types::Trytes getSignatureFragments() const;
+
+  /**
+   * @return The address.
+   */
+  Models::Address getAddress() const;
+
+  /**
+   * @return The value.
+   */
+  int64_t getValue() const;
+
+  /**
+   * @return The obsolete tag.
+   */
+  Models::Tag getObsoleteTag() const;
+
+  /**
+   * @return The timestamp.
+   */
+  int64_t getTimestamp() const;
+
+  /**
+   * @return The current index.
+   */
+  int64_t getCurrentIndex() const;
+
+  /**
+   * @return The last index.
+   */
+  int64_t getLastIndex() const;
+
+  /**
+   * @return The bundle.
+   */
+  Types::Trytes getBundle() const;
+
+  /**
+   * @return The trunk transaction.
+   */
+  Types::Trytes getTrunkTransaction() const;
+
+  /**
+   * @return The branch transaction.
+   */
+  Types::Trytes getBranchTransaction() const;
+
+  /**
+   * @return The tag.
+   */
+  Models::Tag getTag() const;
+
+  /**
+   * @return The attachment timestamp.
+   */
+  int64_t getAttachmentTimestamp() const;
+
+  /**
+   * @return The attachment timestamp lower bound.
+   */
+  int64_t getAttachmentTimestampLowerBound() const;
+
+  /**
+   * @return The attachment timestamp upper bound.
+   */
+  int64_t getAttachmentTimestampUpperBound() const;
+
+  /**
+   * @return The nonce.
+   */
+  Types::Trytes getNonce() const;
+
+public:
+  /**
+   * Comparison operator.
+   *
+   * @param rhs other object to compare with.
+   *
+   * @return Whether the two transactions are equal or not.
+   */
+  bool operator==(const CompactTransaction& rhs) const;
+
+  /**
+   * Comparison operator.
+   *
+   * @param rhs other object to compare with.
+   *
+   * @return Whether the two transactions are equal or not.
+   */
+  bool operator!=(const CompactTransaction& rhs) const;
+
+private:
+  /**
+   * Packs the given trytes and hash and decodes the integer fields.
+   *
+   * @param trytes The transaction trytes.
+   * @param hash The transaction hash.
+   */
+  void init(const Types::Trytes& trytes, const Types::Trytes& hash);
+
+  /**
+   * Decodes the integer fields from the packed transaction.
+   */
+  void decodeIntegers();
+
+  /**
+   * @param offset Offset of the field in the transaction trytes.
+   *
+   * @return Unpacked trytes of the given field.
+   */
+  Types::Trytes field(const std::pair<int, int>& offset) const;
+
+  /**
+   * @param offset Offset of the field in the transaction trytes.
+   *
+   * @return Integer value of the given field.
+   */
+  int64_t intField(const std::pair<int, int>& offset) const;
+
+private:
+  /**
+   * Packed hash trits.
+   */
+  std::array<uint8_t, PackedHashLength> hash_;
+  /**
+   * Packed transaction trits.
+   */
+  std::array<uint8_t, PackedTrxLength> trx_;
+  /**
+   * Decoded value.
+   */
+  int64_t value_ = 0;
+  /**
+   * Decoded timestamp.
+   */
+  int64_t timestamp_ = 0;
+  /**
+   * Decoded current index.
+   */
+  int64_t currentIndex_ = 0;
+  /**
+   * Decoded last index.
+   */
+  int64_t lastIndex_ = 0;
+  /**
+   * Decoded attachment timestamp.
+   */
+  int64_t attachmentTimestamp_ = 0;
+  /**
+   * Decoded attachment timestamp lower bound.
+   */
+  int64_t attachmentTimestampLowerBound_ = 0;
+  /**
+   * Decoded attachment timestamp upper bound.
+   */
+  int64_t attachmentTimestampUpperBound_ = 0;
+};
+
+}  // namespace Models
+
+}  // namespace IOTA
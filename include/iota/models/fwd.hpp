@@ -30,9 +30,13 @@ namespace IOTA {
 namespace Models {
 
 class Bundle;
+class BundleBuilder;
+class CompactTransaction;
+class MultisigAddressBuilder;
 class Neighbor;
 class Signature;
 class Transaction;
+class TransactionView;
 class Transfer;
 class Tag;
 class Address;
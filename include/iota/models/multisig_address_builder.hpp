@@ -0,0 +1,100 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <vector>
+
+#include <iota/crypto/kerl.hpp>
+#include <iota/models/address.hpp>
+
+namespace IOTA {
+
+namespace Models {
+
+/**
+ * Builds a multisig address from the digests of its cosigners.
+ *
+ * Holds the Kerl sponge required to absorb the digests, so that plain Address instances do not
+ * have to carry one.
+ */
+class MultisigAddressBuilder {
+public:
+  /**
+   * Default ctor.
+   */
+  MultisigAddressBuilder() = default;
+
+  /**
+   * Default dtor.
+   */
+  ~MultisigAddressBuilder() = default;
+
+public:
+  /**
+   * Absorbs key digests. The security of the resulting address is increased by the number of
+   * digests absorbed.
+   *
+   * @param digests The digests bytes.
+   */
+  void absorbDigests(const std::vector<uint8_t>& digests);
+
+  /**
+   * Finalizes and returns the multisig address.
+   *
+   * @return The MULTISIG address.
+   */
+  Address finalize();
+
+  /**
+   * @return Security of the address being built (sum of the absorbed digests).
+   */
+  int32_t getSecurity() const;
+
+public:
+  /**
+   * Validates a generated multisig address.
+   *
+   * @param address The multisig address.
+   * @param digests The digests used to build the address.
+   *
+   * @return Whether the address is a MULTISIG address built from the given digests.
+   */
+  static bool validate(const Address& address, const std::vector<std::vector<uint8_t>>& digests);
+
+private:
+  /**
+   * Sponge absorbing the digests.
+   */
+  Crypto::Kerl k_;
+  /**
+   * Security of the address being built.
+   */
+  int32_t security_ = 0;
+};
+
+}  // namespace Models
+
+}  // namespace IOTA
@@ -29,6 +29,8 @@
 
 #include <iota/models/address.hpp>
 #include <iota/models/tag.hpp>
+#include <iota/models/transaction_view.hpp>
+#include <iota/types/hash.hpp>
 #include <iota/types/trytes.hpp>
 
 namespace IOTA {
@@ -57,6 +59,13 @@ public:
    */
   explicit Transaction(const Types::Trytes& trytes);
 
+  /**
+   * Initializes a new instance of the Transaction class by materializing all the fields of a view.
+   *
+   * @param view The transaction view.
+   */
+  explicit Transaction(const TransactionView& view);
+
   /**
    * Initializes a new instance of the Transaction class.
    *
@@ -77,9 +86,9 @@ public:
    * @param attachmentTimestampUpperBound Index of the transaction in the bundle.
    */
   Transaction(const Types::Trytes& signatureFragments, int64_t currentIndex, int64_t lastIndex,
-              const Types::Trytes& nonce, const Types::Trytes& hash, int64_t timestamp,
-              const Types::Trytes& trunkTransaction, const Types::Trytes& branchTransaction,
-              const Models::Address& address, int64_t value, const Types::Trytes& bundle,
+              const Types::Trytes& nonce, const Types::Hash& hash, int64_t timestamp,
+              const Types::Hash& trunkTransaction, const Types::Hash& branchTransaction,
+              const Models::Address& address, int64_t value, const Types::Hash& bundle,
               const Models::Tag& tag, int64_t attachmentTimestamp,
               int64_t attachmentTimestampLowerBound, int64_t attachmentTimestampUpperBound);
 
@@ -109,14 +118,14 @@ public:
    *
    * @return The hash.
    */
-  const Types::Trytes& getHash() const;
+  const Types::Hash& getHash() const;
 
   /**
    * Set the hash.
    *
    * @param hash The hash.
    */
-  void setHash(const Types::Trytes& hash);
+  void setHash(const Types::Hash& hash);
 
   /**
    * Get the signature fragments.
@@ -276,42 +285,42 @@ public:
    *
    * @return The bundle.
    */
-  const Types::Trytes& getBundle() const;
+  const Types::Hash& getBundle() const;
 
   /**
    * Set the bundle.
    *
    * @param bundle The bundle.
    */
-  void setBundle(const Types::Trytes& bundle);
+  void setBundle(const Types::Hash& bundle);
 
   /**
    * Get the trunk transaction.
    *
    * @return The trunk transaction.
    */
-  const Types::Trytes& getTrunkTransaction() const;
+  const Types::Hash& getTrunkTransaction() const;
 
   /**
    * Set the trunk transaction.
    *
    * @param trunkTransaction The trunk transaction.
    */
-  void setTrunkTransaction(const Types::Trytes& trunkTransaction);
+  void setTrunkTransaction(const Types::Hash& trunkTransaction);
 
   /**
    * Get the branch transaction.
    *
    * @return The branch transaction.
    */
-  const Types::Trytes& getBranchTransaction() const;
+  const Types::Hash& getBranchTransaction() const;
 
   /**
    * Set the branch transaction.
    *
    * @param branchTransaction The branch transaction.
    */
-  void setBranchTransaction(const Types::Trytes& branchTransaction);
+  void setBranchTransaction(const Types::Hash& branchTransaction);
 
   /**
    * Get the nonce.
@@ -366,6 +375,23 @@ public:
    */
   Types::Trytes toTrytes() const;
 
+  /**
+   * Writes the trytes representation of the transaction into the given buffer in a single pass.
+   * Fields shorter than their slot (for example an unset trunk) are right padded with '9'.
+   *
+   * @param trytes The output buffer, must hold at least TrxTrytesLength trytes.
+   */
+  void toTrytes(char* trytes) const;
+
+  /**
+   * Writes the bundle essence of the transaction (address, value, obsolete tag, timestamp, current
+   * index and last index) into the given buffer. This is the part absorbed when computing the
+   * bundle hash, equivalent to toTrytes().substr(2187, 162).
+   *
+   * @param trytes The output buffer, must hold at least BundleEssenceLength trytes.
+   */
+  void bundleEssenceToTrytes(char* trytes) const;
+
   /**
    * Initializes a new instance of the Transaction class based on tryte string.
    *
@@ -443,7 +469,7 @@ private:
   /**
    * Hash of the transaction.
    */
-  Types::Trytes hash_;
+  Types::Hash hash_;
   /**
    * Signature of the transaction.
    */
@@ -491,15 +517,15 @@ private:
   /**
    * Bundle hash.
    */
-  Types::Trytes bundle_;
+  Types::Hash bundle_;
   /**
    * Trunk transaction hash.
    */
-  Types::Trytes trunkTransaction_;
+  Types::Hash trunkTransaction_;
   /**
    * Branch transaction hash.
    */
-  Types::Trytes branchTransaction_;
+  Types::Hash branchTransaction_;
   /**
    * Nonce.
    */
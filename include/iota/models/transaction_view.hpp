@@ -0,0 +1,273 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <utility>
+
+#include <iota/models/address.hpp>
+#include <iota/models/tag.hpp>
+#include <iota/types/trytes.hpp>
+#include <iota/utils/lazy_value.hpp>
+
+namespace IOTA {
+
+namespace Models {
+
+/**
+ * Read-only view over the raw trytes of a transaction.
+ *
+ * Unlike Transaction, which splits the trytes into separate fields on construction, the view keeps
+ * the 2673 trytes as a single buffer and only decodes the requested field on access. The hash,
+ * which requires a full Curl pass, is computed on first access and cached.
+ *
+ * Use Transaction(const TransactionView&) when a full transaction object is required.
+ */
+class TransactionView {
+public:
+  /**
+   * Initializes a new instance of the TransactionView class by copying the given trytes.
+   *
+   * @param trytes The transaction trytes.
+   */
+  explicit TransactionView(const Types::Trytes& trytes);
+
+  /**
+   * Initializes a new instance of the TransactionView class by taking ownership of the given
+   * trytes.
+   *
+   * @param trytes The transaction trytes.
+   */
+  explicit TransactionView(Types::Trytes&& trytes);
+
+  /**
+   * Initializes a new instance of the TransactionView class by taking ownership of the given
+   * trytes, with an already known hash that will not be recomputed.
+   *
+   * @param trytes The transaction trytes.
+   * @param hash The transaction hash.
+   */
+  TransactionView(Types::Trytes&& trytes, const Types::Trytes& hash);
+
+  /**
+   * Default dtor.
+   */
+  ~TransactionView() = default;
+
+public:
+  /**
+   * @return The underlying transaction trytes.
+   */
+  const Types::Trytes& toTrytes() const;
+
+  /**
+   * @return Whether the validity chunk of the value field is empty, as checked by
+   * Transaction::initFromTrytes.
+   */
+  bool isValid() const;
+
+  /**
+   * @return Whether the transaction is a tail transaction or not (getCurrentIndex == 0).
+   */
+  bool isTailTransaction() const;
+
+  /**
+   * Get the hash. Computed on first call and cached for later calls, safely even when a const
+   * view is read concurrently.
+   *
+   * @return The hash.
+   */
+  const Types::Trytes& getHash() const;
+
+  /**
+   * @return The signature fragments.
+   */
+  Types::Trytes getSignatureFragments() const;
+
+  /**
+   * @return The address.
+   */
+  Models::Address getAddress() const;
+
+  /**
+   * @return The value.
+   */
+  int64_t getValue() const;
+
+  /**
+   * @return The obsolete tag.
+   */
+  Models::Tag getObsoleteTag() const;
+
+  /**
+   * @return The timestamp.
+   */
+  int64_t getTimestamp() const;
+
+  /**
+   * @return The current index.
+   */
+  int64_t getCurrentIndex() const;
+
+  /**
+   * @return The last index.
+   */
+  int64_t getLastIndex() const;
+
+  /**
+   * @return The bundle.
+   */
+  Types::Trytes getBundle() const;
+
+  /**
+   * @return The trunk transaction.
+   */
+  Types::Trytes getTrunkTransaction() const;
+
+  /**
+   * @return The branch transaction.
+   */
+  Types::Trytes getBranchTransaction() const;
+
+  /**
+   * @return The tag.
+   */
+  Models::Tag getTag() const;
+
+  /**
+   * @return The attachment timestamp.
+   */
+  int64_t getAttachmentTimestamp() const;
+
+  /**
+   * @return The attachment timestamp lower bound.
+   */
+  int64_t getAttachmentTimestampLowerBound() const;
+
+  /**
+   * @return The attachment timestamp upper bound.
+   */
+  int64_t getAttachmentTimestampUpperBound() const;
+
+  /**
+   * @return The nonce.
+   */
+  Types::Trytes getNonce() const;
+
+public:
+  /**
+   * Offset of signature fragments in the transaction trytes.
+   */
+  static const std::pair<int, int> SignatureFragmentsOffset;
+  /**
+   * Offset of address in the transaction trytes.
+   */
+  static const std::pair<int, int> AddressOffset;
+  /**
+   * Offset of the significant trytes of value in the transaction trytes.
+   */
+  static const std::pair<int, int> ValueOffset;
+  /**
+   * Offset of validity chunk in the transaction trytes.
+   */
+  static const std::pair<int, int> ValidityChunkOffset;
+  /**
+   * Offset of obsolete tag in the transaction trytes.
+   */
+  static const std::pair<int, int> ObsoleteTagOffset;
+  /**
+   * Offset of timestamp in the transaction trytes.
+   */
+  static const std::pair<int, int> TimestampOffset;
+  /**
+   * Offset of current index in the transaction trytes.
+   */
+  static const std::pair<int, int> CurrentIndexOffset;
+  /**
+   * Offset of last index in the transaction trytes.
+   */
+  static const std::pair<int, int> LastIndexOffset;
+  /**
+   * Offset of bundle in the transaction trytes.
+   */
+  static const std::pair<int, int> BundleOffset;
+  /**
+   * Offset of trunk in the transaction trytes.
+   */
+  static const std::pair<int, int> TrunkOffset;
+  /**
+   * Offset of branch in the transaction trytes.
+   */
+  static const std::pair<int, int> BranchOffset;
+  /**
+   * Offset of tag in the transaction trytes.
+   */
+  static const std::pair<int, int> TagOffset;
+  /**
+   * Offset of attachment timestamp in the transaction trytes.
+   */
+  static const std::pair<int, int> AttachmentTimestampOffset;
+  /**
+   * Offset of attachment timestamp lower bound in the transaction trytes.
+   */
+  static const std::pair<int, int> AttachmentTimestampLowerBoundOffset;
+  /**
+   * Offset of attachment timestamp upper bound in the transaction trytes.
+   */
+  static const std::pair<int, int> AttachmentTimestampUpperBoundOffset;
+  /**
+   * Offset of nonce in the transaction trytes.
+   */
+  static const std::pair<int, int> NonceOffset;
+
+private:
+  /**
+   * @param offset Offset of the field in the transaction trytes.
+   *
+   * @return Copy of the trytes of the given field.
+   */
+  Types::Trytes field(const std::pair<int, int>& offset) const;
+
+  /**
+   * @param offset Offset of the field in the transaction trytes.
+   *
+   * @return Integer value of the given field.
+   */
+  int64_t intField(const std::pair<int, int>& offset) const;
+
+private:
+  /**
+   * Raw transaction trytes.
+   */
+  Types::Trytes trytes_;
+  /**
+   * Cached hash, computed by the first call to getHash unless given to the ctor.
+   */
+  Utils::LazyValue<Types::Trytes> hash_;
+};
+
+}  // namespace Models
+
+}  // namespace IOTA
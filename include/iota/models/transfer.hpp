@@ -95,6 +95,13 @@ public:
    */
   const Types::Trytes& getMessage() const;
 
+  /**
+   * Non-const getMessage, allows callers to move the message out of the transfer.
+   *
+   * @return The message.
+   */
+  Types::Trytes& getMessage();
+
   /**
    * Set the message.
    *
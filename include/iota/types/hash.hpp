@@ -0,0 +1,230 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <functional>
+#include <ostream>
+
+#include <iota/constants.hpp>
+#include <iota/types/trytes.hpp>
+
+namespace IOTA {
+
+namespace Types {
+
+/**
+ * Fixed-size value type for 81-tryte hashes (transaction hashes, bundle hashes, trunk/branch
+ * references, tips...).
+ *
+ * Trytes are stored inline, so that copying a hash or putting it in a container never allocates,
+ * and comparison is a fixed-size memory comparison. Shorter values (including the empty hash) are
+ * supported to keep the semantics of the Types::Trytes fields it replaces.
+ *
+ * Hash is implicitly constructible from and convertible to Types::Trytes.
+ */
+class Hash {
+public:
+  /**
+   * Initializes an empty hash.
+   */
+  Hash();
+
+  /**
+   * Initializes a new instance of the Hash class.
+   *
+   * @param trytes The trytes of the hash, at most HashLength trytes.
+   */
+  Hash(const Types::Trytes& trytes);
+
+  /**
+   * Initializes a new instance of the Hash class.
+   *
+   * @param trytes The trytes of the hash, at most HashLength trytes.
+   */
+  Hash(const char* trytes);
+
+  /**
+   * Default dtor.
+   */
+  ~Hash() = default;
+
+public:
+  /**
+   * @return The trytes of the hash.
+   */
+  Types::Trytes toTrytes() const;
+
+  /**
+   * @return The trytes of the hash.
+   */
+  operator Types::Trytes() const;
+
+  /**
+   * @return Whether the hash is empty.
+   */
+  bool empty() const;
+
+  /**
+   * @return Number of trytes of the hash.
+   */
+  std::size_t size() const;
+
+  /**
+   * @return Pointer to the trytes of the hash (not null-terminated).
+   */
+  const char* data() const;
+
+  /**
+   * @return Iterator to the first tryte.
+   */
+  const char* begin() const;
+
+  /**
+   * @return Iterator past the last tryte.
+   */
+  const char* end() const;
+
+  /**
+   * @param index Index of the tryte.
+   *
+   * @return The tryte.
+   */
+  char operator[](std::size_t index) const;
+
+  /**
+   * Fast 64-bit hash of the value, computed from its first 13 trytes in base 27 (13 trytes carry
+   * 39 trits, which fits in 64 bits). Hashes are uniformly distributed, so this is enough for
+   * hash-based containers.
+   *
+   * @return The 64-bit hash.
+   */
+  uint64_t hashCode() const;
+
+public:
+  /**
+   * Comparison operator.
+   *
+   * @param rhs other object to compare with.
+   *
+   * @return Whether the two hashes are equal or not.
+   */
+  bool operator==(const Hash& rhs) const;
+
+  /**
+   * Comparison operator.
+   *
+   * @param rhs other object to compare with.
+   *
+   * @return Whether the two hashes are equal or not.
+   */
+  bool operator!=(const Hash& rhs) const;
+
+  /**
+   * Ordering operator, lexicographical on trytes, for ordered containers.
+   *
+   * @param rhs other object to compare with.
+   *
+   * @return Whether this hash is ordered before rhs.
+   */
+  bool operator<(const Hash& rhs) const;
+
+public:
+  /**
+   * Comparison operator, trytes-based for convenient use
+   *
+   * @param rhs other object to compare with.
+   *
+   * @return Whether the two hashes are equal or not.
+   */
+  bool operator==(const Types::Trytes& rhs) const;
+
+  /**
+   * Comparison operator, trytes-based for convenient use
+   *
+   * @param rhs other object to compare with.
+   *
+   * @return Whether the two hashes are equal or not.
+   */
+  bool operator!=(const Types::Trytes& rhs) const;
+
+  /**
+   * Comparison operator, trytes-based for convenient use
+   *
+   * @param rhs other object to compare with.
+   *
+   * @return Whether the two hashes are equal or not.
+   */
+  bool operator==(const char* rhs) const;
+
+  /**
+   * Comparison operator, trytes-based for convenient use
+   *
+   * @param rhs other object to compare with.
+   *
+   * @return Whether the two hashes are equal or not.
+   */
+  bool operator!=(const char* rhs) const;
+
+private:
+  /**
+   * Trytes of the hash, zero-filled after size_.
+   */
+  std::array<char, HashLength> trytes_;
+  /**
+   * Number of trytes of the hash.
+   */
+  uint8_t size_;
+};
+
+bool operator==(const Types::Trytes& lhs, const Hash& rhs);
+bool operator!=(const Types::Trytes& lhs, const Hash& rhs);
+
+/**
+ * outstream operator for hashes
+ *
+ * @param os the stream in which to write the hash.
+ * @param hash the hash to write in the stream.
+ *
+ * @return the stream.
+ */
+std::ostream& operator<<(std::ostream& os, const Hash& hash);
+
+}  // namespace Types
+
+}  // namespace IOTA
+
+namespace std {
+
+template <>
+struct hash<IOTA::Types::Hash> {
+  std::size_t operator()(const IOTA::Types::Hash& hash) const {
+    return static_cast<std::size_t>(hash.hashCode());
+  }
+};
+
+}  // namespace std
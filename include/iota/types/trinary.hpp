@@ -113,6 +113,16 @@ Trytes charToTrytes(const char c);
  */
 Trytes stringToTrytes(const std::string& str);
 
+/**
+ * Encode a buffer of ASCII characters to trytes, without allocation.
+ * 1 ASCII character = 2 trytes (see charToTrytes).
+ *
+ * @param str The characters to be encoded.
+ * @param length The number of characters.
+ * @param trytes Output buffer, receives 2 * length trytes.
+ */
+void stringToTrytes(const char* str, std::size_t length, char* trytes);
+
 /**
  * Decode trytes to ascii string.
  * Reverse operation from the stringToTrytes function.
@@ -124,6 +134,16 @@ Trytes stringToTrytes(const std::string& str);
  */
 std::string trytesToString(const Trytes& trytes);
 
+/**
+ * Decode a buffer of trytes to ASCII characters, without allocation.
+ * 2 trytes == 1 ASCII character (see charToTrytes).
+ *
+ * @param trytes The trytes to be decoded.
+ * @param length The number of trytes, must be even.
+ * @param str Output buffer, receives length / 2 characters.
+ */
+void trytesToString(const char* trytes, std::size_t length, char* str);
+
 std::vector<uint8_t> tritsToBytes(const Trits& trits, std::size_t offset = 0);
 Trits                bytesToTrits(const std::vector<uint8_t>& bytes, std::size_t offset = 0);
 
@@ -149,6 +169,75 @@ tritsToInt(const Trits& trits) {
   return res;
 }
 
+/**
+ * Decodes the integer stored in balanced ternary in trytes[offset, offset + length[, without
+ * converting the trytes to trits first. Least significant tryte comes first.
+ *
+ * @param trytes The trytes.
+ * @param offset Index of the first tryte to decode.
+ * @param length Number of trytes to decode.
+ *
+ * @return The decoded integer.
+ */
+int64_t trytesToInt(const Trytes& trytes, std::size_t offset, std::size_t length);
+
+/**
+ * Encodes value in balanced ternary into trytes[0, length[, least significant tryte first. This
+ * is equivalent to tritsToTrytes(intToTrits(value, length * 3)) but writes directly into the given
+ * buffer.
+ *
+ * @param value The integer to encode.
+ * @param trytes The output buffer, must hold at least length trytes.
+ * @param length Number of trytes to write.
+ */
+void intToTrytes(const int64_t& value, char* trytes, std::size_t length);
+
+/**
+ * Number of trits packed in each byte by trytesToPackedTrits (3^5 = 243 <= 256).
+ */
+constexpr std::size_t PackedTritsPerByte = 5;
+
+/**
+ * @param length Number of trytes.
+ *
+ * @return Number of bytes required to pack length trytes with trytesToPackedTrits.
+ */
+constexpr std::size_t
+packedTritsLength(std::size_t length) {
+  return (length * 3 + PackedTritsPerByte - 1) / PackedTritsPerByte;
+}
+
+/**
+ * Packs trytes[0, length[ into bytes, 5 trits per byte. This is lossless for any trit sequence,
+ * unlike trytesToBytes which is restricted to 243-trit hashes with a zero last trit.
+ * Trytes must be valid (see isValidTrytes).
+ *
+ * @param trytes The trytes to pack.
+ * @param length Number of trytes to pack.
+ * @param bytes The output buffer, must hold at least packedTritsLength(length) bytes.
+ */
+void trytesToPackedTrits(const char* trytes, std::size_t length, uint8_t* bytes);
+
+/**
+ * Packs length null trytes ('9') into bytes, as trytesToPackedTrits would, without building the
+ * trytes.
+ *
+ * @param length Number of trytes to pack.
+ * @param bytes The output buffer, must hold at least packedTritsLength(length) bytes.
+ */
+void nullTrytesToPackedTrits(std::size_t length, uint8_t* bytes);
+
+/**
+ * Unpacks the trytes [offset, offset + length[ from bytes packed by trytesToPackedTrits.
+ *
+ * @param bytes The packed trits.
+ * @param offset Index of the first tryte to unpack.
+ * @param length Number of trytes to unpack.
+ * @param trytes The output buffer, must hold at least length trytes.
+ */
+void packedTritsToTrytes(const uint8_t* bytes, std::size_t offset, std::size_t length,
+                         char* trytes);
+
 /**
  * Increments the specified trits.
  *
@@ -0,0 +1,174 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <utility>
+
+namespace IOTA {
+
+namespace Utils {
+
+/**
+ * Thread-safe, bounded FIFO queue connecting producer and consumer threads.
+ *
+ * push blocks while the queue is full and pop blocks while it is empty, which applies back-pressure
+ * between pipeline stages. Once closed, pushes are rejected and pops drain the remaining elements.
+ */
+template <typename T>
+class BlockingQueue {
+public:
+  /**
+   * Full init ctor.
+   *
+   * @param capacity Maximum number of queued elements, 0 for unbounded.
+   */
+  explicit BlockingQueue(std::size_t capacity = 0) : capacity_(capacity), closed_(false) {
+  }
+  /**
+   * Default dtor.
+   */
+  ~BlockingQueue() = default;
+
+  /**
+   * Non-copyable.
+   */
+  BlockingQueue(const BlockingQueue&) = delete;
+  BlockingQueue& operator=(const BlockingQueue&) = delete;
+
+public:
+  /**
+   * Append an element, waiting for room if the queue is full.
+   *
+   * @param value The element.
+   *
+   * @return false if the queue was closed, in which case the element is dropped.
+   */
+  bool
+  push(T value) {
+    std::unique_lock<std::mutex> lock(mtx_);
+    notFull_.wait(lock, [this] { return closed_ || capacity_ == 0 || queue_.size() < capacity_; });
+
+    if (closed_) {
+      return false;
+    }
+
+    queue_.push_back(std::move(value));
+    notEmpty_.notify_one();
+    return true;
+  }
+
+  /**
+   * Take the oldest element, waiting for one if the queue is empty.
+   *
+   * @param value Where to move the element.
+   *
+   * @return false if the queue is closed and empty.
+   */
+  bool
+  pop(T& value) {
+    std::unique_lock<std::mutex> lock(mtx_);
+    notEmpty_.wait(lock, [this] { return closed_ || !queue_.empty(); });
+
+    if (queue_.empty()) {
+      return false;
+    }
+
+    value = std::move(queue_.front());
+    queue_.pop_front();
+    notFull_.notify_one();
+    return true;
+  }
+
+  /**
+   * Reject further pushes and wake up all waiting threads. Queued elements can still be popped.
+   */
+  void
+  close() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    closed_ = true;
+    notEmpty_.notify_all();
+    notFull_.notify_all();
+  }
+
+  /**
+   * @return true if the queue was closed.
+   */
+  bool
+  isClosed() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return closed_;
+  }
+
+  /**
+   * @return The number of queued elements.
+   */
+  std::size_t
+  size() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return queue_.size();
+  }
+
+  /**
+   * @return The maximum number of queued elements, 0 for unbounded.
+   */
+  std::size_t
+  capacity() const {
+    return capacity_;
+  }
+
+private:
+  /**
+   * Queued elements, oldest first.
+   */
+  std::deque<T> queue_;
+  /**
+   * Maximum number of queued elements, 0 for unbounded.
+   */
+  const std::size_t capacity_;
+  /**
+   * Whether pushes are rejected.
+   */
+  bool closed_;
+  /**
+   * Protects the whole state of the queue.
+   */
+  mutable std::mutex mtx_;
+  /**
+   * Signaled when an element is pushed, or the queue closed.
+   */
+  std::condition_variable notEmpty_;
+  /**
+   * Signaled when an element is popped, or the queue closed.
+   */
+  std::condition_variable notFull_;
+};
+
+}  // namespace Utils
+
+}  // namespace IOTA
@@ -0,0 +1,174 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+namespace IOTA {
+
+namespace Utils {
+
+/**
+ * Value computed on first use, then cached.
+ *
+ * Reading it through a const object is thread-safe: threads racing on the first use may all
+ * compute the value, only one of them stores it, and the value is published with release/acquire
+ * ordering. Copies and moves carry the value once it is computed. Setting or resetting it is not
+ * thread-safe.
+ */
+template <typename T>
+class LazyValue {
+public:
+  LazyValue() : state_(Empty) {
+  }
+
+  LazyValue(const LazyValue& other) : state_(Empty) {
+    if (other.ready()) {
+      set(other.value_);
+    }
+  }
+
+  LazyValue(LazyValue&& other) : state_(Empty) {
+    if (other.ready()) {
+      set(std::move(other.value_));
+      other.reset();
+    }
+  }
+
+  LazyValue&
+  operator=(const LazyValue& other) {
+    if (this != &other) {
+      reset();
+      if (other.ready()) {
+        set(other.value_);
+      }
+    }
+    return *this;
+  }
+
+  LazyValue&
+  operator=(LazyValue&& other) {
+    if (this != &other) {
+      reset();
+      if (other.ready()) {
+        set(std::move(other.value_));
+        other.reset();
+      }
+    }
+    return *this;
+  }
+
+  /**
+   * Default dtor.
+   */
+  ~LazyValue() = default;
+
+public:
+  /**
+   * @param compute Computes the value, called only if it is not cached yet.
+   *
+   * @return The cached value.
+   */
+  template <typename F>
+  const T&
+  get(const F& compute) const {
+    if (!ready()) {
+      publish(compute());
+    }
+
+    return value_;
+  }
+
+  /**
+   * @return Whether the value is cached.
+   */
+  bool
+  ready() const {
+    return state_.load(std::memory_order_acquire) == Ready;
+  }
+
+  /**
+   * Cache a value known in advance.
+   *
+   * @param value The value.
+   */
+  void
+  set(T value) {
+    value_ = std::move(value);
+    state_.store(Ready, std::memory_order_release);
+  }
+
+  /**
+   * Drop the cached value.
+   */
+  void
+  reset() {
+    state_.store(Empty, std::memory_order_relaxed);
+    value_ = T{};
+  }
+
+private:
+  /**
+   * Store a computed value, unless another thread already does.
+   */
+  void
+  publish(T&& value) const {
+    uint8_t expected = Empty;
+
+    if (state_.compare_exchange_strong(expected, Publishing, std::memory_order_acquire)) {
+      value_ = std::move(value);
+      state_.store(Ready, std::memory_order_release);
+      return;
+    }
+
+    //! the other thread only has to move its value in
+    while (!ready()) {
+      std::this_thread::yield();
+    }
+  }
+
+private:
+  /**
+   * States of the value.
+   */
+  enum : uint8_t { Empty, Publishing, Ready };
+
+  /**
+   * The value, only read once ready.
+   */
+  mutable T value_;
+  /**
+   * State of the value.
+   */
+  mutable std::atomic<uint8_t> state_;
+};
+
+}  // namespace Utils
+
+}  // namespace IOTA
@@ -0,0 +1,193 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <list>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+namespace IOTA {
+
+namespace Utils {
+
+/**
+ * Thread-safe, size-bounded cache evicting the least recently used entry first.
+ *
+ * Values are copied in and out of the cache, which makes it suited to immutable objects such as
+ * transaction trytes. Lookups are counted as hits or misses.
+ */
+template <typename Key, typename Value, typename Hash = std::hash<Key>>
+class LRUCache {
+public:
+  /**
+   * Full init ctor.
+   *
+   * @param capacity Maximum number of entries.
+   */
+  explicit LRUCache(std::size_t capacity) : capacity_(capacity), hits_(0), misses_(0) {
+  }
+  /**
+   * Default dtor.
+   */
+  ~LRUCache() = default;
+
+  /**
+   * Non-copyable.
+   */
+  LRUCache(const LRUCache&) = delete;
+  LRUCache& operator=(const LRUCache&) = delete;
+
+public:
+  /**
+   * Look up an entry, marking it as the most recently used.
+   *
+   * @param key The key.
+   * @param value Where to copy the value, if found.
+   *
+   * @return true if the entry was found.
+   */
+  bool
+  get(const Key& key, Value& value) {
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      ++misses_;
+      return false;
+    }
+
+    ++hits_;
+    entries_.splice(entries_.begin(), entries_, it->second);
+    value = it->second->second;
+    return true;
+  }
+
+  /**
+   * Insert or replace an entry, evicting the least recently used one if the cache is full.
+   *
+   * @param key The key.
+   * @param value The value.
+   */
+  void
+  put(const Key& key, const Value& value) {
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    if (capacity_ == 0) {
+      return;
+    }
+
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      it->second->second = value;
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return;
+    }
+
+    if (entries_.size() >= capacity_) {
+      index_.erase(entries_.back().first);
+      entries_.pop_back();
+    }
+
+    entries_.emplace_front(key, value);
+    index_.emplace(key, entries_.begin());
+  }
+
+  /**
+   * Remove all the entries. Counters are kept.
+   */
+  void
+  clear() {
+    std::lock_guard<std::mutex> lock(mtx_);
+    entries_.clear();
+    index_.clear();
+  }
+
+  /**
+   * @return The number of entries.
+   */
+  std::size_t
+  size() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return entries_.size();
+  }
+
+  /**
+   * @return The maximum number of entries.
+   */
+  std::size_t
+  capacity() const {
+    return capacity_;
+  }
+
+  /**
+   * @return The number of successful lookups.
+   */
+  std::size_t
+  hits() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return hits_;
+  }
+
+  /**
+   * @return The number of failed lookups.
+   */
+  std::size_t
+  misses() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return misses_;
+  }
+
+private:
+  /**
+   * Entries, most recently used first.
+   */
+  std::list<std::pair<Key, Value>> entries_;
+  /**
+   * Position of each entry in the list.
+   */
+  std::unordered_map<Key, typename std::list<std::pair<Key, Value>>::iterator, Hash> index_;
+  /**
+   * Maximum number of entries.
+   */
+  const std::size_t capacity_;
+  /**
+   * Number of successful lookups.
+   */
+  std::size_t hits_;
+  /**
+   * Number of failed lookups.
+   */
+  std::size_t misses_;
+  /**
+   * Protects the whole state of the cache.
+   */
+  mutable std::mutex mtx_;
+};
+
+}  // namespace Utils
+
+}  // namespace IOTA
@@ -25,8 +25,10 @@
 
 #pragma once
 
+#include <algorithm>
 #include <atomic>
 #include <future>
+#include <thread>
 #include <vector>
 
 namespace IOTA {
@@ -36,8 +38,13 @@ namespace Utils {
 template <typename F>
 void
 parallel_for(std::size_t begin, std::size_t end, F fn) {
+  if (begin >= end)
+    return;
+
+  //! at least one worker, and no more workers than items
+  std::size_t                    workers = std::max(1u, std::thread::hardware_concurrency());
   std::atomic<std::size_t>       idx(begin);
-  int                            num_cpus = std::thread::hardware_concurrency();
+  int                            num_cpus = std::min(workers, end - begin);
   std::vector<std::future<void>> futures(num_cpus);
 
   for (int cpu = 0; cpu != num_cpus; ++cpu) {
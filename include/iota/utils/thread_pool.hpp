@@ -0,0 +1,162 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace IOTA {
+
+namespace Utils {
+
+/**
+ * Bounded pool of worker threads executing queued tasks.
+ *
+ * Workers are started lazily, only when a task is queued and no worker is idle, and never more than
+ * the configured maximum. Tasks queued beyond that limit wait for a worker to become available.
+ * The destructor runs all the queued tasks before joining the workers.
+ */
+class ThreadPool {
+public:
+  /**
+   * Full init ctor.
+   *
+   * @param maxThreads Maximum number of worker threads. At least one worker is always allowed.
+   */
+  explicit ThreadPool(std::size_t maxThreads = std::thread::hardware_concurrency());
+  /**
+   * Runs the remaining tasks and joins the workers.
+   */
+  ~ThreadPool();
+
+  /**
+   * Non-copyable.
+   */
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+public:
+  /**
+   * Queue a task for execution.
+   *
+   * @param fn The task, callable without arguments.
+   *
+   * @return A future holding the result of the task, or the exception it threw.
+   */
+  template <typename F>
+  std::future<typename std::result_of<F()>::type>
+  submit(F&& fn) {
+    using Result = typename std::result_of<F()>::type;
+
+    auto task   = std::make_shared<std::packaged_task<Result()>>(std::forward<F>(fn));
+    auto future = task->get_future();
+    post([task]() { (*task)(); });
+    return future;
+  }
+
+  /**
+   * Run all the queued tasks, including the ones they queue, and join the workers. Tasks submitted
+   * afterwards are run by a new worker, joined on destruction.
+   */
+  void join();
+
+  /**
+   * @return The maximum number of worker threads.
+   */
+  std::size_t getMaxThreads() const;
+
+  /**
+   * Change the maximum number of worker threads. Lowering it does not stop workers that are
+   * already running.
+   *
+   * @param maxThreads The maximum number of worker threads.
+   */
+  void setMaxThreads(std::size_t maxThreads);
+
+  /**
+   * @return The number of worker threads started so far.
+   */
+  std::size_t size() const;
+
+  /**
+   * @return The number of tasks waiting for a worker.
+   */
+  std::size_t pending() const;
+
+private:
+  /**
+   * Queue a task, starting a new worker if needed.
+   *
+   * @param task The task.
+   */
+  void post(std::function<void()>&& task);
+
+  /**
+   * Worker loop.
+   */
+  void work();
+
+private:
+  /**
+   * Worker threads.
+   */
+  std::vector<std::thread> threads_;
+  /**
+   * Queued tasks.
+   */
+  std::deque<std::function<void()>> tasks_;
+  /**
+   * Maximum number of worker threads.
+   */
+  std::size_t maxThreads_;
+  /**
+   * Number of workers waiting for a task.
+   */
+  std::size_t idle_;
+  /**
+   * Whether the pool is being destroyed.
+   */
+  bool stop_;
+  /**
+   * Protects the whole state of the pool.
+   */
+  mutable std::mutex mtx_;
+  /**
+   * Signals new tasks and destruction to the workers.
+   */
+  std::condition_variable cv_;
+};
+
+}  // namespace Utils
+
+}  // namespace IOTA
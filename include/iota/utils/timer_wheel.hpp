@@ -0,0 +1,158 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <chrono>
+#include <utility>
+#include <vector>
+
+namespace IOTA {
+
+namespace Utils {
+
+/**
+ * Hashed timer wheel: schedules many timers at the cost of one slot per tick.
+ *
+ * The wheel is made of a fixed number of slots, each covering one tick. A timer is stored in the
+ * slot it expires in, with the number of full turns left before it does. Advancing the wheel by one
+ * tick only looks at the next slot. Not thread-safe.
+ */
+template <typename T>
+class TimerWheel {
+public:
+  /**
+   * Full init ctor.
+   *
+   * @param slots Number of slots, at least 1.
+   * @param tick Duration covered by a slot.
+   */
+  TimerWheel(std::size_t slots, std::chrono::milliseconds tick)
+      : slots_(slots ? slots : 1), tick_(tick.count() > 0 ? tick : std::chrono::milliseconds(1)),
+        current_(0), size_(0) {
+  }
+  /**
+   * Default dtor.
+   */
+  ~TimerWheel() = default;
+
+public:
+  /**
+   * Schedule a timer. The delay is rounded up to a whole number of ticks, and is at least one tick.
+   *
+   * @param value The value returned when the timer expires.
+   * @param delay The delay before expiration.
+   */
+  void
+  schedule(T value, std::chrono::milliseconds delay) {
+    std::size_t ticks = 1;
+    if (delay > tick_) {
+      ticks = (delay.count() + tick_.count() - 1) / tick_.count();
+    }
+
+    auto& slot = slots_[(current_ + ticks) % slots_.size()];
+    slot.push_back({ std::move(value), (ticks - 1) / slots_.size() });
+    ++size_;
+  }
+
+  /**
+   * Move the wheel forward by one tick.
+   *
+   * @return The values of the timers expiring on this tick.
+   */
+  std::vector<T>
+  advance() {
+    current_ = (current_ + 1) % slots_.size();
+
+    std::vector<T> expired;
+    auto&          slot = slots_[current_];
+
+    //! timers with turns left stay in the slot
+    std::size_t kept = 0;
+    for (std::size_t i = 0; i < slot.size(); ++i) {
+      if (slot[i].rounds == 0) {
+        expired.push_back(std::move(slot[i].value));
+        continue;
+      }
+
+      --slot[i].rounds;
+      if (kept != i) {
+        slot[kept] = std::move(slot[i]);
+      }
+      ++kept;
+    }
+
+    slot.resize(kept);
+    size_ -= expired.size();
+
+    return expired;
+  }
+
+  /**
+   * @return Number of scheduled timers.
+   */
+  std::size_t
+  size() const {
+    return size_;
+  }
+
+  /**
+   * @return Duration covered by a slot.
+   */
+  std::chrono::milliseconds
+  tick() const {
+    return tick_;
+  }
+
+private:
+  /**
+   * A scheduled timer.
+   */
+  struct Entry {
+    T           value;
+    std::size_t rounds;
+  };
+
+  /**
+   * Timers, by expiration slot.
+   */
+  std::vector<std::vector<Entry>> slots_;
+  /**
+   * Duration covered by a slot.
+   */
+  std::chrono::milliseconds tick_;
+  /**
+   * Slot of the current tick.
+   */
+  std::size_t current_;
+  /**
+   * Number of scheduled timers.
+   */
+  std::size_t size_;
+};
+
+}  // namespace Utils
+
+}  // namespace IOTA
@@ -0,0 +1,331 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <algorithm>
+#include <iterator>
+
+#include <nlohmann/json.hpp>
+
+#include <iota/api/account_sync.hpp>
+#include <iota/api/responses/find_transactions.hpp>
+#include <iota/api/responses/get_balances.hpp>
+#include <iota/api/responses/get_inclusion_states.hpp>
+#include <iota/api/responses/get_new_addresses.hpp>
+#include <iota/api/responses/get_node_info.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <iota/utils/stop_watch.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+constexpr unsigned int AccountSync::MaxBundleAttempts;
+
+AccountSync::AccountSync(const Extended& api, const Models::Seed& seed, int threshold)
+    : api_(api), seed_(seed), threshold_(threshold) {
+}
+
+bool
+AccountSync::sync() {
+  const auto milestone        = api_.getNodeInfo().getLatestSolidSubtangleMilestone();
+  const bool newMilestone     = milestone != snapshot_.milestone;
+  const bool newAddresses     = syncAddresses();
+  const bool newTransactions  = syncTransactions();
+  bool       newConfirmations = false;
+
+  //! inclusion states and balances can only change with a new milestone or new transactions
+  if (newMilestone || newTransactions) {
+    newConfirmations = syncInclusionStates(milestone);
+  }
+
+  if (newMilestone || newAddresses || newTransactions) {
+    syncBalances();
+  }
+
+  snapshot_.milestone = milestone;
+
+  return newMilestone || newAddresses || newTransactions || newConfirmations;
+}
+
+bool
+AccountSync::syncAddresses() {
+  auto& addresses = snapshot_.addresses;
+  auto  known     = addresses.size();
+
+  //! the last known address was unused: search again from it
+  const uint32_t start = addresses.empty() ? 0 : addresses.size() - 1;
+  auto           found = api_.getNewAddresses(seed_, start, 0, true).getAddresses();
+
+  if (!addresses.empty()) {
+    found.front().setBalance(addresses.back().getBalance());
+    addresses.pop_back();
+  }
+
+  std::move(found.begin(), found.end(), std::back_inserter(addresses));
+
+  return addresses.size() != known;
+}
+
+bool
+AccountSync::syncTransactions() {
+  auto&                      rejected = snapshot_.rejected;
+  std::vector<Types::Trytes> newHashes;
+
+  for (const auto& hash : api_.findTransactionsByAddresses(snapshot_.addresses).getHashes()) {
+    auto attempts = rejected.find(hash);
+
+    if (!snapshot_.transactions.count(hash) &&
+        (attempts == rejected.end() || attempts->second < MaxBundleAttempts)) {
+      newHashes.push_back(hash);
+    }
+  }
+
+  if (newHashes.empty()) {
+    return false;
+  }
+
+  //! only the transactions of valid bundles are marked as seen: the others are fetched again on
+  //! the next syncs, in case the node did not have the whole bundle yet, until they are rejected
+  bool newBundles = false;
+
+  for (auto& bundle : api_.bundlesFromTransactions(newHashes)) {
+    for (const auto& trx : bundle.getTransactions()) {
+      snapshot_.transactions.insert(trx.getHash());
+    }
+
+    const auto tail = bundle.getTransactions().front().getHash();
+    newBundles      = snapshot_.bundles.emplace(tail, std::move(bundle)).second || newBundles;
+  }
+
+  for (const auto& hash : newHashes) {
+    if (snapshot_.transactions.count(hash)) {
+      rejected.erase(hash);
+    } else {
+      ++rejected[hash];
+    }
+  }
+
+  return newBundles;
+}
+
+bool
+AccountSync::syncInclusionStates(const Types::Trytes& milestone) {
+  std::unordered_set<Types::Hash> confirmedBundles;
+  std::vector<Types::Trytes>      tails;
+
+  for (const auto& tail : snapshot_.confirmedTails) {
+    auto bundle = snapshot_.bundles.find(tail);
+    if (bundle != snapshot_.bundles.end()) {
+      confirmedBundles.insert(bundle->second.getHash());
+    }
+  }
+
+  //! once a bundle is confirmed, its reattachments can never be
+  for (const auto& entry : snapshot_.bundles) {
+    if (!confirmedBundles.count(entry.second.getHash())) {
+      tails.push_back(entry.first);
+    }
+  }
+
+  if (tails.empty()) {
+    return false;
+  }
+
+  const auto states    = api_.getInclusionStates(tails, { milestone }).getStates();
+  bool       confirmed = false;
+
+  for (std::size_t i = 0; i < tails.size() && i < states.size(); ++i) {
+    if (!states[i]) {
+      continue;
+    }
+
+    snapshot_.confirmedTails.insert(tails[i]);
+    for (auto& trx : snapshot_.bundles[tails[i]].getTransactions()) {
+      trx.setPersistence(true);
+    }
+
+    confirmed = true;
+  }
+
+  return confirmed;
+}
+
+void
+AccountSync::syncBalances() {
+  auto&      addresses = snapshot_.addresses;
+  const auto balances  = api_.getBalances(addresses, threshold_).getBalances();
+
+  for (std::size_t i = 0; i < addresses.size() && i < balances.size(); ++i) {
+    addresses[i].setBalance(std::stoll(balances[i]));
+  }
+}
+
+const AccountSync::Snapshot&
+AccountSync::getSnapshot() const {
+  return snapshot_;
+}
+
+int64_t
+AccountSync::getBalance() const {
+  int64_t balance = 0;
+
+  for (const auto& address : snapshot_.addresses) {
+    balance += address.getBalance();
+  }
+
+  return balance;
+}
+
+Responses::GetAccountData
+AccountSync::getAccountData() const {
+  const Utils::StopWatch stopWatch;
+
+  std::vector<Models::Bundle> transfers;
+  transfers.reserve(snapshot_.bundles.size());
+
+  for (const auto& entry : snapshot_.bundles) {
+    transfers.push_back(entry.second);
+  }
+
+  std::sort(transfers.begin(), transfers.end());
+
+  return { snapshot_.addresses, transfers, getBalance(), stopWatch.getElapsedTime().count() };
+}
+
+void
+AccountSync::save(std::ostream& os) const {
+  json snapshot;
+
+  snapshot["addresses"]      = json::array();
+  snapshot["transactions"]   = json::array();
+  snapshot["rejected"]       = json::array();
+  snapshot["bundles"]        = json::array();
+  snapshot["confirmedTails"] = json::array();
+  snapshot["milestone"]      = snapshot_.milestone;
+
+  for (const auto& address : snapshot_.addresses) {
+    snapshot["addresses"].push_back({ { "address", address.toTrytes() },
+                                      { "balance", address.getBalance() },
+                                      { "keyIndex", address.getKeyIndex() },
+                                      { "security", address.getSecurity() } });
+  }
+
+  for (const auto& hash : snapshot_.transactions) {
+    snapshot["transactions"].push_back(static_cast<Types::Trytes>(hash));
+  }
+
+  for (const auto& entry : snapshot_.rejected) {
+    snapshot["rejected"].push_back(
+        { { "hash", static_cast<Types::Trytes>(entry.first) }, { "attempts", entry.second } });
+  }
+
+  for (const auto& entry : snapshot_.bundles) {
+    json trytes = json::array();
+    for (const auto& trx : entry.second.getTransactions()) {
+      trytes.push_back(trx.toTrytes());
+    }
+    snapshot["bundles"].push_back(trytes);
+  }
+
+  for (const auto& hash : snapshot_.confirmedTails) {
+    snapshot["confirmedTails"].push_back(static_cast<Types::Trytes>(hash));
+  }
+
+  os << snapshot;
+}
+
+void
+AccountSync::load(std::istream& is) {
+  Snapshot snapshot;
+
+  try {
+    json res;
+    is >> res;
+
+    for (const auto& address : res.at("addresses")) {
+      snapshot.addresses.emplace_back(address.at("address").get<Types::Trytes>(),
+                                      address.at("balance").get<int64_t>(),
+                                      address.at("keyIndex").get<int32_t>(),
+                                      address.at("security").get<int32_t>());
+    }
+
+    for (const auto& hash : res.at("transactions")) {
+      snapshot.transactions.insert(hash.get<Types::Trytes>());
+    }
+
+    for (const auto& entry : res.at("rejected")) {
+      snapshot.rejected.emplace(entry.at("hash").get<Types::Trytes>(),
+                                entry.at("attempts").get<unsigned int>());
+    }
+
+    for (const auto& hash : res.at("confirmedTails")) {
+      snapshot.confirmedTails.insert(hash.get<Types::Trytes>());
+    }
+
+    for (const auto& bundleTrytes : res.at("bundles")) {
+      Models::Bundle bundle;
+
+      for (const auto& trytes : bundleTrytes) {
+        bundle.addTransaction(Models::Transaction{ trytes.get<Types::Trytes>() });
+      }
+
+      if (bundle.getTransactions().empty()) {
+        throw Errors::IllegalState("Invalid snapshot: empty bundle");
+      }
+
+      const auto tail = bundle.getTransactions().front().getHash();
+      bundle.setHash(bundle.getTransactions().front().getBundle());
+
+      if (snapshot.confirmedTails.count(tail)) {
+        for (auto& trx : bundle.getTransactions()) {
+          trx.setPersistence(true);
+        }
+      }
+
+      snapshot.bundles.emplace(tail, std::move(bundle));
+    }
+
+    snapshot.milestone = res.at("milestone").get<Types::Trytes>();
+  } catch (const Errors::IllegalState&) {
+    throw;
+  } catch (const std::exception& e) {
+    throw Errors::IllegalState(std::string("Invalid snapshot: ") + e.what());
+  }
+
+  //! a snapshot only applies to the seed it was built from: checking the first address is enough
+  if (!snapshot.addresses.empty()) {
+    const auto& address = snapshot.addresses.front();
+
+    if (address != seed_.newAddress(address.getKeyIndex(), address.getSecurity())) {
+      throw Errors::IllegalState("Snapshot does not belong to this seed");
+    }
+  }
+
+  snapshot_ = std::move(snapshot);
+}
+
+}  // namespace API
+
+}  // namespace IOTA
@@ -0,0 +1,189 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+
+#include <iota/api/balance_poller.hpp>
+#include <iota/api/responses/get_balances.hpp>
+#include <iota/errors/illegal_state.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+BalancePoller::BalancePoller(const Core& api, int threshold)
+    : api_(api),
+      threshold_(threshold),
+      shardSize_(api.getChunkSize("getBalances")),
+      maxShardsInFlight_(api.getMaxChunksInFlight()) {
+}
+
+std::size_t
+BalancePoller::add(const Models::Address& address) {
+  const auto trytes = address.toTrytes();
+
+  if (trytes.size() != AddressLength) {
+    throw Errors::IllegalState("Invalid address");
+  }
+
+  addresses_.append(trytes);
+  balances_.push_back(0);
+
+  return balances_.size() - 1;
+}
+
+void
+BalancePoller::add(const std::vector<Models::Address>& addresses) {
+  addresses_.reserve(addresses_.size() + addresses.size() * AddressLength);
+  balances_.reserve(balances_.size() + addresses.size());
+
+  for (const auto& address : addresses) {
+    add(address);
+  }
+}
+
+std::vector<BalancePoller::Change>
+BalancePoller::poll() {
+  //! a shard size of 0 puts all the addresses in one shard
+  const auto shardSize = shardSize_ ? shardSize_ : std::max<std::size_t>(balances_.size(), 1);
+  const auto nbShards  = (balances_.size() + shardSize - 1) / shardSize;
+  const auto nbWorkers = std::min(std::max<std::size_t>(maxShardsInFlight_, 1), nbShards);
+
+  std::vector<int64_t>     balances(balances_.size(), 0);
+  std::atomic<std::size_t> next(0);
+
+  //! each worker takes the next shard until none is left
+  std::vector<std::future<void>> workers;
+  for (std::size_t i = 0; i < nbWorkers; ++i) {
+    workers.push_back(
+        std::async(std::launch::async, [this, &next, nbShards, shardSize, &balances]() {
+          for (std::size_t shard = next++; shard < nbShards; shard = next++) {
+            pollShard(shard, shardSize, balances);
+          }
+        }));
+  }
+
+  //! wait for all the workers before rethrowing the first error
+  for (auto& worker : workers) {
+    worker.wait();
+  }
+  for (auto& worker : workers) {
+    worker.get();
+  }
+
+  std::vector<Change> changes;
+  for (std::size_t i = 0; i < balances.size(); ++i) {
+    if (balances[i] != balances_[i]) {
+      changes.push_back({ i, balances_[i], balances[i] });
+    }
+  }
+
+  balances_.swap(balances);
+
+  return changes;
+}
+
+void
+BalancePoller::pollShard(std::size_t shard, std::size_t shardSize,
+                         std::vector<int64_t>& balances) const {
+  const auto first = shard * shardSize;
+  const auto last  = std::min(first + shardSize, balances.size());
+
+  std::vector<Models::Address> addresses;
+  addresses.reserve(last - first);
+  for (std::size_t i = first; i < last; ++i) {
+    addresses.emplace_back(getAddress(i));
+  }
+
+  //! balances are decoded in order, straight into their slot
+  std::size_t next = first;
+  api_.getBalances(addresses, threshold_, {}, [&balances, &next, last](int64_t balance) {
+    if (next < last) {
+      balances[next] = balance;
+    }
+    ++next;
+  });
+
+  if (next != last) {
+    throw Errors::IllegalState("Unexpected number of balances");
+  }
+}
+
+std::size_t
+BalancePoller::size() const {
+  return balances_.size();
+}
+
+Types::Trytes
+BalancePoller::getAddress(std::size_t index) const {
+  return addresses_.substr(index * AddressLength, AddressLength);
+}
+
+int64_t
+BalancePoller::getBalance(std::size_t index) const {
+  return balances_[index];
+}
+
+const std::vector<int64_t>&
+BalancePoller::getBalances() const {
+  return balances_;
+}
+
+int64_t
+BalancePoller::getTotalBalance() const {
+  int64_t total = 0;
+
+  for (const auto& balance : balances_) {
+    total += balance;
+  }
+
+  return total;
+}
+
+void
+BalancePoller::setShardSize(std::size_t size) {
+  shardSize_ = size;
+}
+
+std::size_t
+BalancePoller::getShardSize() const {
+  return shardSize_;
+}
+
+void
+BalancePoller::setMaxShardsInFlight(std::size_t maxShards) {
+  maxShardsInFlight_ = std::max<std::size_t>(maxShards, 1);
+}
+
+std::size_t
+BalancePoller::getMaxShardsInFlight() const {
+  return maxShardsInFlight_;
+}
+
+}  // namespace API
+
+}  // namespace IOTA
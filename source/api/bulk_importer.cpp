@@ -0,0 +1,201 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include <iota/api/bulk_importer.hpp>
+#include <iota/constants.hpp>
+#include <iota/crypto/batch_curl.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <iota/models/transaction_view.hpp>
+#include <iota/utils/parallel_for.hpp>
+#include <iota/utils/stop_watch.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+constexpr std::size_t BulkImporter::DefaultBlockSize;
+
+static bool
+isValidLine(const std::pair<const char*, std::size_t>& line) {
+  return line.second == TrxTrytesLength &&
+         std::all_of(line.first, line.first + line.second,
+                     [](char c) { return c == '9' || (c >= 'A' && c <= 'Z'); });
+}
+
+BulkImporter::BulkImporter(std::size_t blockSize)
+    : blockSize_(std::max<std::size_t>(blockSize, 1)) {
+}
+
+BulkImporter::Stats
+BulkImporter::import(std::istream& is, const Consumer& consumer) const {
+  const Utils::StopWatch stopWatch;
+  Stats                  stats{ 0, 0, 0 };
+
+  //! room for a block of lines, with their line endings
+  const std::size_t readSize = blockSize_ * (TrxTrytesLength + 2);
+  std::vector<char> buffer;
+  std::size_t       carry = 0;
+  bool              eof   = false;
+
+  while (!eof) {
+    buffer.resize(carry + readSize);
+    is.read(buffer.data() + carry, static_cast<std::streamsize>(readSize));
+
+    const auto size = carry + static_cast<std::size_t>(is.gcount());
+    eof             = !is;
+
+    //! the last line may continue in the next read
+    std::size_t end = size;
+    if (!eof) {
+      auto last = std::find(buffer.rbegin() + (buffer.size() - size), buffer.rend(), '\n');
+      if (last != buffer.rend()) {
+        end = static_cast<std::size_t>(buffer.rend() - last);
+      }
+    }
+
+    std::vector<std::pair<const char*, std::size_t>> lines;
+    for (std::size_t begin = 0; begin < end;) {
+      auto newline = std::find(buffer.data() + begin, buffer.data() + end, '\n');
+      auto length  = static_cast<std::size_t>(newline - buffer.data()) - begin;
+      auto next    = begin + length + 1;
+
+      if (length > 0 && buffer[begin + length - 1] == '\r') {
+        --length;
+      }
+      if (length > 0) {
+        lines.emplace_back(buffer.data() + begin, length);
+      }
+
+      begin = next;
+    }
+
+    importBlock(lines, consumer, stats);
+
+    carry = size - end;
+    std::memmove(buffer.data(), buffer.data() + end, carry);
+  }
+
+  stats.duration = stopWatch.getElapsedTime().count();
+  return stats;
+}
+
+BulkImporter::Stats
+BulkImporter::importFile(const std::string& path, const Consumer& consumer) const {
+  std::ifstream file(path, std::ios::binary);
+  if (!file) {
+    throw Errors::IllegalState("Could not open dump");
+  }
+
+  return import(file, consumer);
+}
+
+void
+BulkImporter::importBlock(const std::vector<std::pair<const char*, std::size_t>>& lines,
+                          const Consumer& consumer, Stats& stats) const {
+  const auto nbBatches = (lines.size() + Crypto::BatchCurl::BatchSize - 1) /
+                         Crypto::BatchCurl::BatchSize;
+
+  std::vector<Models::CompactTransaction> trxs(lines.size());
+  std::vector<char>                       valid(lines.size(), 0);
+
+  Utils::parallel_for(std::size_t{ 0 }, nbBatches, [&](std::size_t batch) {
+    const auto first = batch * Crypto::BatchCurl::BatchSize;
+    const auto last  = std::min(first + Crypto::BatchCurl::BatchSize, lines.size());
+
+    std::vector<const char*> trytes;
+    std::vector<std::size_t> indexes;
+    for (std::size_t i = first; i < last; ++i) {
+      if (isValidLine(lines[i])) {
+        trytes.push_back(lines[i].first);
+        indexes.push_back(i);
+      }
+    }
+
+    if (trytes.empty()) {
+      return;
+    }
+
+    Crypto::BatchCurl curl;
+    curl.absorb(trytes, TrxTrytesLength);
+    const auto hashes = curl.squeeze(trytes.size());
+
+    for (std::size_t k = 0; k < trytes.size(); ++k) {
+      const Models::TransactionView view{ Types::Trytes(trytes[k], TrxTrytesLength), hashes[k] };
+
+      trxs[indexes[k]]  = Models::CompactTransaction{ view };
+      valid[indexes[k]] = 1;
+    }
+  });
+
+  //! keep the valid transactions, in the order of the dump
+  std::size_t kept = 0;
+  for (std::size_t i = 0; i < trxs.size(); ++i) {
+    if (valid[i]) {
+      if (kept != i) {
+        trxs[kept] = trxs[i];
+      }
+      ++kept;
+    }
+  }
+  trxs.resize(kept);
+
+  stats.transactions += kept;
+  stats.invalid += lines.size() - kept;
+
+  if (!trxs.empty()) {
+    consumer(std::move(trxs));
+  }
+}
+
+BulkImporter::Consumer
+BulkImporter::storeInto(TangleStore& store) {
+  return [&store](std::vector<Models::CompactTransaction>&& trxs) {
+    for (const auto& trx : trxs) {
+      store.add(trx);
+    }
+  };
+}
+
+BulkImporter::Consumer
+BulkImporter::indexBundlesInto(BundleIndex& index) {
+  return [&index](std::vector<Models::CompactTransaction>&& trxs) {
+    for (const auto& trx : trxs) {
+      index[trx.getBundle()].push_back(trx.getHash());
+    }
+  };
+}
+
+std::size_t
+BulkImporter::getBlockSize() const {
+  return blockSize_;
+}
+
+}  // namespace API
+
+}  // namespace IOTA
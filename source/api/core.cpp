@@ -23,7 +23,12 @@
 //
 //
 
+#include <algorithm>
+#include <atomic>
+#include <unordered_set>
+
 #include <iota/api/core.hpp>
+#include <iota/api/json_stream_reader.hpp>
 #include <iota/api/requests/add_neighbors.hpp>
 #include <iota/api/requests/attach_to_tangle.hpp>
 #include <iota/api/requests/broadcast_transactions.hpp>
@@ -53,6 +58,7 @@
 #include <iota/api/responses/get_trytes.hpp>
 #include <iota/api/responses/remove_neighbors.hpp>
 #include <iota/api/responses/were_addresses_spent_from.hpp>
+#include <iota/constants.hpp>
 #include <iota/crypto/pow.hpp>
 #include <iota/errors/illegal_state.hpp>
 #include <iota/models/neighbor.hpp>
@@ -63,8 +69,85 @@ namespace IOTA {
 
 namespace API {
 
+//! commands split into chunks, see Core::setChunkSize
+static const std::vector<std::string> ChunkedCommands = { "findTransactions", "getTrytes",
+                                                          "getInclusionStates", "getBalances",
+                                                          "wereAddressesSpentFrom" };
+
+static std::size_t
+nbChunks(std::size_t size, std::size_t chunkSize) {
+  return chunkSize == 0 ? 1 : std::max<std::size_t>(1, (size + chunkSize - 1) / chunkSize);
+}
+
+template <typename T>
+static std::vector<T>
+chunkOf(const std::vector<T>& input, std::size_t chunkSize, std::size_t idx) {
+  auto begin = input.begin() + idx * chunkSize;
+  auto end   = input.begin() + std::min(input.size(), (idx + 1) * chunkSize);
+  return { begin, end };
+}
+
+//! append the values of all chunks to the first one, in chunk order
+template <typename Response, typename Values>
+static Response
+mergeChunks(std::vector<Response>& chunks, Values values) {
+  auto& res    = chunks.front();
+  auto& merged = values(res);
+
+  for (std::size_t i = 1; i < chunks.size(); ++i) {
+    auto& chunkValues = values(chunks[i]);
+    merged.insert(merged.end(), chunkValues.begin(), chunkValues.end());
+    res.setDuration(res.getDuration() + chunks[i].getDuration());
+  }
+
+  return std::move(res);
+}
+
+//! handler passing the values of one field to a consumer, and accumulating the duration
+static JsonStreamReader::Handler
+fieldHandler(const std::string& name, const Core::TrytesConsumer& consumer, int64_t& duration) {
+  return [name, &consumer, &duration](const std::string& field, std::string&& value) {
+    if (field == name) {
+      consumer(std::move(value));
+    } else if (field == "duration") {
+      duration += std::stoll(value);
+    }
+  };
+}
+
 Core::Core(const std::string& host, const uint16_t& port, bool localPow, int timeout, const std::string& user, const std::string& pass)
-    : service_(host, port, timeout, user, pass), localPow_(localPow) {
+    : service_(host, port, timeout, user, pass),
+      localPow_(localPow),
+      maxChunksInFlight_(DefaultMaxChunksInFlight),
+      executor_(new Utils::ThreadPool(DefaultMaxAsyncRequests)) {
+  for (const auto& command : ChunkedCommands) {
+    chunkSizes_[command] = DefaultRequestChunkSize;
+  }
+}
+
+Core::Core(const Core& other)
+    : service_(other.service_),
+      localPow_(other.localPow_),
+      chunkSizes_(other.chunkSizes_),
+      maxChunksInFlight_(other.maxChunksInFlight_),
+      trytesCache_(other.trytesCache_),
+      tangleStore_(other.tangleStore_),
+      executor_(new Utils::ThreadPool(other.getMaxAsyncRequests())) {
+}
+
+Core&
+Core::operator=(const Core& other) {
+  if (this != &other) {
+    service_           = other.service_;
+    localPow_          = other.localPow_;
+    chunkSizes_        = other.chunkSizes_;
+    maxChunksInFlight_ = other.maxChunksInFlight_;
+    trytesCache_       = other.trytesCache_;
+    tangleStore_       = other.tangleStore_;
+    executor_->setMaxThreads(other.getMaxAsyncRequests());
+  }
+
+  return *this;
 }
 
 Responses::GetNodeInfo
@@ -102,13 +185,199 @@ Core::findTransactions(const std::vector<Models::Address>& addresses,
     return Responses::FindTransactions();
   }
 
-  return service_.request<Requests::FindTransactions, Responses::FindTransactions>(
-      addresses, tags, approvees, bundles);
+  //! the node returns the intersection of the fields, so only the largest one is split
+  auto chunkSize = getChunkSize("findTransactions");
+  auto largest   = std::max({ addresses.size(), tags.size(), approvees.size(), bundles.size() });
+  auto nb        = nbChunks(largest, chunkSize);
+
+  if (nb == 1) {
+    return service_.request<Requests::FindTransactions, Responses::FindTransactions>(
+        addresses, tags, approvees, bundles);
+  }
+
+  std::vector<Responses::FindTransactions> chunks(nb);
+  dispatchChunks(nb, [&](std::size_t i) {
+    if (addresses.size() == largest) {
+      chunks[i] = service_.request<Requests::FindTransactions, Responses::FindTransactions>(
+          chunkOf(addresses, chunkSize, i), tags, approvees, bundles);
+    } else if (tags.size() == largest) {
+      chunks[i] = service_.request<Requests::FindTransactions, Responses::FindTransactions>(
+          addresses, chunkOf(tags, chunkSize, i), approvees, bundles);
+    } else if (approvees.size() == largest) {
+      chunks[i] = service_.request<Requests::FindTransactions, Responses::FindTransactions>(
+          addresses, tags, chunkOf(approvees, chunkSize, i), bundles);
+    } else {
+      chunks[i] = service_.request<Requests::FindTransactions, Responses::FindTransactions>(
+          addresses, tags, approvees, chunkOf(bundles, chunkSize, i));
+    }
+  });
+
+  auto res = mergeChunks(chunks, [](Responses::FindTransactions& r) -> std::vector<Types::Trytes>& {
+    return r.getHashes();
+  });
+
+  //! a transaction may match items of several chunks
+  auto&                             hashes = res.getHashes();
+  std::unordered_set<Types::Trytes> seen;
+  hashes.erase(std::remove_if(hashes.begin(), hashes.end(),
+                              [&seen](const Types::Trytes& h) { return !seen.insert(h).second; }),
+               hashes.end());
+
+  return res;
+}
+
+Responses::Base
+Core::findTransactions(const std::vector<Models::Address>& addresses,
+                       const std::vector<Models::Tag>&     tags,
+                       const std::vector<Types::Trytes>&   approvees,
+                       const std::vector<Types::Trytes>&   bundles,
+                       const TrytesConsumer&               consumer) const {
+  if (addresses.empty() && tags.empty() && approvees.empty() && bundles.empty()) {
+    return Responses::Base();
+  }
+
+  auto chunkSize = getChunkSize("findTransactions");
+  auto largest   = std::max({ addresses.size(), tags.size(), approvees.size(), bundles.size() });
+  auto nb        = nbChunks(largest, chunkSize);
+
+  //! chunks are read one after the other to keep memory bounded
+  int64_t                           duration = 0;
+  std::unordered_set<Types::Trytes> seen;
+  TrytesConsumer                    unique = [&](Types::Trytes&& hash) {
+    if (nb == 1 || seen.insert(hash).second) {
+      consumer(std::move(hash));
+    }
+  };
+
+  for (std::size_t i = 0; i < nb; ++i) {
+    JsonStreamReader reader(fieldHandler("hashes", unique, duration));
+
+    if (nb == 1) {
+      service_.stream<Requests::FindTransactions>(reader, addresses, tags, approvees, bundles);
+    } else if (addresses.size() == largest) {
+      service_.stream<Requests::FindTransactions>(reader, chunkOf(addresses, chunkSize, i), tags,
+                                                  approvees, bundles);
+    } else if (tags.size() == largest) {
+      service_.stream<Requests::FindTransactions>(reader, addresses, chunkOf(tags, chunkSize, i),
+                                                  approvees, bundles);
+    } else if (approvees.size() == largest) {
+      service_.stream<Requests::FindTransactions>(reader, addresses, tags,
+                                                  chunkOf(approvees, chunkSize, i), bundles);
+    } else {
+      service_.stream<Requests::FindTransactions>(reader, addresses, tags, approvees,
+                                                  chunkOf(bundles, chunkSize, i));
+    }
+  }
+
+  return Responses::Base{ duration };
+}
+
+Responses::Base
+Core::getTrytes(const std::vector<Types::Trytes>& hashes, const TrytesConsumer& consumer) const {
+  if (!trytesCache_ && !tangleStore_) {
+    return streamTrytes(hashes, consumer);
+  }
+
+  std::vector<Types::Trytes> cached(hashes.size());
+  std::vector<bool>          hit(hashes.size());
+  std::vector<Types::Trytes> missing;
+
+  for (std::size_t i = 0; i < hashes.size(); ++i) {
+    hit[i] = lookupTrytes(hashes[i], cached[i]);
+    if (!hit[i]) {
+      missing.push_back(hashes[i]);
+    }
+  }
+
+  //! cached trytes are handed out between the fetched ones, to keep the order of the hashes
+  std::size_t next     = 0;
+  auto        emitHits = [&]() {
+    while (next < hashes.size() && hit[next]) {
+      consumer(std::move(cached[next++]));
+    }
+  };
+
+  emitHits();
+  if (missing.empty()) {
+    return Responses::Base{};
+  }
+
+  return streamTrytes(missing, [&](Types::Trytes&& trytes) {
+    cacheTrytes(hashes[next++], trytes);
+    consumer(std::move(trytes));
+    emitHits();
+  });
+}
+
+Responses::Base
+Core::streamTrytes(const std::vector<Types::Trytes>& hashes, const TrytesConsumer& consumer) const {
+  auto    chunkSize = getChunkSize("getTrytes");
+  auto    nb        = nbChunks(hashes.size(), chunkSize);
+  int64_t duration  = 0;
+
+  for (std::size_t i = 0; i < nb; ++i) {
+    JsonStreamReader reader(fieldHandler("trytes", consumer, duration));
+
+    if (nb == 1) {
+      service_.stream<Requests::GetTrytes>(reader, hashes);
+    } else {
+      service_.stream<Requests::GetTrytes>(reader, chunkOf(hashes, chunkSize, i));
+    }
+  }
+
+  return Responses::Base{ duration };
 }
 
 Responses::GetTrytes
 Core::getTrytes(const std::vector<Types::Trytes>& hashes) const {
-  return service_.request<Requests::GetTrytes, Responses::GetTrytes>(hashes);
+  if (!trytesCache_ && !tangleStore_) {
+    return fetchTrytes(hashes);
+  }
+
+  std::vector<Types::Trytes> trytes(hashes.size());
+  std::vector<Types::Trytes> missing;
+  std::vector<std::size_t>   missingIndexes;
+
+  for (std::size_t i = 0; i < hashes.size(); ++i) {
+    if (!lookupTrytes(hashes[i], trytes[i])) {
+      missing.push_back(hashes[i]);
+      missingIndexes.push_back(i);
+    }
+  }
+
+  Responses::GetTrytes res;
+  if (!missing.empty()) {
+    res = fetchTrytes(missing);
+
+    auto& fetched = res.getTrytes();
+    for (std::size_t i = 0; i < fetched.size() && i < missingIndexes.size(); ++i) {
+      cacheTrytes(hashes[missingIndexes[i]], fetched[i]);
+      trytes[missingIndexes[i]] = std::move(fetched[i]);
+    }
+  }
+
+  res.getTrytes() = std::move(trytes);
+  return res;
+}
+
+Responses::GetTrytes
+Core::fetchTrytes(const std::vector<Types::Trytes>& hashes) const {
+  auto chunkSize = getChunkSize("getTrytes");
+  auto nb        = nbChunks(hashes.size(), chunkSize);
+
+  if (nb == 1) {
+    return service_.request<Requests::GetTrytes, Responses::GetTrytes>(hashes);
+  }
+
+  std::vector<Responses::GetTrytes> chunks(nb);
+  dispatchChunks(nb, [&](std::size_t i) {
+    chunks[i] = service_.request<Requests::GetTrytes, Responses::GetTrytes>(
+        chunkOf(hashes, chunkSize, i));
+  });
+
+  return mergeChunks(chunks, [](Responses::GetTrytes& r) -> std::vector<Types::Trytes>& {
+    return r.getTrytes();
+  });
 }
 
 Responses::GetInclusionStates
@@ -122,15 +391,84 @@ Core::getInclusionStates(const std::vector<Types::Trytes>& transactions,
     throw Errors::IllegalState("Empty list of tips");
   }
 
-  return service_.request<Requests::GetInclusionStates, Responses::GetInclusionStates>(transactions,
-                                                                                       tips);
+  auto chunkSize = getChunkSize("getInclusionStates");
+  auto nb        = nbChunks(transactions.size(), chunkSize);
+
+  if (nb == 1) {
+    return service_.request<Requests::GetInclusionStates, Responses::GetInclusionStates>(
+        transactions, tips);
+  }
+
+  std::vector<Responses::GetInclusionStates> chunks(nb);
+  dispatchChunks(nb, [&](std::size_t i) {
+    chunks[i] = service_.request<Requests::GetInclusionStates, Responses::GetInclusionStates>(
+        chunkOf(transactions, chunkSize, i), tips);
+  });
+
+  return mergeChunks(chunks, [](Responses::GetInclusionStates& r) -> std::vector<bool>& {
+    return r.getStates();
+  });
 }
 
 Responses::GetBalances
 Core::getBalances(const std::vector<Models::Address>& addresses, const int& threshold,
                   const std::vector<Types::Trytes>& tips) const {
-  return service_.request<Requests::GetBalances, Responses::GetBalances>(addresses, threshold,
-                                                                         tips);
+  auto chunkSize = getChunkSize("getBalances");
+  auto nb        = nbChunks(addresses.size(), chunkSize);
+
+  if (nb == 1) {
+    return service_.request<Requests::GetBalances, Responses::GetBalances>(addresses, threshold,
+                                                                           tips);
+  }
+
+  std::vector<Responses::GetBalances> chunks(nb);
+  dispatchChunks(nb, [&](std::size_t i) {
+    chunks[i] = service_.request<Requests::GetBalances, Responses::GetBalances>(
+        chunkOf(addresses, chunkSize, i), threshold, tips);
+  });
+
+  //! references and milestone index are the ones of the first chunk
+  return mergeChunks(chunks, [](Responses::GetBalances& r) -> std::vector<std::string>& {
+    return r.getBalances();
+  });
+}
+
+Responses::GetBalances
+Core::getBalances(const std::vector<Models::Address>& addresses, const int& threshold,
+                  const std::vector<Types::Trytes>&   tips,
+                  const std::function<void(int64_t)>& consumer) const {
+  auto                       chunkSize      = getChunkSize("getBalances");
+  auto                       nb             = nbChunks(addresses.size(), chunkSize);
+  int64_t                    duration       = 0;
+  int64_t                    milestoneIndex = 0;
+  std::vector<Types::Trytes> references;
+
+  for (std::size_t i = 0; i < nb; ++i) {
+    //! references and milestone index are the ones of the first chunk
+    bool             first = i == 0;
+    JsonStreamReader reader([&](const std::string& field, std::string&& value) {
+      if (field == "balances") {
+        consumer(std::stoll(value));
+      } else if (field == "duration") {
+        duration += std::stoll(value);
+      } else if (first && field == "references") {
+        references.push_back(std::move(value));
+      } else if (first && field == "milestoneIndex") {
+        milestoneIndex = std::stoll(value);
+      }
+    });
+
+    if (nb == 1) {
+      service_.stream<Requests::GetBalances>(reader, addresses, threshold, tips);
+    } else {
+      service_.stream<Requests::GetBalances>(reader, chunkOf(addresses, chunkSize, i), threshold,
+                                             tips);
+    }
+  }
+
+  Responses::GetBalances res({}, references, milestoneIndex);
+  res.setDuration(duration);
+  return res;
 }
 
 Responses::GetTransactionsToApprove
@@ -147,6 +485,8 @@ Core::attachToTangle(const Types::Trytes& trunkTransaction, const Types::Trytes&
     Crypto::Pow                pow;
     std::vector<Types::Trytes> resultTrytes;
     Types::Trytes              prevTx;
+    //! serialization buffer reused across transactions
+    Types::Trytes buffer(TrxTrytesLength, '9');
     for (auto& txTrytes : trytes) {
       auto tx = IOTA::Models::Transaction(txTrytes);
 
@@ -155,13 +495,15 @@ Core::attachToTangle(const Types::Trytes& trunkTransaction, const Types::Trytes&
       tx.setAttachmentTimestamp(Utils::StopWatch::now().count());
       tx.setAttachmentTimestampLowerBound(0);
       tx.setAttachmentTimestampUpperBound(3812798742493L);
-      tx.setNonce(pow(tx.toTrytes(), minWeightMagnitude));
+      tx.toTrytes(&buffer[0]);
+      tx.setNonce(pow(buffer, minWeightMagnitude));
 
       if (tx.getTag().empty()) {
         tx.setTag(tx.getObsoleteTag());
       }
 
-      resultTrytes.emplace_back(tx.toTrytes());
+      tx.toTrytes(&buffer[0]);
+      resultTrytes.push_back(buffer);
       prevTx = tx.getHash();
     }
     return Responses::AttachToTangle(resultTrytes);
@@ -187,8 +529,24 @@ Core::storeTransactions(const std::vector<Types::Trytes>& trytes) const {
 
 Responses::WereAddressesSpentFrom
 Core::wereAddressesSpentFrom(const std::vector<Models::Address>& addresses) const {
-  return service_.request<Requests::WereAddressesSpentFrom, Responses::WereAddressesSpentFrom>(
-      addresses);
+  auto chunkSize = getChunkSize("wereAddressesSpentFrom");
+  auto nb        = nbChunks(addresses.size(), chunkSize);
+
+  if (nb == 1) {
+    return service_.request<Requests::WereAddressesSpentFrom, Responses::WereAddressesSpentFrom>(
+        addresses);
+  }
+
+  std::vector<Responses::WereAddressesSpentFrom> chunks(nb);
+  dispatchChunks(nb, [&](std::size_t i) {
+    chunks[i] =
+        service_.request<Requests::WereAddressesSpentFrom, Responses::WereAddressesSpentFrom>(
+            chunkOf(addresses, chunkSize, i));
+  });
+
+  return mergeChunks(chunks, [](Responses::WereAddressesSpentFrom& r) -> std::vector<bool>& {
+    return r.getStates();
+  });
 }
 
 Responses::CheckConsistency
@@ -196,6 +554,187 @@ Core::checkConsistency(const std::vector<Types::Trytes>& tails) const {
   return service_.request<Requests::CheckConsistency, Responses::CheckConsistency>(tails);
 }
 
+std::future<Responses::FindTransactions>
+Core::findTransactionsAsync(const std::vector<Models::Address>& addresses,
+                            const std::vector<Models::Tag>&     tags,
+                            const std::vector<Types::Trytes>&   approvees,
+                            const std::vector<Types::Trytes>&   bundles) const {
+  return async(*this, [addresses, tags, approvees, bundles](const Core& api) {
+    return api.findTransactions(addresses, tags, approvees, bundles);
+  });
+}
+
+std::future<Responses::GetTrytes>
+Core::getTrytesAsync(const std::vector<Types::Trytes>& hashes) const {
+  return async(*this, [hashes](const Core& api) { return api.getTrytes(hashes); });
+}
+
+std::future<Responses::GetInclusionStates>
+Core::getInclusionStatesAsync(const std::vector<Types::Trytes>& transactions,
+                              const std::vector<Types::Trytes>& tips) const {
+  return async(*this, [transactions, tips](const Core& api) {
+    return api.getInclusionStates(transactions, tips);
+  });
+}
+
+std::future<Responses::GetBalances>
+Core::getBalancesAsync(const std::vector<Models::Address>& addresses, const int& threshold,
+                       const std::vector<Types::Trytes>& tips) const {
+  auto thresholdCopy = threshold;
+
+  return async(*this, [addresses, thresholdCopy, tips](const Core& api) {
+    return api.getBalances(addresses, thresholdCopy, tips);
+  });
+}
+
+std::size_t
+Core::getMaxAsyncRequests() const {
+  return executor_->getMaxThreads();
+}
+
+void
+Core::setMaxAsyncRequests(std::size_t maxRequests) {
+  executor_->setMaxThreads(maxRequests);
+
+  //! keep enough idle sessions for every request in flight
+  service_.reserveSessions(maxRequests);
+}
+
+void
+Core::enableTrytesCache(std::size_t capacity) {
+  if (capacity == 0) {
+    trytesCache_.reset();
+  } else {
+    trytesCache_ = std::make_shared<TrytesCache>(capacity);
+  }
+}
+
+const std::shared_ptr<Core::TrytesCache>&
+Core::getTrytesCache() const {
+  return trytesCache_;
+}
+
+void
+Core::setTangleStore(const std::shared_ptr<TangleStore>& store) {
+  tangleStore_ = store;
+}
+
+const std::shared_ptr<TangleStore>&
+Core::getTangleStore() const {
+  return tangleStore_;
+}
+
+bool
+Core::lookupTrytes(const Types::Trytes& hash, Types::Trytes& trytes) const {
+  if (!isCacheableHash(hash)) {
+    return false;
+  }
+
+  if (trytesCache_ && trytesCache_->get(hash, trytes)) {
+    return true;
+  }
+
+  if (tangleStore_ && tangleStore_->getTrytes(hash, trytes)) {
+    if (trytesCache_) {
+      trytesCache_->put(hash, trytes);
+    }
+    return true;
+  }
+
+  return false;
+}
+
+bool
+Core::isCacheableHash(const Types::Trytes& hash) {
+  return hash.size() == HashLength;
+}
+
+void
+Core::cacheTrytes(const Types::Trytes& hash, const Types::Trytes& trytes) const {
+  //! the node answers with empty trytes for unknown transactions, which may become known later
+  if (isCacheableHash(hash) && trytes.size() == TrxTrytesLength &&
+      trytes.find_first_not_of('9') != Types::Trytes::npos) {
+    if (trytesCache_) {
+      trytesCache_->put(hash, trytes);
+    }
+    if (tangleStore_) {
+      tangleStore_->add(hash, trytes);
+    }
+  }
+}
+
+Service&
+Core::getService() {
+  return service_;
+}
+
+const Service&
+Core::getService() const {
+  return service_;
+}
+
+std::size_t
+Core::getChunkSize(const std::string& command) const {
+  auto it = chunkSizes_.find(command);
+  return it == chunkSizes_.end() ? 0 : it->second;
+}
+
+bool
+Core::isSingleChunk(const std::string& command, std::size_t size) const {
+  return nbChunks(size, getChunkSize(command)) == 1;
+}
+
+void
+Core::setChunkSize(const std::string& command, std::size_t chunkSize) {
+  chunkSizes_[command] = chunkSize;
+}
+
+std::size_t
+Core::getMaxChunksInFlight() const {
+  return maxChunksInFlight_;
+}
+
+void
+Core::setMaxChunksInFlight(std::size_t maxChunks) {
+  maxChunksInFlight_ = std::max<std::size_t>(maxChunks, 1);
+}
+
+void
+Core::dispatchChunks(std::size_t nbChunks, const std::function<void(std::size_t)>& fn) const {
+  std::atomic<std::size_t> next(0);
+  std::atomic<bool>        failed(false);
+
+  //! chunks run on dedicated threads rather than on the async executor, which may be the caller
+  std::size_t                    nbWorkers = std::min(maxChunksInFlight_, nbChunks);
+  std::vector<std::future<void>> workers;
+  for (std::size_t w = 0; w < nbWorkers; ++w) {
+    workers.push_back(std::async(std::launch::async, [&]() {
+      for (;;) {
+        std::size_t i = next++;
+        if (i >= nbChunks || failed) {
+          return;
+        }
+
+        try {
+          fn(i);
+        } catch (...) {
+          failed = true;
+          throw;
+        }
+      }
+    }));
+  }
+
+  //! wait for all the workers before rethrowing, they reference local state
+  for (auto& worker : workers) {
+    worker.wait();
+  }
+
+  for (auto& worker : workers) {
+    worker.get();
+  }
+}
+
 }  // namespace API
 
 }  // namespace IOTA
@@ -23,7 +23,11 @@
 //
 //
 
+#include <algorithm>
+#include <future>
 #include <iostream>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <iota/api/extended.hpp>
 #include <iota/api/responses/attach_to_tangle.hpp>
@@ -42,15 +46,18 @@
 #include <iota/api/responses/replay_bundle.hpp>
 #include <iota/api/responses/send_transfer.hpp>
 #include <iota/api/responses/were_addresses_spent_from.hpp>
+#include <iota/constants.hpp>
 #include <iota/crypto/curl.hpp>
 #include <iota/crypto/kerl.hpp>
 #include <iota/crypto/signing.hpp>
 #include <iota/errors/illegal_state.hpp>
 #include <iota/models/bundle.hpp>
+#include <iota/models/bundle_builder.hpp>
 #include <iota/models/seed.hpp>
 #include <iota/models/signature.hpp>
 #include <iota/models/transaction.hpp>
 #include <iota/models/transfer.hpp>
+#include <iota/types/hash.hpp>
 #include <iota/types/trinary.hpp>
 #include <iota/types/utils.hpp>
 #include <iota/utils/parallel_for.hpp>
@@ -79,7 +86,16 @@ Extended::getInputs(const Models::Seed& seed, const int32_t& start, const int32_
 
   int32_t nbAddresses = end != 0 ? end - start : 0;
   auto    addresses   = getNewAddresses(seed, start, nbAddresses, true).getAddresses();
-  auto    res         = getBalancesAndFormat(addresses, threshold);
+
+  //! never reuse an address already spent from as input, whether or not a store is attached
+  const auto  spent = getSpentStates(addresses);
+  std::size_t i     = 0;
+
+  addresses.erase(std::remove_if(addresses.begin(), addresses.end(),
+                                 [&spent, &i](const Models::Address&) { return spent[i++]; }),
+                  addresses.end());
+
+  auto res = getBalancesAndFormat(addresses, threshold);
 
   //! update duration
   res.setDuration(stopWatch.getElapsedTime().count());
@@ -150,21 +166,42 @@ Extended::getNewAddresses(const Models::Seed& seed, const uint32_t& index, const
   // Case 2 : no total provided.
   // Continue calling wereAddressesSpentFrom & findTransactions to see if address was already
   // created if null, return list of addresses.
+  // Spent states are checked by windows of addresses, doubled as long as all the addresses are
+  // spent, so that a long run of spent addresses only takes a few requests. A window holding an
+  // unspent address brings the next one back to a single address.
   else {
-    for (int32_t i = index; true; i++) {
-      const auto addr = seed.newAddress(i);
+    const auto maxWindow = std::max<std::size_t>(getChunkSize("wereAddressesSpentFrom"), 1);
+    uint32_t   next      = index;
+    bool       found     = false;
+
+    for (std::size_t window = 1; !found;) {
+      std::vector<Models::Address> addresses;
+      for (std::size_t i = 0; i < window; ++i) {
+        addresses.emplace_back(seed.newAddress(next++));
+      }
 
-      const auto spent = wereAddressesSpentFrom({ addr });
-      if (spent.getStates()[0]) {
-        allAddresses.emplace_back(std::move(addr));
-        continue;
+      const auto               spent = getSpentStates(addresses);
+      std::vector<std::size_t> unspent;
+      for (std::size_t i = 0; i < addresses.size(); ++i) {
+        if (!spent[i]) {
+          unspent.push_back(i);
+        }
       }
 
-      const auto res = findTransactionsByAddresses({ addr });
-      allAddresses.emplace_back(std::move(addr));
-      if (res.getHashes().empty()) {
-        break;
+      //! a findTransactions per unspent address, sent concurrently, tells the used ones apart
+      //! from their hash lists alone
+      std::vector<char> used(addresses.size(), 0);
+      dispatchChunks(unspent.size(), [&](std::size_t i) {
+        const auto& address = addresses[unspent[i]];
+        used[unspent[i]]    = !findTransactionsByAddresses({ address }).getHashes().empty();
+      });
+
+      for (std::size_t i = 0; i < addresses.size() && !found; ++i) {
+        found = !spent[i] && !used[i];
+        allAddresses.emplace_back(std::move(addresses[i]));
       }
+
+      window = unspent.empty() ? std::min(2 * window, maxWindow) : 1;
     }
   }
 
@@ -199,11 +236,98 @@ Extended::traverseBundles(const std::vector<Types::Trytes>& trunkTrxs, bool thro
     bundlesRefs.push_back(std::ref(bundle));
   }
 
-  traverseBundles(trunkTrxs, bundlesRefs, throwOnFail);
+  fetchBundles(trunkTrxs, bundlesRefs, throwOnFail);
 
   return bundles;
 }
 
+void
+Extended::fetchBundles(const std::vector<Types::Trytes>&                          tails,
+                       const std::vector<std::reference_wrapper<Models::Bundle>>& bundles,
+                       bool throwOnFail) const {
+  if (!wholeBundleFetch_) {
+    traverseBundles(tails, bundles, throwOnFail);
+    return;
+  }
+
+  //! nothing to fetch
+  if (tails.empty()) {
+    return;
+  }
+
+  auto tailTrxs = getTransactionsViews(tails);
+
+  //! If fail to get trytes, return error
+  if (tailTrxs.size() != tails.size()) {
+    throw Errors::IllegalState("Invalid transaction supplied.");
+  }
+
+  //! fetch every transaction sharing the bundle hashes of the tails at once, reattachments
+  //! included. An all-9 bundle hash is what the node returns for unknown transactions
+  std::vector<Types::Trytes>      bundleHashes;
+  std::unordered_set<Types::Hash> knownBundles;
+
+  for (const auto& trx : tailTrxs) {
+    auto bundle = trx.getBundle();
+    if (bundle != EmptyHash && knownBundles.insert(bundle).second) {
+      bundleHashes.push_back(std::move(bundle));
+    }
+  }
+
+  auto candidates = getTransactionsViews(findTransactionsByBundles(bundleHashes).getHashes());
+
+  std::unordered_map<Types::Hash, const Models::TransactionView*> candidatesByHash;
+  for (const auto& trx : candidates) {
+    candidatesByHash.emplace(trx.getHash(), &trx);
+  }
+
+  //! bundles whose trunk chain is not complete in memory are traversed trunk by trunk
+  std::vector<Types::Trytes>                          trunkTrxs;
+  std::vector<std::reference_wrapper<Models::Bundle>> partialBundles;
+
+  for (std::size_t i = 0; i < tailTrxs.size(); ++i) {
+    const auto& tail   = tailTrxs[i];
+    auto&       bundle = bundles[i].get();
+
+    //! If first transaction to search is not a tail, or is unknown, return error
+    if (!tail.isTailTransaction() || tail.getBundle() == EmptyHash ||
+        tail.getTrunkTransaction() == tail.getHash()) {
+      if (throwOnFail) {
+        throw Errors::IllegalState(tail.isTailTransaction() ? "Invalid transaction supplied."
+                                                            : "Invalid tail transaction supplied.");
+      }
+      //! if we are in silent mode, we clear the bundle and continue
+      bundle = {};
+      continue;
+    }
+
+    bundle.setHash(tail.getBundle());
+    bundle.addTransaction(Models::Transaction{ tail });
+
+    //! follow the trunk chain of this tail only: reattachments share the bundle hash but each has
+    //! its own chain
+    const Models::TransactionView* trx = &tail;
+    while (trx->getCurrentIndex() < trx->getLastIndex()) {
+      auto next = candidatesByHash.find(trx->getTrunkTransaction());
+
+      if (next == candidatesByHash.end() || next->second->getBundle() != bundle.getHash() ||
+          next->second->getCurrentIndex() != trx->getCurrentIndex() + 1) {
+        break;
+      }
+
+      trx = next->second;
+      bundle.addTransaction(Models::Transaction{ *trx });
+    }
+
+    if (trx->getCurrentIndex() < trx->getLastIndex()) {
+      trunkTrxs.push_back(trx->getTrunkTransaction());
+      partialBundles.push_back(bundle);
+    }
+  }
+
+  traverseBundles(trunkTrxs, partialBundles, throwOnFail);
+}
+
 void
 Extended::traverseBundles(const std::vector<Types::Trytes>&                          trxs,
                           const std::vector<std::reference_wrapper<Models::Bundle>>& bundles,
@@ -214,7 +338,7 @@ Extended::traverseBundles(const std::vector<Types::Trytes>&
   }
 
   //! get trytes for non-empty transactions
-  const auto gtr = getTrytes(trxs);
+  auto gtr = getTrytes(trxs);
 
   //! If fail to get trytes, return error
   if (gtr.getTrytes().empty()) {
@@ -227,8 +351,8 @@ Extended::traverseBundles(const std::vector<Types::Trytes>&
 
   //! process each tryte
   for (std::size_t i = 0; i < gtr.getTrytes().size(); ++i) {
-    //! get transaction itself
-    const auto trx = Models::Transaction{ gtr.getTrytes()[i] };
+    //! get a view on the transaction, it is only materialized if it belongs to the bundle
+    const auto trx = Models::TransactionView{ std::move(gtr.getTrytes()[i]) };
 
     //! get bundle
     auto& bundle = bundles[i].get();
@@ -260,7 +384,7 @@ Extended::traverseBundles(const std::vector<Types::Trytes>&
 
     if (bundle.getHash() == trx.getBundle()) {
       //! Add transaction object to bundle
-      bundle.addTransaction(trx);
+      bundle.addTransaction(Models::Transaction{ trx });
 
       //! keep track of which bundles need to be filled recursively
       trunkTrxs.push_back(trx.getTrunkTransaction());
@@ -299,76 +423,98 @@ Extended::getTransactionsObjects(const std::vector<Types::Trytes>& hashes) const
     throw Errors::IllegalState("getTransactionsObjects parameter is not a valid array of hashes");
   }
 
-  //! get trytes forhashes
-  const auto trytesResponse = getTrytes(hashes);
-
-  //! build response
   std::vector<Models::Transaction> trxs;
+  trxs.reserve(hashes.size());
 
-  for (const auto& tryte : trytesResponse.getTrytes()) {
-    trxs.emplace_back(tryte);
+  //! chunks are fetched concurrently: only stream requests answered in one chunk
+  if (isSingleChunk("getTrytes", hashes.size())) {
+    getTrytes(hashes, [&trxs](Types::Trytes&& trytes) { trxs.emplace_back(trytes); });
+  } else {
+    const auto res = getTrytes(hashes);
+    for (const auto& trytes : res.getTrytes()) {
+      trxs.emplace_back(trytes);
+    }
   }
 
   return trxs;
 }
 
-std::vector<Models::Bundle>
-Extended::bundlesFromAddresses(const std::vector<Models::Address>& addresses,
-                               bool                                withInclusionStates) const {
-  //! find transactions for addresses
-  const auto trxs = findTransactionObjects(addresses);
-  if (trxs.empty())
+std::vector<Models::TransactionView>
+Extended::getTransactionsViews(const std::vector<Types::Trytes>& hashes) const {
+  if (!Types::isArrayOfHashes(hashes)) {
+    throw Errors::IllegalState("getTransactionsViews parameter is not a valid array of hashes");
+  }
+
+  //! nothing to fetch
+  if (hashes.empty()) {
     return {};
+  }
 
-  //! filter tail/non tail transactions
-  std::vector<Models::Transaction> tailTrxs;
-  std::vector<Models::Transaction> nonTailTrxs;
+  //! trytes are moved into the views
+  std::vector<Models::TransactionView> trxs;
+  trxs.reserve(hashes.size());
 
-  for (const auto& trx : trxs) {
-    if (trx.isTailTransaction()) {
-      tailTrxs.emplace_back(trx);
-    } else {
-      nonTailTrxs.emplace_back(trx);
+  //! chunks are fetched concurrently: only stream requests answered in one chunk
+  if (isSingleChunk("getTrytes", hashes.size())) {
+    getTrytes(hashes, [&trxs](Types::Trytes&& trytes) { trxs.emplace_back(std::move(trytes)); });
+  } else {
+    auto res = getTrytes(hashes);
+    for (auto& trytes : res.getTrytes()) {
+      trxs.emplace_back(std::move(trytes));
     }
   }
 
-  //! filter out non-tail transactions for which we already got the bundle tail transaction
-  //! only keep bundle hash to pass that as argument of findTransactionObjectsByBundle
-  std::vector<Types::Trytes> nonTailTrxsBundleHashes;
+  return trxs;
+}
 
-  for (const auto& trx : nonTailTrxs) {
-    //! skip if we already filtered a non-tail transaction belonging to the same bundle
-    auto nonTailDuplicateBundle =
-        std::find(nonTailTrxsBundleHashes.begin(), nonTailTrxsBundleHashes.end(), trx.getBundle());
+std::vector<Models::Bundle>
+Extended::bundlesFromAddresses(const std::vector<Models::Address>& addresses,
+                               bool                                withInclusionStates) const {
+  return bundlesFromTransactions(findTransactionsByAddresses(addresses).getHashes(),
+                                 withInclusionStates);
+}
 
-    if (nonTailDuplicateBundle != nonTailTrxsBundleHashes.end()) {
-      continue;
-    }
+std::vector<Models::Bundle>
+Extended::bundlesFromTransactions(const std::vector<Types::Trytes>& hashes,
+                                  bool                              withInclusionStates) const {
+  //! only the bundle, index and hash are needed here: use views to avoid decoding everything
+  auto trxs = getTransactionsViews(hashes);
+  if (trxs.empty())
+    return {};
 
-    //! skip if we already got a tail transaction fro that bundle
-    auto tailDuplicateBundle = std::find_if(
-        tailTrxs.begin(), tailTrxs.end(),
-        [&](const Models::Transaction& lhs) { return lhs.getBundle() == trx.getBundle(); });
+  //! keep the hash of each distinct tail transaction
+  //! only keep the bundle hash of non-tail transactions to pass it to findTransactionsByBundles
+  std::vector<Types::Trytes>      tailTrxsHashes;
+  std::unordered_set<Types::Hash> knownTails;
+  std::vector<Types::Trytes>      nonTailTrxsBundleHashes;
+  std::unordered_set<Types::Hash> knownBundles;
 
-    if (tailDuplicateBundle != tailTrxs.end()) {
-      continue;
+  for (const auto& trx : trxs) {
+    if (trx.isTailTransaction() && knownTails.insert(trx.getHash()).second) {
+      tailTrxsHashes.push_back(trx.getHash());
+      knownBundles.insert(trx.getBundle());
     }
-
-    //! otherwise keep track to fetch bundle with findTransactionObjectsByBundle
-    nonTailTrxsBundleHashes.push_back(trx.getBundle());
   }
 
-  //! find transactions for bundles of non tail transactions
-  //! add these transactions to the list of tail transactions
-  const auto trxFromBundle = findTransactionObjectsByBundle(nonTailTrxsBundleHashes);
-  tailTrxs.insert(tailTrxs.end(), trxFromBundle.begin(), trxFromBundle.end());
+  //! skip non-tail transactions for which we already got the bundle tail transaction, or filtered
+  //! a non-tail transaction, for that bundle
+  for (const auto& trx : trxs) {
+    if (!trx.isTailTransaction()) {
+      auto bundle = trx.getBundle();
+      if (knownBundles.insert(bundle).second) {
+        nonTailTrxsBundleHashes.push_back(std::move(bundle));
+      }
+    }
+  }
 
-  //! keep only hash
-  std::vector<Types::Trytes> tailTrxsHashes;
-  tailTrxsHashes.reserve(tailTrxs.size());
+  trxs.clear();
 
-  for (const auto& trx : tailTrxs) {
-    tailTrxsHashes.emplace_back(trx.getHash());
+  //! find the tails of the bundles of non tail transactions, reattachments included
+  for (const auto& trx :
+       getTransactionsViews(findTransactionsByBundles(nonTailTrxsBundleHashes).getHashes())) {
+    if (trx.isTailTransaction() && knownTails.insert(trx.getHash()).second) {
+      tailTrxsHashes.push_back(trx.getHash());
+    }
   }
 
   //! If inclusionStates, get the confirmation status
@@ -382,49 +528,74 @@ Extended::bundlesFromAddresses(const std::vector<Models::Address>& addresses,
     }
   }
 
-  std::mutex                  allBundlesMtx;
-  std::vector<Models::Bundle> allBundles;
+  //! bundles already verified are taken from the cache, the others are fetched
+  std::vector<Models::Bundle> bundles(tailTrxsHashes.size());
+  std::vector<char>           verified(tailTrxsHashes.size(), 0);
+  std::vector<std::size_t>    missing;
+
+  for (std::size_t i = 0; i < tailTrxsHashes.size(); ++i) {
+    if (getCachedBundle(tailTrxsHashes[i], bundles[i])) {
+      verified[i] = 1;
+    } else {
+      missing.push_back(i);
+    }
+  }
+
+  //! missing bundles are fetched and verified by batches, which idle workers pick up as they go.
+  //! Each bundle is only touched by the worker owning its batch: no lock is needed
+  const std::size_t batchSize = BundlesFetchBatchSize;
+  const std::size_t nbBatches = (missing.size() + batchSize - 1) / batchSize;
 
-  std::size_t nb_cores   = std::thread::hardware_concurrency();
-  std::size_t nb_threads = std::min(nb_cores, tailTrxsHashes.size());
+  Utils::parallel_for(std::size_t{ 0 }, nbBatches, [&](std::size_t batch) {
+    auto first = missing.begin() + batch * batchSize;
+    auto last  = missing.begin() + std::min(missing.size(), (batch + 1) * batchSize);
 
-  Utils::parallel_for(nb_threads, [&](int cpu, int num_cpus) {
-    int start = tailTrxsHashes.size() * cpu / num_cpus;
-    int end   = tailTrxsHashes.size() * (cpu + 1) / num_cpus;
+    std::vector<Types::Trytes>                          tails;
+    std::vector<std::reference_wrapper<Models::Bundle>> refs;
 
-    //! for last cpu, ensure we got all remaining of the list
-    if (cpu == num_cpus - 1) {
-      end = tailTrxsHashes.size();
+    for (auto it = first; it != last; ++it) {
+      tails.push_back(tailTrxsHashes[*it]);
+      refs.push_back(std::ref(bundles[*it]));
     }
 
-    auto startIt = tailTrxsHashes.begin() + start;
-    auto endIt   = tailTrxsHashes.begin() + end;
-    auto bundles = traverseBundles({ startIt, endIt }, false);
+    fetchBundles(tails, refs, false);
 
-    if (withInclusionStates) {
-      for (std::size_t i = 0; i < bundles.size(); ++i) {
-        auto& trxs      = bundles[i].getTransactions();
-        bool  inclusion = inclusionStates.getStates()[start + i];
+    //! verified before persistence is set so that the cache does not hold inclusion states
+    for (auto it = first; it != last; ++it) {
+      auto& bundle = bundles[*it];
+      if (bundle.getTransactions().empty()) {
+        continue;
+      }
 
-        for (auto& t : trxs) {
-          t.setPersistence(inclusion);
-        }
+      try {
+        verifyBundle(bundle);
+        cacheBundle(tailTrxsHashes[*it], bundle);
+        verified[*it] = 1;
+      } catch (std::runtime_error&) {
       }
     }
+  });
 
-    std::lock_guard<std::mutex> lock(allBundlesMtx);
+  //! only keep valid non-empty bundles
+  std::vector<Models::Bundle> allBundles;
+  allBundles.reserve(bundles.size());
 
-    //! only keep valid non-empty bundles
-    for (auto& bundle : bundles) {
-      if (!bundle.getTransactions().empty()) {
-        try {
-          verifyBundle(bundle);
-          allBundles.push_back(std::move(bundle));
-        } catch (std::runtime_error&) {
-        }
+  for (std::size_t i = 0; i < bundles.size(); ++i) {
+    auto& bundle = bundles[i];
+    if (!verified[i] || bundle.getTransactions().empty()) {
+      continue;
+    }
+
+    if (withInclusionStates) {
+      bool inclusion = inclusionStates.getStates()[i];
+
+      for (auto& t : bundle.getTransactions()) {
+        t.setPersistence(inclusion);
       }
     }
-  });
+
+    allBundles.push_back(std::move(bundle));
+  }
 
   std::sort(allBundles.begin(), allBundles.end());
 
@@ -433,73 +604,82 @@ Extended::bundlesFromAddresses(const std::vector<Models::Address>& addresses,
 
 Responses::GetInclusionStates
 Extended::getLatestInclusion(const std::vector<Types::Trytes>& hashes) const {
-  return getInclusionStates(hashes, { getNodeInfo().getLatestSolidSubtangleMilestone() });
-}
+  auto& confirmedTails = inclusionCache_->confirmedTails;
 
-std::vector<Types::Trytes>
-Extended::prepareTransfers(const Models::Seed& seed, const std::vector<Models::Transfer>& transfers,
-                           const Models::Address&              remainder,
-                           const std::vector<Models::Address>& inputs, bool validateInputs) const {
-  // Validate transfers object
-  if (!isTransfersCollectionValid(transfers)) {
-    throw Errors::IllegalState("Invalid Transfer");
+  //! confirmed transactions stay confirmed: only ask for the others
+  std::vector<bool>          states(hashes.size(), false);
+  std::vector<Types::Trytes> unknown;
+  std::vector<std::size_t>   positions;
+  bool                       confirmed;
+
+  for (std::size_t i = 0; i < hashes.size(); ++i) {
+    if (confirmedTails.get(hashes[i], confirmed)) {
+      states[i] = true;
+    } else {
+      unknown.push_back(hashes[i]);
+      positions.push_back(i);
+    }
   }
 
-  Models::Bundle             bundle;
-  std::vector<Types::Trytes> signatureFragments;
-  int64_t                    totalValue = 0;
+  if (unknown.empty()) {
+    return Responses::GetInclusionStates{ states };
+  }
 
-  //  Iterate over all transfers, get totalValue
-  //  and prepare the signatureFragments, message and tag
-  for (const auto& transfer : transfers) {
-    int signatureMessageLength = 1;
+  auto res = getInclusionStates(unknown, { getLatestSolidMilestone() });
 
-    // If message longer than 2187 trytes, increase signatureMessageLength (add 2nd transaction)
-    if (transfer.getMessage().size() > MaxTrxMsgLength) {
-      // Get total length, message / maxLength (2187 trytes)
-      signatureMessageLength += (int)std::floor(transfer.getMessage().length() / MaxTrxMsgLength);
+  //! callers index the states by position in hashes
+  if (res.getStates().size() != unknown.size()) {
+    throw Errors::IllegalState("Invalid number of inclusion states");
+  }
 
-      Types::Trytes msgCopy = transfer.getMessage();
+  for (std::size_t i = 0; i < unknown.size(); ++i) {
+    if (res.getStates()[i]) {
+      states[positions[i]] = true;
+      confirmedTails.put(unknown[i], true);
+    }
+  }
 
-      // While there is still a message, copy it
-      while (!msgCopy.empty()) {
-        Types::Trytes fragment = msgCopy.substr(0, MaxTrxMsgLength);
+  res.getStates() = std::move(states);
+  return res;
+}
 
-        if (msgCopy.length() > MaxTrxMsgLength) {
-          msgCopy = msgCopy.substr(MaxTrxMsgLength, msgCopy.length());
-        } else {
-          msgCopy = "";
-        }
+Types::Trytes
+Extended::getLatestSolidMilestone() const {
+  //! one refresh at a time, the other callers reuse its result
+  std::lock_guard<std::mutex> lock(inclusionCache_->milestoneMtx);
 
-        signatureFragments.push_back(Types::Utils::rightPad(fragment, MaxTrxMsgLength, '9'));
-      }
-    } else {
-      // Else, get single fragment with 2187 of 9's trytes
-      auto fragment = transfer.getMessage().substr(0, MaxTrxMsgLength);
-
-      fragment = Types::Utils::rightPad(fragment, MaxTrxMsgLength, '9');
+  const auto now = Utils::StopWatch::now();
+  if (inclusionCache_->milestone.empty() ||
+      now - inclusionCache_->fetchedAt >= std::chrono::milliseconds(milestoneRefreshInterval_)) {
+    inclusionCache_->milestone = getNodeInfo().getLatestSolidSubtangleMilestone();
+    inclusionCache_->fetchedAt = now;
+  }
 
-      signatureFragments.push_back(fragment);
-    }
+  return inclusionCache_->milestone;
+}
 
-    // get current timestamp in seconds
-    int64_t timestamp = Utils::StopWatch::now().count();
+std::vector<Types::Trytes>
+Extended::prepareTransfers(const Models::Seed& seed, const std::vector<Models::Transfer>& transfers,
+                           const Models::Address&              remainder,
+                           const std::vector<Models::Address>& inputs, bool validateInputs) const {
+  // Validate transfers object
+  if (!isTransfersCollectionValid(transfers)) {
+    throw Errors::IllegalState("Invalid Transfer");
+  }
 
-    // Add first entry to the bundle
-    bundle.addTransaction(
-        { transfer.getAddress(), transfer.getValue(), transfer.getTag(), timestamp },
-        signatureMessageLength);
-    // Sum up total value
-    totalValue += transfer.getValue();
+  //! messages are moved into the builder and only sliced when serializing the transactions
+  Models::BundleBuilder builder(transfers.size());
+  for (const auto& transfer : transfers) {
+    builder.addTransfer(transfer);
   }
+  const auto totalValue = builder.getTotalValue();
 
   // Get inputs if we are sending tokens
   if (totalValue != 0) {
     //  Case 1: user provided inputs
     //  Validate the inputs by calling getBalances
     if (!validateInputs)
-      return addRemainder(seed, inputs, bundle, transfers.back().getTag(), totalValue, remainder,
-                          signatureFragments);
+      return addRemainder(seed, inputs, builder, transfers.back().getTag(), totalValue, remainder);
     if (!inputs.empty()) {
       const auto balancesResponse =
           getBalances(inputs, GetBalancesRecommandedConfirmationThreshold);
@@ -530,8 +710,8 @@ Extended::prepareTransfers(const Models::Seed& seed, const std::vector<Models::T
         throw Errors::IllegalState("Not enough balance");
       }
 
-      return addRemainder(seed, confirmedInputs, bundle, transfers.back().getTag(), totalValue,
-                          remainder, signatureFragments);
+      return addRemainder(seed, confirmedInputs, builder, transfers.back().getTag(), totalValue,
+                          remainder);
     }
 
     //  Case 2: Get inputs deterministically
@@ -541,20 +721,14 @@ Extended::prepareTransfers(const Models::Seed& seed, const std::vector<Models::T
     else {
       const auto newinputs = getInputs(seed, 0, 0, totalValue);
       // If inputs with enough balance
-      return addRemainder(seed, newinputs.getInputs(), bundle, transfers.back().getTag(),
-                          totalValue, remainder, signatureFragments);
+      return addRemainder(seed, newinputs.getInputs(), builder, transfers.back().getTag(),
+                          totalValue, remainder);
     }
   } else {
     // If no input required, don't sign and simply finalize the bundle
-    bundle.finalize();
-    bundle.addTrytes(signatureFragments);
+    builder.finalize();
 
-    const auto                 trxb = bundle.getTransactions();
-    std::vector<Types::Trytes> bundleTrytes;
-
-    for (const auto& trx : trxb) {
-      bundleTrytes.emplace_back(trx.toTrytes());
-    }
+    auto bundleTrytes = builder.toTrytes();
     std::reverse(bundleTrytes.begin(), bundleTrytes.end());
     return bundleTrytes;
   }
@@ -564,11 +738,17 @@ Responses::GetBundle
 Extended::getBundle(const Types::Trytes& transaction) const {
   const Utils::StopWatch stopWatch;
 
+  Models::Bundle bundle;
+  if (getCachedBundle(transaction, bundle)) {
+    return { bundle.getTransactions(), stopWatch.getElapsedTime().count() };
+  }
+
   //! get bundle hash for transaction
-  const auto bundle = traverseBundle(transaction);
+  bundle = traverseBundle(transaction);
 
   //! verify bundle integrity
   verifyBundle(bundle);
+  cacheBundle(transaction, bundle);
 
   return { bundle.getTransactions(), stopWatch.getElapsedTime().count() };
 }
@@ -581,6 +761,9 @@ Extended::verifyBundle(const Models::Bundle& bundle) {
   //! init curl
   Crypto::Kerl k;
 
+  //! bundle essence buffer reused across transactions
+  Types::Trytes essence(BundleEssenceLength, '9');
+
   std::vector<Models::Signature> signaturesToValidate;
   for (std::size_t i = 0; i < bundle.getTransactions().size(); ++i) {
     const auto& trx = bundle[i];
@@ -594,7 +777,8 @@ Extended::verifyBundle(const Models::Bundle& bundle) {
     totalSum += trxValue;
 
     //! Absorb bundle hash + value + timestamp + lastIndex + currentIndex trytes.
-    k.absorb(Types::trytesToBytes(trx.toTrytes().substr(2187, 162)));
+    trx.bundleEssenceToTrytes(&essence[0]);
+    k.absorb(Types::trytesToBytes(essence));
 
     //! if transaction has some value, we can processs next transactions
     if (trxValue >= 0) {
@@ -675,25 +859,30 @@ Extended::sendTransfer(const Models::Seed& seed, int depth, int minWeightMagnitu
   const auto trytes = prepareTransfers(seed, transfers, remainder, inputs);
   const auto trxs   = sendTrytes(trytes, depth, minWeightMagnitude, reference);
 
-  std::vector<bool> successful;
-
-  for (const auto& trx : trxs) {
-    auto response = findTransactionsByBundles({ trx.getBundle() });
-    successful.push_back(!response.getHashes().empty());
+  if (trxs.empty()) {
+    return { {}, stopWatch.getElapsedTime().count() };
   }
 
-  return { successful, stopWatch.getElapsedTime().count() };
+  //! all the transactions share the bundle hash: check it once for the whole bundle
+  const bool found = !findTransactionsByBundles({ trxs.front().getBundle() }).getHashes().empty();
+
+  return { std::vector<bool>(trxs.size(), found), stopWatch.getElapsedTime().count() };
 }
 
 std::vector<Models::Transaction>
 Extended::sendTrytes(const std::vector<Types::Trytes>& trytes, const unsigned int& depth,
                      const unsigned int& minWeightMagnitude, const Types::Trytes& reference) const {
-  // Get branch and trunk
-  const auto tta = getTransactionsToApprove(depth, reference);
+  // Get branch and trunk, prefetched if possible
+  TipPool::Tips tips;
+
+  if (!reference.empty() || !tipPool_ || !tipPool_->take(depth, tips)) {
+    const auto tta = getTransactionsToApprove(depth, reference);
+    tips.trunk     = tta.getTrunkTransaction();
+    tips.branch    = tta.getBranchTransaction();
+  }
 
   // Attach to tangle, do pow
-  const auto res = attachToTangle(tta.getTrunkTransaction(), tta.getBranchTransaction(),
-                                  minWeightMagnitude, trytes);
+  const auto res = attachToTangle(tips.trunk, tips.branch, minWeightMagnitude, trytes);
 
   broadcastAndStore(res.getTrytes());
 
@@ -706,10 +895,28 @@ Extended::sendTrytes(const std::vector<Types::Trytes>& trytes, const unsigned in
   return trx;
 }
 
+std::future<std::vector<Models::Transaction>>
+Extended::sendTrytesAsync(const std::vector<Types::Trytes>& trytes, const unsigned int& depth,
+                          const unsigned int&  minWeightMagnitude,
+                          const Types::Trytes& reference) const {
+  auto depthCopy = depth;
+  auto mwmCopy   = minWeightMagnitude;
+
+  return async(*this, [trytes, depthCopy, mwmCopy, reference](const Extended& api) {
+    return api.sendTrytes(trytes, depthCopy, mwmCopy, reference);
+  });
+}
+
 Responses::Base
 Extended::broadcastAndStore(const std::vector<Types::Trytes>& trytes) const {
-  broadcastTransactions(trytes);
-  return storeTransactions(trytes);
+  //! broadcast and store are independent: run them concurrently
+  auto broadcast =
+      std::async(std::launch::async, [this, &trytes]() { broadcastTransactions(trytes); });
+
+  auto res = storeTransactions(trytes);
+
+  broadcast.get();
+  return res;
 }
 
 Responses::FindTransactions
@@ -768,40 +975,41 @@ Extended::addRemainder(const Models::Seed& seed, const std::vector<Models::Addre
                        Models::Bundle& bundle, const Models::Tag& tag, int64_t totalValue,
                        const Models::Address&            remainderAddress,
                        const std::vector<Types::Trytes>& signatureFragments) const {
+  Models::BundleBuilder builder(bundle, signatureFragments);
+
+  auto bundleTrytes = addRemainder(seed, inputs, builder, tag, totalValue, remainderAddress);
+  bundle            = std::move(builder.getBundle());
+  return bundleTrytes;
+}
+
+std::vector<Types::Trytes>
+Extended::addRemainder(const Models::Seed& seed, const std::vector<Models::Address>& inputs,
+                       Models::BundleBuilder& builder, const Models::Tag& tag, int64_t totalValue,
+                       const Models::Address& remainderAddress) const {
   for (const auto& input : inputs) {
-    auto    thisBalance = input.getBalance();
-    auto    toSubtract  = -thisBalance;
-    int64_t timestamp   = Utils::StopWatch::now().count();
     // Add input as bundle entry
-    bundle.addTransaction({ input, toSubtract, tag, timestamp }, input.getSecurity());
-    // If there is a remainder value
-    // Add extra output to send remaining funds to
-    if (thisBalance >= totalValue) {
-      auto remainder = thisBalance - totalValue;
-      // If user has provided remainder address
-      // Use it to send remaining funds to
-      if (remainder > 0 && !remainderAddress.empty()) {
-        // Remainder bundle entry
-        bundle.addTransaction({ remainderAddress, remainder, tag, timestamp });
-        // Final function for signing inputs
-        return Crypto::Signing::signInputs(seed, inputs, bundle, signatureFragments);
-      } else if (remainder > 0) {
-        // Generate a new Address by calling getNewAddress
-        auto res = getNewAddresses(seed, 0, 0, false);
-        // Remainder bundle entry
-        bundle.addTransaction({ res.getAddresses()[0], remainder, tag, timestamp });
-        // Final function for signing inputs
-        return Crypto::Signing::signInputs(seed, inputs, bundle, signatureFragments);
-      } else {
-        // If there is no remainder, do not add transaction to bundle
-        // simply sign and return
-        return Crypto::Signing::signInputs(seed, inputs, bundle, signatureFragments);
-      }
-      // If multiple inputs provided, subtract the totalValue by
-      // the inputs balance
-    } else {
-      totalValue -= thisBalance;
+    builder.addInput(input, tag);
+
+    // If multiple inputs provided, subtract the totalValue by
+    // the inputs balance
+    if (input.getBalance() < totalValue) {
+      totalValue -= input.getBalance();
+      continue;
+    }
+
+    // If there is a remainder value, add extra output to send remaining funds to: either the
+    // remainder address provided by the user, or a new address
+    const auto remainder = input.getBalance() - totalValue;
+    if (remainder > 0 && !remainderAddress.empty()) {
+      builder.addOutput(remainderAddress, remainder, tag);
+    } else if (remainder > 0) {
+      builder.addOutput(getNewAddresses(seed, 0, 0, false).getAddresses()[0], remainder, tag);
     }
+
+    // Final function for signing inputs
+    builder.finalize();
+    Crypto::Signing::signBundle(seed, inputs, builder.getBundle());
+    return builder.toTrytes();
   }
   throw Errors::IllegalState("Not enough balance");
 }
@@ -810,22 +1018,30 @@ Responses::ReplayBundle
 Extended::replayBundle(const Types::Trytes& transaction, int depth, int minWeightMagnitude) const {
   const Utils::StopWatch stopWatch;
 
-  auto bundleResponse = getBundle(transaction);
+  const auto trxs = reattachBundle(transaction, depth, minWeightMagnitude);
 
-  std::vector<Types::Trytes> bundleTrytes;
-  for (const auto& trx : bundleResponse.getTransactions()) {
-    bundleTrytes.emplace_back(trx.toTrytes());
+  if (trxs.empty()) {
+    return { {}, stopWatch.getElapsedTime().count() };
   }
 
-  const auto trxs = sendTrytes(bundleTrytes, depth, minWeightMagnitude);
+  //! all the transactions share the bundle hash: check it once for the whole bundle
+  const bool found = !findTransactionsByBundles({ trxs.front().getBundle() }).getHashes().empty();
 
-  std::vector<bool> successful;
-  for (const auto& trx : trxs) {
-    auto response = findTransactionsByBundles({ trx.getBundle() });
-    successful.push_back(!response.getHashes().empty());
+  return { std::vector<bool>(trxs.size(), found), stopWatch.getElapsedTime().count() };
+}
+
+std::vector<Models::Transaction>
+Extended::reattachBundle(const Types::Trytes& tail, int depth, int minWeightMagnitude) const {
+  auto bundleResponse = getBundle(tail);
+
+  std::vector<Types::Trytes> bundleTrytes;
+  bundleTrytes.reserve(bundleResponse.getTransactions().size());
+  for (const auto& trx : bundleResponse.getTransactions()) {
+    bundleTrytes.emplace_back(TrxTrytesLength, '9');
+    trx.toTrytes(&bundleTrytes.back()[0]);
   }
 
-  return { successful, stopWatch.getElapsedTime().count() };
+  return sendTrytes(bundleTrytes, depth, minWeightMagnitude);
 }
 
 std::vector<Models::Transaction>
@@ -842,54 +1058,12 @@ Extended::initiateTransfer(const Models::Address&               inputAddress,
     throw Errors::IllegalState("Invalid transfer");
   }
 
-  //! Create a new bundle
-  Models::Bundle             bundle;
-  int64_t                    totalValue = 0;
-  std::vector<Types::Trytes> signatureFragments;
-
-  //! Iterate over all transfers, get totalValue
-  //! and prepare the signatureFragments, message and tag
+  //! Create a new bundle: messages are sliced straight into the signature message fragments
+  Models::BundleBuilder builder(transfers.size());
   for (const auto& transfer : transfers) {
-    int signatureMessageLength = 1;
-
-    //! If message longer than 2187 trytes, increase signatureMessageLength (add 2nd transaction)
-    if (transfer.getMessage().length() > MaxTrxMsgLength) {
-      //! Get total length, message / maxLength (MaxTrxMsgLength trytes)
-      signatureMessageLength += (int)std::floor(transfer.getMessage().length() / MaxTrxMsgLength);
-
-      //! copy msg
-      Types::Trytes msgCopy = transfer.getMessage();
-
-      //! While there is still a message, copy it
-      while (!msgCopy.empty()) {
-        Types::Trytes fragment = msgCopy.substr(0, MaxTrxMsgLength);
-
-        if (msgCopy.length() > MaxTrxMsgLength) {
-          msgCopy = msgCopy.substr(MaxTrxMsgLength, msgCopy.length());
-        } else {
-          msgCopy = "";
-        }
-
-        // Pad remainder of fragment
-        signatureFragments.push_back(Types::Utils::rightPad(fragment, MaxTrxMsgLength, '9'));
-      }
-    } else {
-      //! Else, get single fragment with MaxTrxMsgLength of 9's trytes
-      signatureFragments.push_back(
-          Types::Utils::rightPad(transfer.getMessage(), MaxTrxMsgLength, '9'));
-    }
-
-    //! get current timestamp in seconds
-    int64_t timestamp = Utils::StopWatch::now().count();
-
-    //! Add first entry to the bundle
-    bundle.addTransaction(
-        { transfer.getAddress(), transfer.getValue(), transfer.getTag(), timestamp },
-        signatureMessageLength);
-
-    //! Sum up total value
-    totalValue += transfer.getValue();
+    builder.addTransfer(transfer);
   }
+  const auto totalValue = builder.getTotalValue();
 
   //! Get inputs if we are sending tokens
   if (totalValue == 0) {
@@ -904,16 +1078,13 @@ Extended::initiateTransfer(const Models::Address&               inputAddress,
     totalBalance += std::atol(balance.c_str());
   }
 
-  // get current timestamp in seconds
-  int64_t timestamp = Utils::StopWatch::now().count();
-
   if (totalBalance > 0) {
-    long toSubtract = -totalBalance;
+    auto input = inputAddress;
+    input.setBalance(totalBalance);
 
     //! Add input as bundle entry
     //! Only a single entry, signatures will be added later
-    bundle.addTransaction({ inputAddress, toSubtract, transfers.back().getTag(), timestamp },
-                          inputAddress.getSecurity());
+    builder.addInput(input, transfers.back().getTag());
   }
 
   //! Return not enough balance error
@@ -931,13 +1102,13 @@ Extended::initiateTransfer(const Models::Address&               inputAddress,
       throw Errors::IllegalState("No remainder address defined");
     }
 
-    bundle.addTransaction({ remainderAddress, remainder, transfers.back().getTag(), timestamp });
+    builder.addOutput(remainderAddress, remainder, transfers.back().getTag());
   }
 
-  bundle.finalize();
-  bundle.addTrytes(signatureFragments);
+  builder.finalize();
+  builder.applyMessages();
 
-  return bundle.getTransactions();
+  return builder.getBundle().getTransactions();
 }
 
 bool
@@ -966,28 +1137,153 @@ Extended::promoteTransaction(const Types::Trytes& tail, int depth, int minWeight
     throw Errors::IllegalState("Inconsistent subtangle");
   }
 
-  if (interrupt()) {
-    return {};
-  }
+  //! promote until interrupted, one promotion per delay
+  for (;;) {
+    if (interrupt()) {
+      return {};
+    }
+
+    auto res = sendTransfer(transfers[0].getAddress().toTrytes(), depth, minWeightMagnitude,
+                            transfers, {}, {}, tail);
+    if (delay <= 0) {
+      return res;
+    }
 
-  auto res = sendTransfer(transfers[0].getAddress().toTrytes(), depth, minWeightMagnitude,
-                          transfers, {}, {}, tail);
-  if (delay > 0) {
     std::this_thread::sleep_for(std::chrono::milliseconds(delay));
-    return promoteTransaction(tail, depth, minWeightMagnitude, transfers, delay, interrupt);
+
+    if (!isPromotable(tail)) {
+      throw Errors::IllegalState("Inconsistent subtangle");
+    }
+  }
+}
+
+void
+Extended::enableBundleCache(std::size_t capacity) {
+  if (capacity == 0) {
+    bundleCache_.reset();
+  } else {
+    bundleCache_ = std::make_shared<BundleCache>(capacity);
+  }
+}
+
+const std::shared_ptr<Extended::BundleCache>&
+Extended::getBundleCache() const {
+  return bundleCache_;
+}
+
+void
+Extended::setWholeBundleFetch(bool enabled) {
+  wholeBundleFetch_ = enabled;
+}
+
+bool
+Extended::getWholeBundleFetch() const {
+  return wholeBundleFetch_;
+}
+
+void
+Extended::enableTipPool(std::size_t poolSize, int64_t maxAge) {
+  if (poolSize == 0) {
+    tipPool_.reset();
+  } else {
+    //! the pool copies the core part of this object, so it may outlive it along with the copies
+    tipPool_ = std::make_shared<TipPool>(*this, poolSize, maxAge);
+  }
+}
+
+const std::shared_ptr<TipPool>&
+Extended::getTipPool() const {
+  return tipPool_;
+}
+
+void
+Extended::setMilestoneRefreshInterval(int64_t interval) {
+  milestoneRefreshInterval_ = interval;
+}
+
+int64_t
+Extended::getMilestoneRefreshInterval() const {
+  return milestoneRefreshInterval_;
+}
+
+const Extended::ConfirmedTailsCache&
+Extended::getConfirmedTails() const {
+  return inclusionCache_->confirmedTails;
+}
+
+void
+Extended::setSpentAddressStore(const std::shared_ptr<SpentAddressStore>& store) {
+  spentAddresses_ = store;
+}
+
+const std::shared_ptr<SpentAddressStore>&
+Extended::getSpentAddressStore() const {
+  return spentAddresses_;
+}
+
+std::vector<bool>
+Extended::getSpentStates(const std::vector<Models::Address>& addresses) const {
+  std::vector<bool> states(addresses.size(), false);
+
+  //! only ask the node about the addresses not known to be spent
+  std::vector<Models::Address> unknown;
+  std::vector<std::size_t>     unknownIndexes;
+  for (std::size_t i = 0; i < addresses.size(); ++i) {
+    if (spentAddresses_ && spentAddresses_->contains(addresses[i].toTrytes())) {
+      states[i] = true;
+    } else {
+      unknown.push_back(addresses[i]);
+      unknownIndexes.push_back(i);
+    }
+  }
+
+  if (unknown.empty()) {
+    return states;
+  }
+
+  const auto  res   = wereAddressesSpentFrom(unknown);
+  const auto& spent = res.getStates();
+  if (spent.size() != unknown.size()) {
+    throw Errors::IllegalState("Unexpected number of spent states");
+  }
+
+  std::vector<Types::Trytes> newlySpent;
+  for (std::size_t i = 0; i < unknown.size(); ++i) {
+    if (spent[i]) {
+      states[unknownIndexes[i]] = true;
+      newlySpent.push_back(unknown[i].toTrytes());
+    }
+  }
+
+  if (spentAddresses_ && !newlySpent.empty()) {
+    spentAddresses_->add(newlySpent);
+  }
+
+  return states;
+}
+
+bool
+Extended::getCachedBundle(const Types::Trytes& tail, Models::Bundle& bundle) const {
+  return bundleCache_ && isCacheableHash(tail) && bundleCache_->get(tail, bundle);
+}
+
+void
+Extended::cacheBundle(const Types::Trytes& tail, const Models::Bundle& bundle) const {
+  if (bundleCache_ && isCacheableHash(tail)) {
+    bundleCache_->put(tail, bundle);
   }
-  return res;
 }
 
 std::vector<bool>
 Extended::isReattachable(const std::vector<Models::Address>& addresses) {
-  std::map<Types::Trytes, std::vector<Types::Trytes>> addressTxsMap;
-  std::vector<Types::Trytes>                          valueTransactions;
+  //! index in valueTransactions of the spending transactions of each address
+  std::unordered_map<Types::Hash, std::vector<std::size_t>> addressTxsMap;
+  std::vector<Types::Trytes>                                valueTransactions;
 
   auto trxs = findTransactionObjects(addresses);
   for (const auto& trx : trxs) {
     if (trx.getValue() < 0) {
-      addressTxsMap[trx.getAddress().toTrytes()].push_back(trx.getHash());
+      addressTxsMap[trx.getAddress().toTrytes()].push_back(valueTransactions.size());
       valueTransactions.push_back(trx.getHash());
     }
   }
@@ -1006,10 +1302,7 @@ Extended::isReattachable(const std::vector<Models::Address>& addresses) {
       }
 
       bool shouldReattach = true;
-      for (const auto& trx : trxs) {
-        auto txIndex =
-            std::distance(valueTransactions.begin(),
-                          std::find(valueTransactions.begin(), valueTransactions.end(), trx));
+      for (const auto& txIndex : trxs) {
         auto isConfirmed = inclusionStates.getStates()[txIndex];
 
         //! if tx confirmed, break
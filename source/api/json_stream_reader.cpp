@@ -0,0 +1,322 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <cctype>
+
+#include <iota/api/json_stream_reader.hpp>
+#include <iota/errors/unrecognized.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+static bool
+isSpace(char c) {
+  return c == ' ' || c == '\n' || c == '\r' || c == '\t';
+}
+
+static bool
+isScalarChar(char c) {
+  return std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '+' || c == '.';
+}
+
+static int
+hexValue(char c) {
+  if (c >= '0' && c <= '9') {
+    return c - '0';
+  }
+
+  if (c >= 'a' && c <= 'f') {
+    return c - 'a' + 10;
+  }
+
+  if (c >= 'A' && c <= 'F') {
+    return c - 'A' + 10;
+  }
+
+  return -1;
+}
+
+static void
+appendUtf8(std::string& str, unsigned int codePoint) {
+  if (codePoint < 0x80) {
+    str.push_back(static_cast<char>(codePoint));
+  } else if (codePoint < 0x800) {
+    str.push_back(static_cast<char>(0xC0 | (codePoint >> 6)));
+    str.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  } else {
+    str.push_back(static_cast<char>(0xE0 | (codePoint >> 12)));
+    str.push_back(static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F)));
+    str.push_back(static_cast<char>(0x80 | (codePoint & 0x3F)));
+  }
+}
+
+JsonStreamReader::JsonStreamReader(const Handler& handler)
+    : handler_(handler),
+      state_(State::ObjectStart),
+      inArray_(false),
+      escape_(false),
+      unicodeDigits_(0),
+      unicode_(0),
+      depth_(0),
+      skipInString_(false) {
+}
+
+void
+JsonStreamReader::feed(const char* data, std::size_t size) {
+  for (std::size_t i = 0; i < size;) {
+    if (step(data[i])) {
+      ++i;
+    }
+  }
+}
+
+void
+JsonStreamReader::finish() const {
+  if (state_ != State::Done) {
+    throw Errors::Unrecognized("Incomplete json object");
+  }
+}
+
+bool
+JsonStreamReader::step(char c) {
+  switch (state_) {
+    case State::ObjectStart:
+      if (!isSpace(c)) {
+        if (c != '{') {
+          unexpected(c);
+        }
+
+        state_ = State::KeyOrEnd;
+      }
+      return true;
+
+    case State::KeyOrEnd:
+      if (c == '}') {
+        state_ = State::Done;
+      } else if (c == '"') {
+        token_.clear();
+        state_ = State::Key;
+      } else if (!isSpace(c)) {
+        unexpected(c);
+      }
+      return true;
+
+    case State::Key:
+      if (readString(c)) {
+        field_ = std::move(token_);
+        token_.clear();
+        state_ = State::Colon;
+      }
+      return true;
+
+    case State::Colon:
+      if (c == ':') {
+        state_ = State::Value;
+      } else if (!isSpace(c)) {
+        unexpected(c);
+      }
+      return true;
+
+    case State::Value:
+      if (c == '[') {
+        inArray_ = true;
+        state_   = State::ElementOrEnd;
+      } else if (!isSpace(c)) {
+        inArray_ = false;
+        startValue(c);
+      }
+      return true;
+
+    case State::ElementOrEnd:
+      if (c == ']') {
+        inArray_ = false;
+        state_   = State::AfterValue;
+      } else if (!isSpace(c)) {
+        startValue(c);
+      }
+      return true;
+
+    case State::String:
+      if (readString(c)) {
+        endValue();
+      }
+      return true;
+
+    case State::Scalar:
+      if (isScalarChar(c)) {
+        token_.push_back(c);
+        return true;
+      }
+
+      //! the character ending a scalar belongs to the next state
+      endValue();
+      return false;
+
+    case State::Skip:
+      if (skipInString_) {
+        if (escape_) {
+          escape_ = false;
+        } else if (c == '\\') {
+          escape_ = true;
+        } else if (c == '"') {
+          skipInString_ = false;
+        }
+      } else if (c == '"') {
+        skipInString_ = true;
+      } else if (c == '{' || c == '[') {
+        ++depth_;
+      } else if ((c == '}' || c == ']') && --depth_ == 0) {
+        state_ = inArray_ ? State::AfterElement : State::AfterValue;
+      }
+      return true;
+
+    case State::AfterValue:
+      if (c == ',') {
+        state_ = State::KeyOrEnd;
+      } else if (c == '}') {
+        state_ = State::Done;
+      } else if (!isSpace(c)) {
+        unexpected(c);
+      }
+      return true;
+
+    case State::AfterElement:
+      if (c == ',') {
+        state_ = State::ElementOrEnd;
+      } else if (c == ']') {
+        inArray_ = false;
+        state_   = State::AfterValue;
+      } else if (!isSpace(c)) {
+        unexpected(c);
+      }
+      return true;
+
+    case State::Done:
+      if (!isSpace(c)) {
+        unexpected(c);
+      }
+      return true;
+  }
+
+  return true;
+}
+
+bool
+JsonStreamReader::readString(char c) {
+  if (unicodeDigits_ > 0) {
+    auto digit = hexValue(c);
+    if (digit < 0) {
+      unexpected(c);
+    }
+
+    unicode_ = unicode_ * 16 + digit;
+    if (--unicodeDigits_ == 0) {
+      appendUtf8(token_, unicode_);
+    }
+    return false;
+  }
+
+  if (escape_) {
+    escape_ = false;
+
+    switch (c) {
+      case '"':
+      case '\\':
+      case '/':
+        token_.push_back(c);
+        break;
+      case 'b':
+        token_.push_back('\b');
+        break;
+      case 'f':
+        token_.push_back('\f');
+        break;
+      case 'n':
+        token_.push_back('\n');
+        break;
+      case 'r':
+        token_.push_back('\r');
+        break;
+      case 't':
+        token_.push_back('\t');
+        break;
+      case 'u':
+        unicodeDigits_ = 4;
+        unicode_       = 0;
+        break;
+      default:
+        unexpected(c);
+    }
+    return false;
+  }
+
+  if (c == '\\') {
+    escape_ = true;
+    return false;
+  }
+
+  if (c == '"') {
+    return true;
+  }
+
+  token_.push_back(c);
+  return false;
+}
+
+void
+JsonStreamReader::startValue(char c) {
+  token_.clear();
+
+  if (c == '"') {
+    state_ = State::String;
+  } else if (c == '{' || c == '[') {
+    depth_        = 1;
+    skipInString_ = false;
+    escape_       = false;
+    state_        = State::Skip;
+  } else if (isScalarChar(c)) {
+    token_.push_back(c);
+    state_ = State::Scalar;
+  } else {
+    unexpected(c);
+  }
+}
+
+void
+JsonStreamReader::endValue() {
+  handler_(field_, std::move(token_));
+  token_.clear();
+  state_ = inArray_ ? State::AfterElement : State::AfterValue;
+}
+
+void
+JsonStreamReader::unexpected(char c) const {
+  throw Errors::Unrecognized(std::string("Unexpected character in json: ") + c);
+}
+
+}  // namespace API
+
+}  // namespace IOTA
@@ -0,0 +1,165 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <cstring>
+
+#include <iota/api/json_writer.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+static bool
+needsEscape(char c) {
+  return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20;
+}
+
+JsonWriter::JsonWriter(std::string& buffer) : buffer_(buffer), afterKey_(false) {
+}
+
+void
+JsonWriter::beginObject() {
+  separate();
+  buffer_.push_back('{');
+  empty_.push_back(true);
+}
+
+void
+JsonWriter::endObject() {
+  buffer_.push_back('}');
+  empty_.pop_back();
+}
+
+void
+JsonWriter::beginArray() {
+  separate();
+  buffer_.push_back('[');
+  empty_.push_back(true);
+}
+
+void
+JsonWriter::endArray() {
+  buffer_.push_back(']');
+  empty_.pop_back();
+}
+
+void
+JsonWriter::key(const std::string& name) {
+  separate();
+  writeString(name.data(), name.size());
+  buffer_.push_back(':');
+  afterKey_ = true;
+}
+
+void
+JsonWriter::value(const std::string& str) {
+  separate();
+  writeString(str.data(), str.size());
+}
+
+void
+JsonWriter::value(const char* str) {
+  separate();
+  writeString(str, std::strlen(str));
+}
+
+void
+JsonWriter::value(int64_t number) {
+  separate();
+  buffer_ += std::to_string(number);
+}
+
+void
+JsonWriter::value(int number) {
+  value(static_cast<int64_t>(number));
+}
+
+void
+JsonWriter::value(bool boolean) {
+  separate();
+  buffer_ += boolean ? "true" : "false";
+}
+
+void
+JsonWriter::separate() {
+  if (afterKey_) {
+    afterKey_ = false;
+    return;
+  }
+
+  if (!empty_.empty()) {
+    if (!empty_.back()) {
+      buffer_.push_back(',');
+    }
+    empty_.back() = false;
+  }
+}
+
+void
+JsonWriter::writeString(const char* str, std::size_t length) {
+  static const char* hex = "0123456789abcdef";
+
+  buffer_.push_back('"');
+
+  //! copy runs of characters that need no escaping at once, trytes are a single run
+  std::size_t start = 0;
+  for (std::size_t i = 0; i < length; ++i) {
+    if (!needsEscape(str[i])) {
+      continue;
+    }
+
+    buffer_.append(str + start, i - start);
+    start = i + 1;
+
+    switch (str[i]) {
+      case '"':
+        buffer_ += "\\\"";
+        break;
+      case '\\':
+        buffer_ += "\\\\";
+        break;
+      case '\n':
+        buffer_ += "\\n";
+        break;
+      case '\r':
+        buffer_ += "\\r";
+        break;
+      case '\t':
+        buffer_ += "\\t";
+        break;
+      default:
+        buffer_ += "\\u00";
+        buffer_.push_back(hex[(str[i] >> 4) & 0xF]);
+        buffer_.push_back(hex[str[i] & 0xF]);
+    }
+  }
+
+  buffer_.append(str + start, length - start);
+  buffer_.push_back('"');
+}
+
+}  // namespace API
+
+}  // namespace IOTA
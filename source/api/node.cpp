@@ -0,0 +1,174 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <algorithm>
+
+#include <iota/api/node.hpp>
+#include <iota/constants.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+constexpr std::size_t          Node::LatencyWindow;
+constexpr unsigned int         Node::MaxFailures;
+constexpr std::chrono::seconds Node::RetryDelay;
+
+//! weight of a new sample in the moving average
+static const double LatencySmoothing = 0.2;
+
+Node::Node(const std::string& url, int timeout, const std::string& user, const std::string& pass,
+           std::size_t maxIdle)
+    : url_(url),
+      sessions_(url, timeout, user, pass, maxIdle),
+      latency_(0),
+      failures_(0) {
+}
+
+cpr::Response
+Node::post(std::string body, const std::string& command) {
+  auto headers = cpr::Header{ { "Content-Type", "application/json" },
+                              { "Content-Length", std::to_string(body.size()) },
+                              { "Connection", "keep-alive" },
+                              { "X-IOTA-API-Version", APIVersion } };
+
+  auto session = sessions_.acquire();
+  session->SetHeader(headers);
+  session->SetBody(cpr::Body{ std::move(body) });
+
+  auto start = std::chrono::steady_clock::now();
+  auto res   = session->Post();
+
+  //! a session whose connection failed is dropped rather than reused
+  if (res.error.code == cpr::ErrorCode::OK && res.status_code < 500) {
+    recordSuccess(std::chrono::duration_cast<std::chrono::milliseconds>(
+                      std::chrono::steady_clock::now() - start),
+                  command);
+    sessions_.release(std::move(session));
+  } else {
+    recordFailure();
+  }
+
+  return res;
+}
+
+const std::string&
+Node::getUrl() const {
+  return url_;
+}
+
+SessionPool&
+Node::getSessionPool() {
+  return sessions_;
+}
+
+void
+Node::Window::add(double sample) {
+  if (samples.size() < LatencyWindow) {
+    samples.push_back(sample);
+  } else {
+    samples[count % LatencyWindow] = sample;
+  }
+
+  ++count;
+}
+
+void
+Node::recordSuccess(std::chrono::milliseconds latency, const std::string& command) {
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  double sample = static_cast<double>(latency.count());
+  auto&  all    = windows_[""];
+  latency_      = all.count == 0 ? sample : latency_ + LatencySmoothing * (sample - latency_);
+
+  all.add(sample);
+  if (!command.empty()) {
+    windows_[command].add(sample);
+  }
+
+  failures_ = 0;
+}
+
+void
+Node::recordFailure() {
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  ++failures_;
+  lastFailure_ = std::chrono::steady_clock::now();
+}
+
+bool
+Node::isHealthy() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  return failures_ < MaxFailures || std::chrono::steady_clock::now() - lastFailure_ >= RetryDelay;
+}
+
+double
+Node::getLatency() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return latency_;
+}
+
+double
+Node::getLatencyPercentile(double percentile, const std::string& command) const {
+  std::vector<double> sorted;
+
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    auto window = windows_.find(command);
+    if (window != windows_.end()) {
+      sorted = window->second.samples;
+    }
+  }
+
+  if (sorted.empty()) {
+    return 0;
+  }
+
+  auto rank = static_cast<std::size_t>(percentile * (sorted.size() - 1) + 0.5);
+  rank      = std::min(rank, sorted.size() - 1);
+  std::nth_element(sorted.begin(), sorted.begin() + rank, sorted.end());
+  return sorted[rank];
+}
+
+std::size_t
+Node::getSamples(const std::string& command) const {
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  auto window = windows_.find(command);
+  return window != windows_.end() ? window->second.count : 0;
+}
+
+unsigned int
+Node::getFailures() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return failures_;
+}
+
+}  // namespace API
+
+}  // namespace IOTA
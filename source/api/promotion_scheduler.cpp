@@ -0,0 +1,329 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <algorithm>
+
+#include <iota/api/promotion_scheduler.hpp>
+#include <iota/api/responses/check_consistency.hpp>
+#include <iota/api/responses/get_inclusion_states.hpp>
+#include <iota/api/responses/send_transfer.hpp>
+#include <iota/errors/bad_request.hpp>
+#include <iota/models/seed.hpp>
+#include <iota/models/transaction.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+constexpr int64_t     PromotionScheduler::DefaultInterval;
+constexpr std::size_t PromotionScheduler::DefaultMaxPow;
+constexpr int64_t     PromotionScheduler::Tick;
+constexpr std::size_t PromotionScheduler::WheelSlots;
+
+PromotionScheduler::PromotionScheduler(const Extended& api, const Models::Transfer& promotion,
+                                       int depth, int minWeightMagnitude, int64_t interval,
+                                       std::size_t maxPow)
+    : api_(api),
+      promotion_({ promotion }),
+      depth_(depth),
+      minWeightMagnitude_(minWeightMagnitude),
+      interval_(interval),
+      wheel_(WheelSlots, std::chrono::milliseconds(Tick)),
+      timers_(0),
+      promotions_(0),
+      reattachments_(0),
+      stop_(false),
+      pow_(maxPow),
+      thread_(&PromotionScheduler::run, this) {
+}
+
+PromotionScheduler::~PromotionScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    stop_ = true;
+  }
+
+  cv_.notify_one();
+  thread_.join();
+}
+
+void
+PromotionScheduler::track(const Types::Trytes& tail) {
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  Pending pending;
+  pending.tails.push_back(tail);
+
+  if (pending_.emplace(tail, std::move(pending)).second) {
+    schedule(tail);
+  }
+}
+
+void
+PromotionScheduler::untrack(const Types::Trytes& tail) {
+  //! the timer of the bundle is left on the wheel, and ignored when it expires, even if the tail
+  //! is tracked again in the meantime
+  std::lock_guard<std::mutex> lock(mtx_);
+  pending_.erase(tail);
+}
+
+void
+PromotionScheduler::setOnConfirmed(const Callback& callback) {
+  std::lock_guard<std::mutex> lock(mtx_);
+  onConfirmed_ = callback;
+}
+
+std::size_t
+PromotionScheduler::getPending() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return pending_.size();
+}
+
+std::size_t
+PromotionScheduler::getPromotions() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return promotions_;
+}
+
+std::size_t
+PromotionScheduler::getReattachments() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return reattachments_;
+}
+
+void
+PromotionScheduler::run() {
+  std::unique_lock<std::mutex> lock(mtx_);
+  auto                         next = std::chrono::steady_clock::now() + wheel_.tick();
+
+  while (!cv_.wait_until(lock, next, [this] { return stop_; })) {
+    //! ticks missed while processing are caught up right away
+    next += wheel_.tick();
+
+    const auto due = wheel_.advance();
+    if (due.empty()) {
+      continue;
+    }
+
+    lock.unlock();
+    process(due);
+    lock.lock();
+  }
+}
+
+void
+PromotionScheduler::process(const std::vector<Timer>& due) {
+  //! bundles still tracked, and all their tails
+  std::vector<Types::Trytes> ids;
+  std::vector<Types::Trytes> tails;
+  std::vector<std::size_t>   owners;
+
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    for (const auto& timer : due) {
+      auto it = pending_.find(timer.first);
+      if (it == pending_.end() || it->second.timer != timer.second || it->second.busy) {
+        continue;
+      }
+
+      for (const auto& tail : it->second.tails) {
+        tails.push_back(tail);
+        owners.push_back(ids.size());
+      }
+      ids.push_back(timer.first);
+    }
+  }
+
+  if (ids.empty()) {
+    return;
+  }
+
+  //! a bundle is confirmed as soon as one of its attachments is
+  std::vector<bool> confirmed(ids.size(), false);
+  std::vector<bool> promotable;
+
+  std::vector<Types::Trytes> latest;
+  std::vector<std::size_t>   latestOwners;
+  std::vector<Types::Trytes> done;
+  Callback                   callback;
+
+  try {
+    const auto states = api_.getLatestInclusion(tails).getStates();
+
+    for (std::size_t i = 0; i < states.size() && i < owners.size(); ++i) {
+      if (states[i]) {
+        confirmed[owners[i]] = true;
+      }
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      callback = onConfirmed_;
+
+      for (std::size_t i = 0; i < ids.size(); ++i) {
+        auto it = pending_.find(ids[i]);
+        if (it == pending_.end()) {
+          continue;
+        }
+
+        if (confirmed[i]) {
+          pending_.erase(it);
+          done.push_back(ids[i]);
+        } else {
+          latest.push_back(it->second.tails.back());
+          latestOwners.push_back(i);
+        }
+      }
+    }
+
+    promotable.assign(latest.size(), false);
+    checkConsistency(latest, 0, latest.size(), promotable);
+  } catch (const std::exception&) {
+    //! node unavailable: check again on the next interval
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    for (const auto& id : ids) {
+      if (pending_.count(id)) {
+        schedule(id);
+      }
+    }
+    return;
+  }
+
+  if (callback) {
+    for (const auto& id : done) {
+      callback(id);
+    }
+  }
+
+  for (std::size_t i = 0; i < latest.size(); ++i) {
+    dispatch(ids[latestOwners[i]], latest[i], promotable[i]);
+  }
+}
+
+void
+PromotionScheduler::checkConsistency(const std::vector<Types::Trytes>& tails, std::size_t first,
+                                     std::size_t last, std::vector<bool>& promotable) const {
+  if (first >= last) {
+    return;
+  }
+
+  bool consistent = false;
+
+  try {
+    consistent = api_.checkConsistency({ tails.begin() + first, tails.begin() + last }).getState();
+  } catch (const Errors::BadRequest&) {
+    //! unknown or non-tail transactions in the range
+    consistent = false;
+  }
+
+  if (consistent) {
+    std::fill(promotable.begin() + first, promotable.begin() + last, true);
+    return;
+  }
+
+  //! find out which tails are inconsistent
+  if (last - first > 1) {
+    const auto middle = first + (last - first) / 2;
+    checkConsistency(tails, first, middle, promotable);
+    checkConsistency(tails, middle, last, promotable);
+  }
+}
+
+void
+PromotionScheduler::dispatch(const Types::Trytes& id, const Types::Trytes& tail, bool promote) {
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    auto it = pending_.find(id);
+    if (it == pending_.end()) {
+      return;
+    }
+    it->second.busy = true;
+  }
+
+  pow_.submit([this, id, tail, promote]() {
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      if (stop_) {
+        return;
+      }
+    }
+
+    bool          sent = false;
+    Types::Trytes reattached;
+
+    try {
+      if (promote) {
+        auto transfers = promotion_;
+        api_.sendTransfer(Models::Seed{ transfers[0].getAddress().toTrytes() }, depth_,
+                          minWeightMagnitude_, transfers, {}, {}, tail);
+        sent = true;
+      } else {
+        for (const auto& trx : api_.reattachBundle(tail, depth_, minWeightMagnitude_)) {
+          if (trx.getCurrentIndex() == 0) {
+            reattached = trx.getHash();
+          }
+        }
+        sent = !reattached.empty();
+      }
+    } catch (const std::exception&) {
+      //! tried again on the next check
+    }
+
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    if (sent) {
+      ++(promote ? promotions_ : reattachments_);
+    }
+
+    auto it = pending_.find(id);
+    if (it == pending_.end()) {
+      return;
+    }
+
+    it->second.busy = false;
+    if (!reattached.empty()) {
+      it->second.tails.push_back(reattached);
+    }
+    schedule(id);
+  });
+}
+
+void
+PromotionScheduler::schedule(const Types::Trytes& id) {
+  auto it = pending_.find(id);
+  if (it == pending_.end()) {
+    return;
+  }
+
+  it->second.timer = ++timers_;
+  wheel_.schedule({ id, it->second.timer }, interval_);
+}
+
+}  // namespace API
+
+}  // namespace IOTA
@@ -43,6 +43,12 @@ AddNeighbors::serialize(json& data) const {
   data["uris"] = uris_;
 }
 
+void
+AddNeighbors::serialize(JsonWriter& writer) const {
+  Base::serialize(writer);
+  writer.field("uris", uris_);
+}
+
 }  // namespace Requests
 
 }  // namespace API
@@ -53,6 +53,15 @@ AttachToTangle::serialize(json& data) const {
   data["trytes"]             = trytes_;
 }
 
+void
+AttachToTangle::serialize(JsonWriter& writer) const {
+  Base::serialize(writer);
+  writer.field("trunkTransaction", trunkTransaction_);
+  writer.field("branchTransaction", branchTransaction_);
+  writer.field("minWeightMagnitude", minWeightMagnitude_);
+  writer.field("trytes", trytes_);
+}
+
 }  // namespace Requests
 
 }  // namespace API
@@ -41,6 +41,16 @@ Base::serialize(json& data) const {
   data = json{ { "command", command_ } };
 }
 
+void
+Base::serialize(JsonWriter& writer) const {
+  writer.field("command", command_);
+}
+
+const std::string&
+Base::getCommand() const {
+  return command_;
+}
+
 }  // namespace Requests
 
 }  // namespace API
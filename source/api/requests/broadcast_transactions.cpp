@@ -43,6 +43,12 @@ BroadcastTransactions::serialize(json& data) const {
   data["trytes"] = trytes_;
 }
 
+void
+BroadcastTransactions::serialize(JsonWriter& writer) const {
+  Base::serialize(writer);
+  writer.field("trytes", trytes_);
+}
+
 }  // namespace Requests
 
 }  // namespace API
@@ -43,6 +43,12 @@ CheckConsistency::serialize(json& data) const {
   data["tails"] = tails_;
 }
 
+void
+CheckConsistency::serialize(JsonWriter& writer) const {
+  Base::serialize(writer);
+  writer.field("tails", tails_);
+}
+
 }  // namespace Requests
 
 }  // namespace API
@@ -69,6 +69,37 @@ FindTransactions::serialize(json& data) const {
   }
 }
 
+void
+FindTransactions::serialize(JsonWriter& writer) const {
+  Base::serialize(writer);
+
+  if (!addresses_.empty()) {
+    writer.key("addresses");
+    writer.beginArray();
+    for (auto& address : addresses_) {
+      writer.value(address.toTrytes());
+    }
+    writer.endArray();
+  }
+
+  if (!tags_.empty()) {
+    writer.key("tags");
+    writer.beginArray();
+    for (const auto& tag : tags_) {
+      writer.value(tag.toTrytesWithPadding());
+    }
+    writer.endArray();
+  }
+
+  if (!approvees_.empty()) {
+    writer.field("approvees", approvees_);
+  }
+
+  if (!bundles_.empty()) {
+    writer.field("bundles", bundles_);
+  }
+}
+
 }  // namespace Requests
 
 }  // namespace API
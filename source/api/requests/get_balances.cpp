@@ -51,6 +51,24 @@ GetBalances::serialize(json& data) const {
   }
 }
 
+void
+GetBalances::serialize(JsonWriter& writer) const {
+  Base::serialize(writer);
+
+  if (!addresses_.empty()) {
+    writer.key("addresses");
+    writer.beginArray();
+    for (auto& address : addresses_) {
+      writer.value(address.toTrytes());
+    }
+    writer.endArray();
+  }
+  writer.field("threshold", threshold_);
+  if (!tips_.empty()) {
+    writer.field("tips", tips_);
+  }
+}
+
 }  // namespace Requests
 
 }  // namespace API
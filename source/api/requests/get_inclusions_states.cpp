@@ -46,6 +46,13 @@ GetInclusionStates::serialize(json& data) const {
   data["tips"]         = tips_;
 }
 
+void
+GetInclusionStates::serialize(JsonWriter& writer) const {
+  Base::serialize(writer);
+  writer.field("transactions", transactions_);
+  writer.field("tips", tips_);
+}
+
 }  // namespace Requests
 
 }  // namespace API
@@ -45,6 +45,14 @@ GetTransactionsToApprove::serialize(json& data) const {
     data["reference"] = reference_;
 }
 
+void
+GetTransactionsToApprove::serialize(JsonWriter& writer) const {
+  Base::serialize(writer);
+  writer.field("depth", depth_);
+  if (!reference_.empty())
+    writer.field("reference", reference_);
+}
+
 }  // namespace Requests
 
 }  // namespace API
@@ -43,6 +43,12 @@ GetTrytes::serialize(json& data) const {
   data["hashes"] = hashes_;
 }
 
+void
+GetTrytes::serialize(JsonWriter& writer) const {
+  Base::serialize(writer);
+  writer.field("hashes", hashes_);
+}
+
 }  // namespace Requests
 
 }  // namespace API
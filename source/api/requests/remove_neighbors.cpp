@@ -43,6 +43,12 @@ RemoveNeighbors::serialize(json& data) const {
   data["uris"] = uris_;
 }
 
+void
+RemoveNeighbors::serialize(JsonWriter& writer) const {
+  Base::serialize(writer);
+  writer.field("uris", uris_);
+}
+
 }  // namespace Requests
 
 }  // namespace API
@@ -43,6 +43,12 @@ StoreTransactions::serialize(json& data) const {
   data["trytes"] = trytes_;
 }
 
+void
+StoreTransactions::serialize(JsonWriter& writer) const {
+  Base::serialize(writer);
+  writer.field("trytes", trytes_);
+}
+
 }  // namespace Requests
 
 }  // namespace API
@@ -46,6 +46,20 @@ WereAddressesSpentFrom::serialize(json& data) const {
   }
 }
 
+void
+WereAddressesSpentFrom::serialize(JsonWriter& writer) const {
+  Base::serialize(writer);
+
+  if (!addresses_.empty()) {
+    writer.key("addresses");
+    writer.beginArray();
+    for (auto& address : addresses_) {
+      writer.value(address.toTrytes());
+    }
+    writer.endArray();
+  }
+}
+
 }  // namespace Requests
 
 }  // namespace API
@@ -54,6 +54,11 @@ FindTransactions::getHashes() const {
   return hashes_;
 }
 
+std::vector<Types::Trytes>&
+FindTransactions::getHashes() {
+  return hashes_;
+}
+
 }  // namespace Responses
 
 }  // namespace API
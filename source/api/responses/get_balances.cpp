@@ -74,6 +74,11 @@ GetBalances::getBalances() const {
   return balances_;
 }
 
+std::vector<std::string>&
+GetBalances::getBalances() {
+  return balances_;
+}
+
 const std::vector<Types::Trytes>&
 GetBalances::getReferences() const {
   return references_;
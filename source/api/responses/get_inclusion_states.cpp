@@ -54,6 +54,11 @@ GetInclusionStates::getStates() const {
   return states_;
 }
 
+std::vector<bool>&
+GetInclusionStates::getStates() {
+  return states_;
+}
+
 }  // namespace Responses
 
 }  // namespace API
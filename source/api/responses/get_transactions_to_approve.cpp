@@ -33,8 +33,8 @@ namespace API {
 
 namespace Responses {
 
-GetTransactionsToApprove::GetTransactionsToApprove(const Types::Trytes& trunkTransaction,
-                                                   const Types::Trytes& branchTransaction)
+GetTransactionsToApprove::GetTransactionsToApprove(const Types::Hash& trunkTransaction,
+                                                   const Types::Hash& branchTransaction)
     : trunkTransaction_(trunkTransaction), branchTransaction_(branchTransaction) {
 }
 
@@ -47,20 +47,20 @@ GetTransactionsToApprove::deserialize(const json& res) {
   Base::deserialize(res);
 
   if (res.count("trunkTransaction")) {
-    trunkTransaction_ = res.at("trunkTransaction").get<decltype(trunkTransaction_)>();
+    trunkTransaction_ = res.at("trunkTransaction").get<Types::Trytes>();
   }
 
   if (res.count("branchTransaction")) {
-    branchTransaction_ = res.at("branchTransaction").get<decltype(branchTransaction_)>();
+    branchTransaction_ = res.at("branchTransaction").get<Types::Trytes>();
   }
 }
 
-const Types::Trytes&
+const Types::Hash&
 GetTransactionsToApprove::getTrunkTransaction() const {
   return trunkTransaction_;
 }
 
-const Types::Trytes&
+const Types::Hash&
 GetTransactionsToApprove::getBranchTransaction() const {
   return branchTransaction_;
 }
@@ -54,6 +54,11 @@ GetTrytes::getTrytes() const {
   return trytes_;
 }
 
+std::vector<Types::Trytes>&
+GetTrytes::getTrytes() {
+  return trytes_;
+}
+
 }  // namespace Responses
 
 }  // namespace API
@@ -54,6 +54,11 @@ WereAddressesSpentFrom::getStates() const {
   return states_;
 }
 
+std::vector<bool>&
+WereAddressesSpentFrom::getStates() {
+  return states_;
+}
+
 }  // namespace Responses
 
 }  // namespace API
@@ -0,0 +1,249 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <algorithm>
+
+#include <iota/api/responses/attach_to_tangle.hpp>
+#include <iota/api/responses/find_transactions.hpp>
+#include <iota/api/responses/get_transactions_to_approve.hpp>
+#include <iota/api/send_pipeline.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <iota/models/transaction_view.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+constexpr std::size_t SendPipeline::DefaultQueueCapacity;
+constexpr int64_t     SendPipeline::MaxTipsAge;
+
+SendPipeline::SendPipeline(const Extended& api, int depth, int minWeightMagnitude,
+                           const Types::Trytes& reference, std::size_t queueCapacity)
+    : api_(api),
+      depth_(depth),
+      minWeightMagnitude_(minWeightMagnitude),
+      reference_(reference),
+      prepareQueue_(queueCapacity),
+      tipsQueue_(1),
+      powQueue_(queueCapacity),
+      broadcastQueue_(queueCapacity),
+      completed_(0) {
+  threads_.emplace_back(&SendPipeline::prepareStage, this);
+  threads_.emplace_back(&SendPipeline::tipsStage, this);
+  threads_.emplace_back(&SendPipeline::powStage, this);
+  threads_.emplace_back(&SendPipeline::broadcastStage, this);
+}
+
+SendPipeline::~SendPipeline() {
+  //! each stage closes the queue of the next one once drained, except for the tips which are only
+  //! needed until the pow stage is done
+  prepareQueue_.close();
+  threads_[0].join();
+  threads_[2].join();
+  tipsQueue_.close();
+  threads_[1].join();
+  threads_[3].join();
+}
+
+std::future<Responses::SendTransfer>
+SendPipeline::submit(const Models::Seed& seed, const std::vector<Models::Transfer>& transfers,
+                     const std::vector<Models::Address>& inputs, const Models::Address& remainder) {
+  //! inputs found automatically could still be the ones of a bundle in flight, and be signed twice
+  if (inputs.empty() &&
+      std::any_of(transfers.begin(), transfers.end(),
+                  [](const Models::Transfer& transfer) { return transfer.getValue() != 0; })) {
+    throw Errors::IllegalState("Value transfers need explicit inputs in a send pipeline");
+  }
+
+  std::unique_ptr<Job> job(new Job);
+  job->seed      = seed;
+  job->transfers = transfers;
+  job->inputs    = inputs;
+  job->remainder = remainder;
+
+  auto result = job->promise.get_future();
+
+  if (!prepareQueue_.push(std::move(job))) {
+    throw Errors::IllegalState("Send pipeline is stopped");
+  }
+
+  return result;
+}
+
+void
+SendPipeline::prepareStage() {
+  std::unique_ptr<Job> job;
+
+  while (prepareQueue_.pop(job)) {
+    const Utils::StopWatch stopWatch;
+
+    try {
+      job->trytes = api_.prepareTransfers(job->seed, job->transfers, job->remainder, job->inputs);
+    } catch (...) {
+      fail(job, std::current_exception());
+      continue;
+    }
+
+    record(Stage::Prepare, stopWatch.getElapsedTime().count());
+    powQueue_.push(std::move(job));
+  }
+
+  powQueue_.close();
+}
+
+void
+SendPipeline::tipsStage() {
+  //! always keep one set of tips ready for the next bundle
+  while (tipsQueue_.push(fetchTips())) {
+  }
+}
+
+void
+SendPipeline::powStage() {
+  std::unique_ptr<Job> job;
+
+  while (powQueue_.pop(job)) {
+    Tips tips;
+
+    //! prefetched tips are only used if they are still fresh
+    if (!tipsQueue_.pop(tips) || tips.error ||
+        Utils::StopWatch::now() - tips.fetchedAt > std::chrono::milliseconds(MaxTipsAge)) {
+      tips = fetchTips();
+    }
+
+    if (tips.error) {
+      fail(job, tips.error);
+      continue;
+    }
+
+    const Utils::StopWatch stopWatch;
+
+    try {
+      job->trytes = api_.attachToTangle(tips.trunk, tips.branch, minWeightMagnitude_, job->trytes)
+                        .getTrytes();
+    } catch (...) {
+      fail(job, std::current_exception());
+      continue;
+    }
+
+    record(Stage::Pow, stopWatch.getElapsedTime().count());
+    broadcastQueue_.push(std::move(job));
+  }
+
+  broadcastQueue_.close();
+}
+
+void
+SendPipeline::broadcastStage() {
+  std::unique_ptr<Job> job;
+
+  while (broadcastQueue_.pop(job)) {
+    const Utils::StopWatch stopWatch;
+    bool                   found = false;
+
+    try {
+      api_.broadcastAndStore(job->trytes);
+
+      //! all the transactions share the bundle hash: check it once for the whole bundle
+      const auto bundle = Models::TransactionView{ job->trytes.front() }.getBundle();
+      found             = !api_.findTransactionsByBundles({ bundle }).getHashes().empty();
+    } catch (...) {
+      fail(job, std::current_exception());
+      continue;
+    }
+
+    record(Stage::Broadcast, stopWatch.getElapsedTime().count());
+    complete();
+    job->promise.set_value(
+        { std::vector<bool>(job->trytes.size(), found), job->stopWatch.getElapsedTime().count() });
+  }
+}
+
+SendPipeline::Tips
+SendPipeline::fetchTips() {
+  const Utils::StopWatch stopWatch;
+  Tips                   tips;
+
+  try {
+    const auto tta = api_.getTransactionsToApprove(depth_, reference_);
+    tips.trunk     = tta.getTrunkTransaction();
+    tips.branch    = tta.getBranchTransaction();
+  } catch (...) {
+    tips.error = std::current_exception();
+    return tips;
+  }
+
+  tips.fetchedAt = Utils::StopWatch::now();
+  record(Stage::Tips, stopWatch.getElapsedTime().count());
+
+  return tips;
+}
+
+void
+SendPipeline::record(Stage stage, int64_t duration) {
+  std::lock_guard<std::mutex> lock(statsMtx_);
+  auto&                       stats = stats_[static_cast<std::size_t>(stage)];
+
+  ++stats.count;
+  stats.totalDuration += duration;
+  stats.maxDuration = std::max(stats.maxDuration, duration);
+}
+
+void
+SendPipeline::fail(std::unique_ptr<Job>& job, std::exception_ptr error) {
+  complete();
+  job->promise.set_exception(error);
+}
+
+void
+SendPipeline::complete() {
+  //! counted before the result is published, so that it is visible to whoever waits on it
+  std::lock_guard<std::mutex> lock(statsMtx_);
+  ++completed_;
+}
+
+SendPipeline::StageStats
+SendPipeline::getStageStats(Stage stage) const {
+  std::lock_guard<std::mutex> lock(statsMtx_);
+  return stats_[static_cast<std::size_t>(stage)];
+}
+
+std::size_t
+SendPipeline::getCompleted() const {
+  std::lock_guard<std::mutex> lock(statsMtx_);
+  return completed_;
+}
+
+double
+SendPipeline::getThroughput() const {
+  const auto elapsed = stopWatch_.getElapsedTime().count();
+
+  std::lock_guard<std::mutex> lock(statsMtx_);
+  return elapsed > 0 ? completed_ * 1000.0 / elapsed : 0.0;
+}
+
+}  // namespace API
+
+}  // namespace IOTA
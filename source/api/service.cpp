@@ -23,14 +23,367 @@
 //
 //
 
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <thread>
+
+#include <iota/api/requests/get_node_info.hpp>
 #include <iota/api/service.hpp>
+#include <iota/utils/thread_pool.hpp>
 
 namespace IOTA {
 
 namespace API {
 
+constexpr std::size_t Service::MaxHedgedRequests;
+
+//! latency percentile after which reads are hedged, by default
+static const double DefaultHedgePercentile = 0.95;
+
+//! number of latency samples needed before a node's reads are hedged
+static const std::size_t MinHedgeSamples = 10;
+
+//! a response worth returning to the caller, as opposed to a failure of the node
+static bool
+succeeded(const cpr::Response& res) {
+  return res.error.code == cpr::ErrorCode::OK && res.status_code < 500;
+}
+
+//! threads running hedged reads, with the count of their requests
+struct Service::Hedges {
+  Hedges() : inFlight(0), pool(MaxHedgedRequests) {
+  }
+
+  //! reserve slots for requests so that they never wait for a thread, false past the bound
+  bool acquire(std::size_t slots) {
+    auto count = inFlight.load();
+
+    do {
+      if (count + slots > MaxHedgedRequests) {
+        return false;
+      }
+    } while (!inFlight.compare_exchange_weak(count, count + slots));
+
+    return true;
+  }
+
+  void release(std::size_t slots) {
+    inFlight -= slots;
+  }
+
+  //! requests running or about to run
+  std::atomic<std::size_t> inFlight;
+  //! declared last so that the requests are joined before the count is destroyed
+  Utils::ThreadPool pool;
+};
+
 Service::Service(const std::string& host, const uint16_t& port, int timeout, const std::string& user, const std::string& pass)
-    : host_(host), port_(port), timeout_(timeout), user_(user), pass_(pass) {
+    : timeout_(timeout),
+      user_(user),
+      pass_(pass),
+      //! enough idle sessions for every thread of a parallel request to find one
+      maxIdle_(std::max<std::size_t>(SessionPool::DefaultMaxIdle,
+                                     std::thread::hardware_concurrency())),
+      broadcastToAll_(false),
+      hedgePercentile_(DefaultHedgePercentile),
+      hedges_(std::make_shared<Hedges>()) {
+  addNode(host, port);
+}
+
+void
+Service::addNode(const std::string& host, const uint16_t& port) {
+  nodes_.push_back(std::make_shared<Node>(host + ":" + std::to_string(port), timeout_, user_, pass_,
+                                          maxIdle_));
+}
+
+const std::vector<std::shared_ptr<Node>>&
+Service::getNodes() const {
+  return nodes_;
+}
+
+std::vector<std::shared_ptr<Node>>
+Service::rankNodes() const {
+  std::vector<std::shared_ptr<Node>> ranked;
+  std::vector<double>                latencies;
+
+  for (const auto& node : nodes_) {
+    if (node->isHealthy()) {
+      ranked.push_back(node);
+    }
+  }
+
+  if (ranked.empty()) {
+    return nodes_;
+  }
+
+  //! nodes never measured have a latency of 0 and are tried first, which measures them
+  std::stable_sort(ranked.begin(), ranked.end(),
+                   [](const std::shared_ptr<Node>& lhs, const std::shared_ptr<Node>& rhs) {
+                     return lhs->getLatency() < rhs->getLatency();
+                   });
+
+  return ranked;
+}
+
+void
+Service::probe() const {
+  auto request = Requests::GetNodeInfo{};
+  auto body    = serialize(request);
+  auto command = request.getCommand();
+
+  std::vector<std::future<cpr::Response>> probes;
+  for (const auto& node : nodes_) {
+    probes.push_back(std::async(std::launch::async,
+                                [node, body, command]() { return node->post(body, command); }));
+  }
+
+  for (auto& probe : probes) {
+    probe.wait();
+  }
+}
+
+void
+Service::setBroadcastToAllNodes(bool broadcast) {
+  broadcastToAll_ = broadcast;
+}
+
+bool
+Service::getBroadcastToAllNodes() const {
+  return broadcastToAll_;
+}
+
+void
+Service::setHedgePercentile(double percentile) {
+  hedgePercentile_ = percentile;
+}
+
+double
+Service::getHedgePercentile() const {
+  return hedgePercentile_;
+}
+
+void
+Service::reserveSessions(std::size_t maxIdle) {
+  maxIdle_ = std::max(maxIdle_, maxIdle);
+
+  for (const auto& node : nodes_) {
+    auto& sessions = node->getSessionPool();
+    if (sessions.getMaxIdle() < maxIdle_) {
+      sessions.setMaxIdle(maxIdle_);
+    }
+  }
+}
+
+Service::Routing
+Service::routingOf(const std::string& command) {
+  if (command == "broadcastTransactions" || command == "storeTransactions") {
+    return Routing::Write;
+  }
+
+  //! remote proof of work runs on the node interruptAttachingToTangle is sent to
+  if (command == "getNeighbors" || command == "addNeighbors" || command == "removeNeighbors" ||
+      command == "attachToTangle" || command == "interruptAttachingToTangle") {
+    return Routing::Primary;
+  }
+
+  return Routing::Read;
+}
+
+std::string
+Service::serialize(const Requests::Base& request) {
+  //! the body is moved into the http session afterwards, so it is written in a single buffer
+  std::string body;
+  JsonWriter  writer(body);
+
+  writer.beginObject();
+  request.serialize(writer);
+  writer.endObject();
+
+  return body;
+}
+
+cpr::Response
+Service::post(std::string&& body, const std::string& command) const {
+  auto routing = routingOf(command);
+
+  if (nodes_.size() == 1 || routing == Routing::Primary) {
+    return nodes_.front()->post(std::move(body), command);
+  }
+
+  if (routing == Routing::Write) {
+    return broadcastToAll_ ? postToAll(body, command) : postWithFailover(body, command, false);
+  }
+
+  return postWithFailover(body, command, true);
+}
+
+cpr::Response
+Service::postWithFailover(const std::string& body, const std::string& command, bool hedge) const {
+  auto          ranked = rankNodes();
+  std::size_t   next   = 0;
+  cpr::Response res;
+
+  //! without free hedging threads, the read is sent from the calling thread as a plain request
+  if (hedge && hedgePercentile_ > 0 && ranked.size() > 1 &&
+      ranked.front()->getSamples(command) >= MinHedgeSamples && hedges_->acquire(2)) {
+    res  = postHedged(ranked[0], ranked[1], body, command);
+    next = 2;
+
+    if (succeeded(res)) {
+      return res;
+    }
+  }
+
+  for (; next < ranked.size(); ++next) {
+    res = ranked[next]->post(body, command);
+
+    if (succeeded(res)) {
+      return res;
+    }
+  }
+
+  return res;
+}
+
+cpr::Response
+Service::postHedged(const std::shared_ptr<Node>& primary, const std::shared_ptr<Node>& secondary,
+                    const std::string& body, const std::string& command) const {
+  //! state shared with the requests, which may outlive this call when they lose the race
+  struct Race {
+    std::mutex              mtx;
+    std::condition_variable cv;
+    std::size_t             launched   = 0;
+    std::size_t             finished   = 0;
+    bool                    hasSuccess = false;
+    cpr::Response           success;
+    cpr::Response           failure;
+  };
+
+  //! the requests only hold the hedges through a raw pointer: the pool joins them on destruction
+  auto race   = std::make_shared<Race>();
+  auto hedges = hedges_.get();
+  auto launch = [&race, &body, &command, hedges](const std::shared_ptr<Node>& node) {
+    ++race->launched;
+
+    hedges->pool.submit([race, node, body, command, hedges]() {
+      auto res = node->post(body, command);
+      hedges->release(1);
+
+      std::lock_guard<std::mutex> lock(race->mtx);
+      ++race->finished;
+      if (succeeded(res)) {
+        if (!race->hasSuccess) {
+          race->success    = std::move(res);
+          race->hasSuccess = true;
+        }
+      } else {
+        race->failure = std::move(res);
+      }
+      race->cv.notify_all();
+    });
+  };
+
+  auto percentile = primary->getLatencyPercentile(hedgePercentile_, command);
+  auto delay      = std::chrono::milliseconds(static_cast<int64_t>(percentile));
+
+  std::unique_lock<std::mutex> lock(race->mtx);
+  launch(primary);
+
+  //! hedge when the primary is slower than usual, or failed
+  race->cv.wait_for(lock, delay, [&race]() { return race->finished > 0; });
+  if (!race->hasSuccess) {
+    launch(secondary);
+  } else {
+    hedges_->release(1);
+  }
+
+  race->cv.wait(lock, [&race]() { return race->hasSuccess || race->finished == race->launched; });
+  return race->hasSuccess ? race->success : race->failure;
+}
+
+cpr::Response
+Service::postToAll(const std::string& body, const std::string& command) const {
+  std::vector<std::future<cpr::Response>> responses;
+  for (const auto& node : nodes_) {
+    responses.push_back(std::async(std::launch::async,
+                                   [node, body, command]() { return node->post(body, command); }));
+  }
+
+  cpr::Response res;
+  bool          hasSuccess = false;
+  for (auto& response : responses) {
+    auto nodeRes = response.get();
+
+    if (!hasSuccess) {
+      hasSuccess = succeeded(nodeRes);
+      res        = std::move(nodeRes);
+    }
+  }
+
+  return res;
+}
+
+json
+Service::parse(const cpr::Response& res) const {
+  if (res.error.code != cpr::ErrorCode::OK)
+    throw Errors::Network(res.error.message);
+
+  json        resJson;
+  std::string error;
+
+  try {
+    resJson = json::parse(res.text);
+
+    if (resJson.count("error")) {
+      error = resJson["error"].get<decltype(error)>();
+    }
+  } catch (const std::runtime_error&) {
+    if (res.elapsed >= timeout_) {
+      throw Errors::Network("Time out after " + std::to_string(timeout_) + "s");
+    }
+
+    throw Errors::Unrecognized("Invalid reply from node (unrecognized format): " + res.text);
+  }
+
+  switch (res.status_code) {
+    case 200:
+      return resJson;
+    case 400:
+      throw Errors::BadRequest(error);
+    case 401:
+      throw Errors::Unauthorized(error);
+    case 500:
+      throw Errors::InternalServerError(error);
+    default:
+      if (res.elapsed >= timeout_) {
+        throw Errors::Network("Time out after " + std::to_string(timeout_) + "s");
+      }
+
+      throw Errors::Unrecognized(error);
+  }
+}
+
+void
+Service::read(const cpr::Response& res, JsonStreamReader& reader) const {
+  //! failed requests carry a small error document, handled as usual
+  if (res.error.code != cpr::ErrorCode::OK || res.status_code != 200) {
+    parse(res);
+    return;
+  }
+
+  try {
+    reader.feed(res.text.data(), res.text.size());
+    reader.finish();
+  } catch (const Errors::Unrecognized&) {
+    if (res.elapsed >= timeout_) {
+      throw Errors::Network("Time out after " + std::to_string(timeout_) + "s");
+    }
+
+    throw Errors::Unrecognized("Invalid reply from node (unrecognized format): " + res.text);
+  }
 }
 
 }  // namespace API
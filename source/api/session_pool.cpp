@@ -0,0 +1,99 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <iota/api/session_pool.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+constexpr std::size_t SessionPool::DefaultMaxIdle;
+
+SessionPool::SessionPool(const std::string& url, int timeout, const std::string& user,
+                         const std::string& pass, std::size_t maxIdle)
+    : url_(url), timeout_(timeout), user_(user), pass_(pass), maxIdle_(maxIdle) {
+}
+
+std::unique_ptr<cpr::Session>
+SessionPool::acquire() {
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    if (!sessions_.empty()) {
+      auto session = std::move(sessions_.back());
+      sessions_.pop_back();
+      return session;
+    }
+  }
+
+  //! settings that do not change between requests are set once per session
+  std::unique_ptr<cpr::Session> session(new cpr::Session);
+  session->SetUrl(cpr::Url{ url_ });
+  session->SetTimeout(cpr::Timeout{ timeout_ * 1000 });
+  if (!user_.empty() && !pass_.empty() && url_.compare(0, 5, "https") == 0) {
+    session->SetAuth(cpr::Authentication{ user_, pass_ });
+  }
+
+  return session;
+}
+
+void
+SessionPool::release(std::unique_ptr<cpr::Session> session) {
+  if (!session) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  if (sessions_.size() < maxIdle_) {
+    sessions_.push_back(std::move(session));
+  }
+}
+
+std::size_t
+SessionPool::idle() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return sessions_.size();
+}
+
+std::size_t
+SessionPool::getMaxIdle() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return maxIdle_;
+}
+
+void
+SessionPool::setMaxIdle(std::size_t maxIdle) {
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  maxIdle_ = maxIdle;
+  if (sessions_.size() > maxIdle_) {
+    sessions_.resize(maxIdle_);
+  }
+}
+
+}  // namespace API
+
+}  // namespace IOTA
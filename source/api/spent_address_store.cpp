@@ -0,0 +1,330 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+#include <iota/api/spent_address_store.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <iota/types/big_int.hpp>
+#include <iota/types/trinary.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+//! Bloom filter parameters: ~0.1% of false positives at full capacity
+static constexpr std::size_t FilterBitsPerRecord = 16;
+static constexpr std::size_t FilterHashes        = 7;
+static constexpr std::size_t FilterMinCapacity   = 512;
+
+constexpr std::size_t SpentAddressStore::DefaultCompactThreshold;
+
+static bool
+readRecord(std::istream& is, SpentAddressStore::Record& record) {
+  return static_cast<bool>(
+      is.read(reinterpret_cast<char*>(record.data()), static_cast<std::streamsize>(record.size())));
+}
+
+static void
+writeRecord(std::ostream& os, const SpentAddressStore::Record& record) {
+  os.write(reinterpret_cast<const char*>(record.data()),
+           static_cast<std::streamsize>(record.size()));
+}
+
+static uint64_t
+loadWord(const SpentAddressStore::Record& record, std::size_t offset) {
+  uint64_t word;
+  std::memcpy(&word, record.data() + offset, sizeof(word));
+  return word;
+}
+
+SpentAddressStore::SpentAddressStore(const std::string& path, std::size_t compactThreshold)
+    : path_(path), compactThreshold_(std::max<std::size_t>(compactThreshold, 1)) {
+  if (path_.empty()) {
+    resizeFilter(0);
+    return;
+  }
+
+  //! records journaled since the last compaction, a partially written record is dropped
+  std::ifstream journal(journalPath(), std::ios::binary);
+  Record        record;
+  while (readRecord(journal, record)) {
+    pending_.push_back(record);
+  }
+  journal.close();
+
+  std::sort(pending_.begin(), pending_.end());
+  pending_.erase(std::unique(pending_.begin(), pending_.end()), pending_.end());
+
+  //! create the file if needed, and check it only holds whole records
+  std::ofstream(path_, std::ios::binary | std::ios::app).close();
+  file_.open(path_, std::ios::binary);
+  file_.seekg(0, std::ios::end);
+  const auto fileSize = static_cast<std::size_t>(file_.tellg());
+  if (!file_ || fileSize % ByteHashLength != 0) {
+    throw Errors::IllegalState("Invalid spent address store");
+  }
+  fileCount_ = fileSize / ByteHashLength;
+
+  resizeFilter(fileCount_ + pending_.size());
+  compactRecords();
+
+  journal_.open(journalPath(), std::ios::binary | std::ios::app);
+}
+
+bool
+SpentAddressStore::contains(const Types::Trytes& address) const {
+  const auto record = toRecord(address);
+
+  std::lock_guard<std::mutex> lock(mtx_);
+  return containsRecord(record);
+}
+
+void
+SpentAddressStore::add(const Types::Trytes& address) {
+  add(std::vector<Types::Trytes>{ address });
+}
+
+void
+SpentAddressStore::add(const std::vector<Types::Trytes>& addresses) {
+  std::vector<Record> records;
+  records.reserve(addresses.size());
+  for (const auto& address : addresses) {
+    records.push_back(toRecord(address));
+  }
+
+  std::lock_guard<std::mutex> lock(mtx_);
+  for (const auto& record : records) {
+    addRecord(record);
+  }
+
+  if (journal_.is_open()) {
+    journal_.flush();
+    if (!journal_) {
+      throw Errors::IllegalState("Could not write spent address store");
+    }
+  }
+
+  if (!path_.empty() && pending_.size() >= compactThreshold_) {
+    compactRecords();
+  }
+}
+
+std::size_t
+SpentAddressStore::size() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return fileCount_ + pending_.size();
+}
+
+void
+SpentAddressStore::compact() {
+  std::lock_guard<std::mutex> lock(mtx_);
+  compactRecords();
+}
+
+SpentAddressStore::Record
+SpentAddressStore::toRecord(const Types::Trytes& address) {
+  const auto trytes = address.substr(0, AddressLength);
+  if (!Types::isValidHash(trytes)) {
+    throw Errors::IllegalState("Invalid address");
+  }
+
+  //! the last trit is dropped, it is always 0 for addresses
+  std::vector<uint8_t> bytes(ByteHashLength);
+  Types::Bigint        bigint;
+  bigint.fromTrits(Types::trytesToTrits(trytes));
+  bigint.toBytes(bytes);
+
+  Record record;
+  std::copy(bytes.begin(), bytes.end(), record.begin());
+  return record;
+}
+
+void
+SpentAddressStore::addRecord(const Record& record) {
+  if (containsRecord(record)) {
+    return;
+  }
+
+  if (journal_.is_open()) {
+    writeRecord(journal_, record);
+  }
+
+  pending_.insert(std::lower_bound(pending_.begin(), pending_.end(), record), record);
+
+  if (fileCount_ + pending_.size() > filterCapacity_) {
+    resizeFilter(2 * (fileCount_ + pending_.size()));
+  } else {
+    addToFilter(record);
+  }
+}
+
+bool
+SpentAddressStore::containsRecord(const Record& record) const {
+  return filterContains(record) &&
+         (std::binary_search(pending_.begin(), pending_.end(), record) || fileContains(record));
+}
+
+bool
+SpentAddressStore::fileContains(const Record& record) const {
+  std::size_t first = 0;
+  std::size_t last  = fileCount_;
+  Record      current;
+
+  while (first < last) {
+    const auto middle = first + (last - first) / 2;
+
+    file_.clear();
+    file_.seekg(static_cast<std::streamoff>(middle * ByteHashLength));
+    if (!readRecord(file_, current)) {
+      throw Errors::IllegalState("Could not read spent address store");
+    }
+
+    if (current == record) {
+      return true;
+    } else if (current < record) {
+      first = middle + 1;
+    } else {
+      last = middle;
+    }
+  }
+
+  return false;
+}
+
+void
+SpentAddressStore::compactRecords() {
+  if (path_.empty() || pending_.empty()) {
+    return;
+  }
+
+  //! merge the sorted file and the journaled records into a new file
+  const auto    tmpPath = path_ + ".tmp";
+  std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+  std::size_t   count = 0;
+  auto          next  = pending_.begin();
+  Record        record;
+
+  file_.clear();
+  file_.seekg(0);
+  for (std::size_t i = 0; i < fileCount_ && readRecord(file_, record); ++i) {
+    for (; next != pending_.end() && *next < record; ++next, ++count) {
+      writeRecord(out, *next);
+    }
+    if (next != pending_.end() && *next == record) {
+      ++next;
+    }
+
+    writeRecord(out, record);
+    ++count;
+  }
+  for (; next != pending_.end(); ++next, ++count) {
+    writeRecord(out, *next);
+  }
+
+  out.close();
+  if (!out) {
+    throw Errors::IllegalState("Could not write spent address store");
+  }
+
+  //! the journal is only dropped once the new file replaced the old one
+  const auto reopenJournal = journal_.is_open();
+  file_.close();
+  journal_.close();
+  if (std::rename(tmpPath.c_str(), path_.c_str()) != 0) {
+    throw Errors::IllegalState("Could not write spent address store");
+  }
+  std::remove(journalPath().c_str());
+
+  file_.open(path_, std::ios::binary);
+  fileCount_ = count;
+  pending_.clear();
+
+  if (reopenJournal) {
+    journal_.open(journalPath(), std::ios::binary | std::ios::app);
+  }
+}
+
+void
+SpentAddressStore::resizeFilter(std::size_t capacity) {
+  filterCapacity_ = std::max(capacity, FilterMinCapacity);
+
+  //! power of two number of bits, so that indexes are masked
+  std::size_t nbBits = 64;
+  while (nbBits < filterCapacity_ * FilterBitsPerRecord) {
+    nbBits <<= 1;
+  }
+  filter_.assign(nbBits / 64, 0);
+
+  Record record;
+  file_.clear();
+  file_.seekg(0);
+  for (std::size_t i = 0; i < fileCount_ && readRecord(file_, record); ++i) {
+    addToFilter(record);
+  }
+  for (const auto& pending : pending_) {
+    addToFilter(pending);
+  }
+}
+
+void
+SpentAddressStore::addToFilter(const Record& record) {
+  //! records encode hashes, their bytes are already uniformly distributed
+  const uint64_t mask = filter_.size() * 64 - 1;
+  const uint64_t h1   = loadWord(record, 24);
+  const uint64_t h2   = loadWord(record, 32) | 1;
+
+  for (std::size_t i = 0; i < FilterHashes; ++i) {
+    const auto bit = (h1 + i * h2) & mask;
+    filter_[bit / 64] |= uint64_t{ 1 } << (bit % 64);
+  }
+}
+
+bool
+SpentAddressStore::filterContains(const Record& record) const {
+  const uint64_t mask = filter_.size() * 64 - 1;
+  const uint64_t h1   = loadWord(record, 24);
+  const uint64_t h2   = loadWord(record, 32) | 1;
+
+  for (std::size_t i = 0; i < FilterHashes; ++i) {
+    const auto bit = (h1 + i * h2) & mask;
+    if (!(filter_[bit / 64] & (uint64_t{ 1 } << (bit % 64)))) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+std::string
+SpentAddressStore::journalPath() const {
+  return path_ + ".log";
+}
+
+}  // namespace API
+
+}  // namespace IOTA
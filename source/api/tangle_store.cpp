@@ -0,0 +1,245 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <algorithm>
+#include <iterator>
+
+#include <iota/api/tangle_store.hpp>
+#include <iota/constants.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <iota/models/address.hpp>
+#include <iota/models/tag.hpp>
+#include <iota/models/transaction_view.hpp>
+#include <iota/types/trinary.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+static constexpr std::size_t RecordLength = Models::CompactTransaction::SerializedLength;
+
+TangleStore::TangleStore(const std::string& path) : path_(path) {
+  if (path_.empty()) {
+    return;
+  }
+
+  file_.open(path_, std::ios::in | std::ios::out | std::ios::binary | std::ios::app);
+  file_.seekg(0, std::ios::end);
+  const auto fileSize = static_cast<std::size_t>(file_.tellg());
+  if (!file_ || fileSize % RecordLength != 0) {
+    throw Errors::IllegalState("Invalid tangle store");
+  }
+
+  //! rebuild the indexes
+  std::vector<uint8_t> bytes(RecordLength);
+  file_.seekg(0);
+  for (std::size_t i = 0; i < fileSize / RecordLength; ++i) {
+    if (!file_.read(reinterpret_cast<char*>(bytes.data()), RecordLength)) {
+      throw Errors::IllegalState("Could not read tangle store");
+    }
+
+    indexRecord(Models::CompactTransaction::deserialize(bytes), static_cast<uint32_t>(i));
+  }
+}
+
+bool
+TangleStore::add(const Types::Trytes& hash, const Types::Trytes& trytes) {
+  if (!Types::isValidHash(hash) || trytes.size() != TrxTrytesLength) {
+    throw Errors::IllegalState("Invalid transaction");
+  }
+
+  //! skip packing the transaction if already known
+  if (contains(hash)) {
+    return false;
+  }
+
+  const Models::TransactionView view{ Types::Trytes{ trytes }, hash };
+  return add(Models::CompactTransaction{ view });
+}
+
+bool
+TangleStore::add(const Models::CompactTransaction& trx) {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return addRecord(trx);
+}
+
+bool
+TangleStore::contains(const Types::Hash& hash) const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return hashes_.count(hash) != 0;
+}
+
+bool
+TangleStore::getTrytes(const Types::Hash& hash, Types::Trytes& trytes) const {
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  auto it = hashes_.find(hash);
+  if (it == hashes_.end()) {
+    return false;
+  }
+
+  trytes = readRecord(it->second).toTrytes();
+  return true;
+}
+
+std::vector<Types::Trytes>
+TangleStore::findTransactions(const std::vector<Models::Address>& addresses,
+                              const std::vector<Models::Tag>&     tags,
+                              const std::vector<Types::Trytes>&   approvees,
+                              const std::vector<Types::Trytes>&   bundles) const {
+  std::vector<Types::Hash> addressValues;
+  for (const auto& address : addresses) {
+    addressValues.emplace_back(address.toTrytes());
+  }
+
+  std::vector<Types::Hash> tagValues;
+  for (const auto& tag : tags) {
+    tagValues.emplace_back(tag.toTrytesWithPadding());
+  }
+
+  const std::vector<Types::Hash> approveeValues(approvees.begin(), approvees.end());
+  const std::vector<Types::Hash> bundleValues(bundles.begin(), bundles.end());
+
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  //! records matching each non empty field, intersected
+  const std::vector<std::pair<const Index*, const std::vector<Types::Hash>*>> fields = {
+    { &addresses_, &addressValues },
+    { &tags_, &tagValues },
+    { &approvees_, &approveeValues },
+    { &bundles_, &bundleValues }
+  };
+
+  std::vector<uint32_t> records;
+  bool                  first = true;
+  for (const auto& field : fields) {
+    if (field.second->empty()) {
+      continue;
+    }
+
+    std::vector<uint32_t> matches;
+    collect(*field.first, *field.second, matches);
+
+    if (first) {
+      records = std::move(matches);
+      first   = false;
+    } else {
+      std::vector<uint32_t> intersection;
+      std::set_intersection(records.begin(), records.end(), matches.begin(), matches.end(),
+                            std::back_inserter(intersection));
+      records = std::move(intersection);
+    }
+  }
+
+  std::vector<Types::Trytes> hashes;
+  hashes.reserve(records.size());
+  for (const auto& record : records) {
+    hashes.push_back(recordHashes_[record].toTrytes());
+  }
+
+  return hashes;
+}
+
+std::size_t
+TangleStore::size() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return recordHashes_.size();
+}
+
+bool
+TangleStore::addRecord(const Models::CompactTransaction& trx) {
+  if (hashes_.count(trx.getHash())) {
+    return false;
+  }
+
+  std::vector<uint8_t> bytes(RecordLength);
+  trx.serialize(bytes.data());
+
+  if (path_.empty()) {
+    records_.insert(records_.end(), bytes.begin(), bytes.end());
+  } else {
+    file_.clear();
+    file_.write(reinterpret_cast<const char*>(bytes.data()), RecordLength);
+    file_.flush();
+    if (!file_) {
+      throw Errors::IllegalState("Could not write tangle store");
+    }
+  }
+
+  indexRecord(trx, static_cast<uint32_t>(recordHashes_.size()));
+  return true;
+}
+
+void
+TangleStore::indexRecord(const Models::CompactTransaction& trx, uint32_t record) {
+  const Types::Hash hash = trx.getHash();
+  hashes_[hash]          = record;
+  recordHashes_.push_back(hash);
+
+  addresses_[trx.getAddress().toTrytes()].push_back(record);
+  bundles_[trx.getBundle()].push_back(record);
+  tags_[trx.getTag().toTrytesWithPadding()].push_back(record);
+
+  const auto trunk  = trx.getTrunkTransaction();
+  const auto branch = trx.getBranchTransaction();
+  approvees_[trunk].push_back(record);
+  if (branch != trunk) {
+    approvees_[branch].push_back(record);
+  }
+}
+
+Models::CompactTransaction
+TangleStore::readRecord(uint32_t record) const {
+  if (path_.empty()) {
+    return Models::CompactTransaction::deserialize(&records_[record * RecordLength], RecordLength);
+  }
+
+  std::vector<uint8_t> bytes(RecordLength);
+  file_.clear();
+  file_.seekg(static_cast<std::streamoff>(record) * RecordLength);
+  if (!file_.read(reinterpret_cast<char*>(bytes.data()), RecordLength)) {
+    throw Errors::IllegalState("Could not read tangle store");
+  }
+
+  return Models::CompactTransaction::deserialize(bytes);
+}
+
+void
+TangleStore::collect(const Index& index, const std::vector<Types::Hash>& values,
+                     std::vector<uint32_t>& records) {
+  for (const auto& value : values) {
+    auto it = index.find(value);
+    if (it != index.end()) {
+      records.insert(records.end(), it->second.begin(), it->second.end());
+    }
+  }
+
+  std::sort(records.begin(), records.end());
+  records.erase(std::unique(records.begin(), records.end()), records.end());
+}
+
+}  // namespace API
+
+}  // namespace IOTA
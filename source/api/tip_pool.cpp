@@ -0,0 +1,209 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <vector>
+
+#include <iota/api/responses/get_node_info.hpp>
+#include <iota/api/responses/get_transactions_to_approve.hpp>
+#include <iota/api/tip_pool.hpp>
+#include <iota/utils/stop_watch.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+constexpr std::size_t TipPool::DefaultPoolSize;
+constexpr int64_t     TipPool::DefaultMaxAge;
+constexpr int64_t     TipPool::DefaultRefreshInterval;
+
+TipPool::TipPool(const Core& api, std::size_t poolSize, int64_t maxAge, int64_t refreshInterval)
+    : api_(api),
+      poolSize_(poolSize),
+      maxAge_(maxAge),
+      refreshInterval_(refreshInterval),
+      hits_(0),
+      misses_(0),
+      wake_(false),
+      stop_(false),
+      thread_(&TipPool::run, this) {
+}
+
+TipPool::~TipPool() {
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    stop_ = true;
+  }
+
+  cv_.notify_one();
+  thread_.join();
+}
+
+bool
+TipPool::take(int depth, Tips& tips) {
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  evict();
+
+  //! registers the depth if needed, and refills what is taken
+  auto& pool = pools_[depth];
+  wake_      = true;
+  cv_.notify_one();
+
+  if (pool.empty()) {
+    ++misses_;
+    return false;
+  }
+
+  ++hits_;
+  tips = std::move(pool.back());
+  pool.pop_back();
+  return true;
+}
+
+void
+TipPool::watch(int depth) {
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  pools_[depth];
+  wake_ = true;
+  cv_.notify_one();
+}
+
+std::size_t
+TipPool::size(int depth) const {
+  std::lock_guard<std::mutex> lock(mtx_);
+
+  auto it = pools_.find(depth);
+  return it == pools_.end() ? 0 : it->second.size();
+}
+
+std::size_t
+TipPool::getHits() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return hits_;
+}
+
+std::size_t
+TipPool::getMisses() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return misses_;
+}
+
+void
+TipPool::run() {
+  std::unique_lock<std::mutex> lock(mtx_);
+
+  while (!stop_) {
+    wake_ = false;
+
+    lock.unlock();
+    refresh();
+    lock.lock();
+
+    cv_.wait_for(lock, refreshInterval_, [this] { return stop_ || wake_; });
+  }
+}
+
+void
+TipPool::refresh() {
+  //! nothing to prefetch until a depth is requested
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (pools_.empty()) {
+      return;
+    }
+  }
+
+  Types::Trytes milestone;
+  try {
+    milestone = api_.getNodeInfo().getLatestMilestone();
+  } catch (const std::exception&) {
+    return;
+  }
+
+  std::vector<std::pair<int, std::size_t>> missing;
+
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+
+    //! pairs selected before a new milestone are less likely to be confirmed
+    if (milestone != milestone_) {
+      for (auto& pool : pools_) {
+        pool.second.clear();
+      }
+      milestone_ = milestone;
+    }
+
+    evict();
+
+    for (const auto& pool : pools_) {
+      if (pool.second.size() < poolSize_) {
+        missing.emplace_back(pool.first, poolSize_ - pool.second.size());
+      }
+    }
+  }
+
+  for (const auto& depth : missing) {
+    for (std::size_t i = 0; i < depth.second; ++i) {
+      Tips tips;
+
+      try {
+        const auto tta = api_.getTransactionsToApprove(depth.first);
+        tips.trunk     = tta.getTrunkTransaction();
+        tips.branch    = tta.getBranchTransaction();
+        tips.fetchedAt = Utils::StopWatch::now();
+      } catch (const std::exception&) {
+        return;
+      }
+
+      std::lock_guard<std::mutex> lock(mtx_);
+      if (stop_) {
+        return;
+      }
+
+      auto& pool = pools_[depth.first];
+      if (pool.size() < poolSize_) {
+        pool.push_back(std::move(tips));
+      }
+    }
+  }
+}
+
+void
+TipPool::evict() {
+  const auto now = Utils::StopWatch::now();
+
+  for (auto& pool : pools_) {
+    auto& tips = pool.second;
+
+    while (!tips.empty() && now - tips.front().fetchedAt > maxAge_) {
+      tips.pop_front();
+    }
+  }
+}
+
+}  // namespace API
+
+}  // namespace IOTA
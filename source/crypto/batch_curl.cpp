@@ -0,0 +1,183 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <cstring>
+
+#include <iota/crypto/batch_curl.hpp>
+#include <iota/errors/crypto.hpp>
+
+namespace IOTA {
+
+namespace Crypto {
+
+//! trits are encoded as in Pow: 0 is (1, 1), 1 is (0, 1) and -1 is (1, 0)
+static constexpr uint64_t AllBits = 0xFFFFFFFFFFFFFFFF;
+
+constexpr std::size_t BatchCurl::BatchSize;
+constexpr std::size_t BatchCurl::StateLength;
+
+//! index of the scratchpad trit read for each state trit, as computed by Curl::transform
+static const std::array<int, 3 * TritHashLength>&
+transformIndices() {
+  static const std::array<int, 3 * TritHashLength> indices = []() {
+    std::array<int, 3 * TritHashLength> result;
+    int                                 index = 0;
+
+    for (auto& next : result) {
+      index += index < 365 ? 364 : -365;
+      next = index;
+    }
+
+    return result;
+  }();
+
+  return indices;
+}
+
+//! trits of each tryte value, indexed by the value + 13
+static const int8_t TryteTrits[27][3] = {
+  { -1, -1, -1 }, { 0, -1, -1 }, { 1, -1, -1 }, { -1, 0, -1 }, { 0, 0, -1 }, { 1, 0, -1 },
+  { -1, 1, -1 },  { 0, 1, -1 },  { 1, 1, -1 },  { -1, -1, 0 }, { 0, -1, 0 }, { 1, -1, 0 },
+  { -1, 0, 0 },   { 0, 0, 0 },   { 1, 0, 0 },   { -1, 1, 0 },  { 0, 1, 0 },  { 1, 1, 0 },
+  { -1, -1, 1 },  { 0, -1, 1 },  { 1, -1, 1 },  { -1, 0, 1 },  { 0, 0, 1 },  { 1, 0, 1 },
+  { -1, 1, 1 },   { 0, 1, 1 },   { 1, 1, 1 }
+};
+
+static int
+tryteValue(char tryte) {
+  //! '9' is 0, 'A' to 'M' are 1 to 13, 'N' to 'Z' are -13 to -1
+  const int index = tryte == '9' ? 0 : tryte - 'A' + 1;
+  return index > 13 ? index - 27 : index;
+}
+
+BatchCurl::BatchCurl() {
+  reset();
+}
+
+void
+BatchCurl::reset() {
+  stateLow_.fill(AllBits);
+  stateHigh_.fill(AllBits);
+}
+
+void
+BatchCurl::absorb(const std::vector<const char*>& trytes, std::size_t length) {
+  if (trytes.size() > BatchSize) {
+    throw Errors::Crypto("BatchCurl::absorb failed: too many messages");
+  }
+
+  if (length % HashLength != 0) {
+    throw Errors::Crypto("BatchCurl::absorb failed: illegal length");
+  }
+
+  for (std::size_t offset = 0; offset < length; offset += HashLength) {
+    //! lanes without a message absorb 0 trits
+    std::memset(stateLow_.data(), 0, TritHashLength * sizeof(uint64_t));
+    std::memset(stateHigh_.data(), 0, TritHashLength * sizeof(uint64_t));
+
+    for (std::size_t lane = 0; lane < BatchSize; ++lane) {
+      const uint64_t bit = uint64_t{ 1 } << lane;
+
+      if (lane >= trytes.size()) {
+        for (std::size_t i = 0; i < TritHashLength; ++i) {
+          stateLow_[i] |= bit;
+          stateHigh_[i] |= bit;
+        }
+        continue;
+      }
+
+      const char* message = trytes[lane] + offset;
+      for (std::size_t i = 0; i < HashLength; ++i) {
+        const auto& trits = TryteTrits[tryteValue(message[i]) + 13];
+
+        for (std::size_t j = 0; j < 3; ++j) {
+          if (trits[j] != 1) {
+            stateLow_[3 * i + j] |= bit;
+          }
+          if (trits[j] != -1) {
+            stateHigh_[3 * i + j] |= bit;
+          }
+        }
+      }
+    }
+
+    transform();
+  }
+}
+
+std::vector<Types::Trytes>
+BatchCurl::squeeze(std::size_t nbLanes) {
+  if (nbLanes > BatchSize) {
+    throw Errors::Crypto("BatchCurl::squeeze failed: too many messages");
+  }
+
+  std::vector<Types::Trytes> result(nbLanes, Types::Trytes(HashLength, '9'));
+
+  for (std::size_t lane = 0; lane < nbLanes; ++lane) {
+    for (std::size_t i = 0; i < HashLength; ++i) {
+      int value = 0;
+
+      for (std::size_t j = 3; j-- > 0;) {
+        const bool low  = (stateLow_[3 * i + j] >> lane) & 1;
+        const bool high = (stateHigh_[3 * i + j] >> lane) & 1;
+        value           = value * 3 + (low == high ? 0 : (high ? 1 : -1));
+      }
+
+      result[lane][i] = TryteAlphabet[value < 0 ? value + 27 : value];
+    }
+  }
+
+  transform();
+
+  return result;
+}
+
+void
+BatchCurl::transform() {
+  const auto& indices = transformIndices();
+  uint64_t    scratchpadLow[StateLength];
+  uint64_t    scratchpadHigh[StateLength];
+
+  for (int round = 0; round < PowNumberOfRounds; ++round) {
+    std::memcpy(scratchpadLow, stateLow_.data(), StateLength * sizeof(uint64_t));
+    std::memcpy(scratchpadHigh, stateHigh_.data(), StateLength * sizeof(uint64_t));
+
+    int scratchpadIndex = 0;
+    for (std::size_t stateIndex = 0; stateIndex < StateLength; ++stateIndex) {
+      const uint64_t alpha = scratchpadLow[scratchpadIndex];
+      const uint64_t beta  = scratchpadHigh[scratchpadIndex];
+      scratchpadIndex      = indices[stateIndex];
+      const uint64_t gamma = scratchpadHigh[scratchpadIndex];
+      const uint64_t delta = (alpha | (~gamma)) & (scratchpadLow[scratchpadIndex] ^ beta);
+
+      stateLow_[stateIndex]  = ~delta;
+      stateHigh_[stateIndex] = (alpha ^ gamma) | delta;
+    }
+  }
+}
+
+}  // namespace Crypto
+
+}  // namespace IOTA
@@ -151,12 +151,9 @@ signatureFragment(const std::vector<int8_t>& normalizedBundleFragment,
   return signatureFragment;
 }
 
-std::vector<Types::Trytes>
-signInputs(const Models::Seed& seed, const std::vector<Models::Address>& inputs,
-           Models::Bundle& bundle, const std::vector<Types::Trytes>& signatureFragments) {
-  bundle.finalize();
-  bundle.addTrytes(signatureFragments);
-
+void
+signBundle(const Models::Seed& seed, const std::vector<Models::Address>& inputs,
+           Models::Bundle& bundle) {
   //  SIGNING OF INPUTS
   //
   //  Here we do the actual signing of the inputs
@@ -224,6 +221,14 @@ signInputs(const Models::Seed& seed, const std::vector<Models::Address>& inputs,
       }
     }
   }
+}
+
+std::vector<Types::Trytes>
+signInputs(const Models::Seed& seed, const std::vector<Models::Address>& inputs,
+           Models::Bundle& bundle, const std::vector<Types::Trytes>& signatureFragments) {
+  bundle.finalize();
+  bundle.addTrytes(signatureFragments);
+  signBundle(seed, inputs, bundle);
 
   std::vector<Types::Trytes> bundleTrytes;
 
@@ -233,8 +238,10 @@ signInputs(const Models::Seed& seed, const std::vector<Models::Address>& inputs,
             });
 
   // Convert all bundle entries into trytes
+  bundleTrytes.reserve(bundle.getTransactions().size());
   for (const auto& tx : bundle.getTransactions()) {
-    bundleTrytes.emplace_back(tx.toTrytes());
+    bundleTrytes.emplace_back(TrxTrytesLength, '9');
+    tx.toTrytes(&bundleTrytes.back()[0]);
   }
 
   return bundleTrytes;
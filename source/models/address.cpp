@@ -27,6 +27,7 @@
 #include <iota/crypto/kerl.hpp>
 #include <iota/errors/illegal_state.hpp>
 #include <iota/models/address.hpp>
+#include <iota/models/multisig_address_builder.hpp>
 
 namespace IOTA {
 
@@ -34,7 +35,7 @@ namespace Models {
 
 Address::Address(const Types::Trytes& address, const int64_t& balance, const int32_t& keyIndex,
                  const int32_t& security, const Type& type)
-    : balance_(balance), keyIndex_(keyIndex), type_(type), k_(std::make_shared<Crypto::Kerl>()) {
+    : balance_(balance), keyIndex_(keyIndex), type_(type) {
   setAddress(address);
   setSecurity(security);
 }
@@ -47,14 +48,14 @@ Address::Address(const char* address, const int64_t& balance, const int32_t& key
 Address::Address(const Type& type) : Address("", 0, 0, 0, type) {
 }
 
-const Types::Trytes&
+Types::Trytes
 Address::toTrytes() const {
   return address_;
 }
 
 Types::Trytes
-Address::toTrytesWithChecksum(bool validChecksum) {
-  return address_ + getChecksum(validChecksum);
+Address::toTrytesWithChecksum(bool validChecksum) const {
+  return toTrytes() + getChecksum(validChecksum);
 }
 
 bool
@@ -62,38 +63,39 @@ Address::empty() const {
   return address_.empty();
 }
 
+const Address::Type&
+Address::getType() const {
+  return type_;
+}
+
 void
 Address::absorbDigests(const std::vector<uint8_t>& digests) {
   if (type_ != MULTISIG)
     return;
+
+  if (!multisig_) {
+    multisig_ = std::make_shared<MultisigAddressBuilder>();
+  }
+
   security_ += digests.size() / ByteHashLength;
-  k_->absorb(digests);
+  multisig_->absorbDigests(digests);
 }
 
 void
 Address::finalize() {
   if (type_ != MULTISIG)
     return;
-  std::vector<uint8_t> addressBytes(ByteHashLength);
 
-  k_->squeeze(addressBytes);
-  setAddress(IOTA::Types::bytesToTrytes(addressBytes));
+  if (!multisig_) {
+    multisig_ = std::make_shared<MultisigAddressBuilder>();
+  }
+
+  setAddress(multisig_->finalize().toTrytes());
 }
 
 bool
 Address::validate(const std::vector<std::vector<uint8_t>>& digests) {
-  if (type_ != MULTISIG)
-    return false;
-  Crypto::Kerl k;
-
-  for (const auto& digest : digests) {
-    k.absorb(digest);
-  }
-
-  std::vector<uint8_t> addressBytes(ByteHashLength);
-  k.squeeze(addressBytes);
-
-  return IOTA::Types::bytesToTrytes(addressBytes) == address_;
+  return MultisigAddressBuilder::validate(*this, digests);
 }
 
 void
@@ -107,29 +109,33 @@ Address::setAddress(const Types::Trytes& address) {
     throw Errors::IllegalState("address is not a valid trytes string");
   }
 
-  address_ = address.substr(0, AddressLength);
-
   if (address.length() == AddressLengthWithChecksum) {
+    address_  = address.substr(0, AddressLength);
     checksum_ = address.substr(AddressLength);
   } else {
+    address_  = address;
     checksum_ = "";
   }
+
+  validChecksum_.reset();
 }
 
 const Types::Trytes&
-Address::getChecksum(bool validChecksum) {
+Address::getChecksum(bool validChecksum) const {
   //! note that we do not do anything for empty address
-  if (!empty() && (checksum_.empty() || validChecksum)) {
+  if (empty() || (!checksum_.empty() && !validChecksum)) {
+    return checksum_;
+  }
+
+  return validChecksum_.get([this]() {
     Crypto::Kerl         k;
     std::vector<uint8_t> checksumBytes(ByteHashLength);
 
-    k.absorb(Types::trytesToBytes(address_));
+    k.absorb(Types::trytesToBytes(toTrytes()));
     k.finalSqueeze(checksumBytes);
 
-    checksum_ = Types::bytesToTrytes(checksumBytes).substr(AddressLength - ChecksumLength);
-  }
-
-  return checksum_;
+    return Types::bytesToTrytes(checksumBytes).substr(AddressLength - ChecksumLength);
+  });
 }
 
 const int64_t&
@@ -24,9 +24,11 @@
 //
 
 #include <algorithm>
+#include <ostream>
 
 #include <iota/constants.hpp>
 #include <iota/crypto/kerl.hpp>
+#include <iota/errors/illegal_state.hpp>
 #include <iota/models/bundle.hpp>
 #include <iota/types/trinary.hpp>
 #include <iota/types/utils.hpp>
@@ -61,27 +63,37 @@ Bundle::empty() const {
   return getLength() == 0;
 }
 
-const Types::Trytes&
+const Types::Hash&
 Bundle::getHash() const {
   return hash_;
 }
 
 void
-Bundle::setHash(const Types::Trytes& hash) {
+Bundle::setHash(const Types::Hash& hash) {
   hash_ = hash;
 }
 
 void
 Bundle::addTransaction(const Transaction& transaction, int32_t signatureMessageLength) {
+  addTransaction(Transaction{ transaction }, signatureMessageLength);
+}
+
+void
+Bundle::addTransaction(Transaction&& transaction, int32_t signatureMessageLength) {
   if (empty()) {
     hash_ = transaction.getBundle();
   }
 
-  transactions_.push_back(transaction);
+  if (signatureMessageLength > 1) {
+    transactions_.reserve(transactions_.size() + signatureMessageLength);
+  }
+
+  transactions_.push_back(std::move(transaction));
 
   if (signatureMessageLength > 1) {
-    Transaction signatureTransaction = { transaction.getAddress(), 0, transaction.getTag(),
-                                         transaction.getTimestamp() };
+    const auto& first                = transactions_.back();
+    Transaction signatureTransaction = { first.getAddress(), 0, first.getTag(),
+                                         first.getTimestamp() };
 
     for (int i = 1; i < signatureMessageLength; i++) {
       transactions_.push_back(signatureTransaction);
@@ -89,9 +101,15 @@ Bundle::addTransaction(const Transaction& transaction, int32_t signatureMessageL
   }
 }
 
+void
+Bundle::reserve(std::size_t nbTransactions) {
+  transactions_.reserve(nbTransactions);
+}
+
 void
 Bundle::generateHash() {
-  Crypto::Kerl k;
+  Crypto::Kerl  k;
+  Types::Trytes essence(BundleEssenceLength, '9');
 
   for (std::size_t i = 0; i < transactions_.size(); i++) {
     auto& trx = transactions_[i];
@@ -99,18 +117,8 @@ Bundle::generateHash() {
     trx.setCurrentIndex(i);
     trx.setLastIndex(transactions_.size() - 1);
 
-    auto value = Types::tritsToTrytes(Types::intToTrits(trx.getValue(), SeedLength));
-    auto timestamp =
-        Types::tritsToTrytes(Types::intToTrits(trx.getTimestamp(), TryteAlphabetLength));
-    auto currentIndex =
-        Types::tritsToTrytes(Types::intToTrits(trx.getCurrentIndex(), TryteAlphabetLength));
-    auto lastIndex =
-        Types::tritsToTrytes(Types::intToTrits(trx.getLastIndex(), TryteAlphabetLength));
-
-    auto bytes = Types::trytesToBytes(trx.getAddress().toTrytes() + value +
-                                      trx.getObsoleteTag().toTrytesWithPadding() + timestamp +
-                                      currentIndex + lastIndex);
-    k.absorb(bytes);
+    trx.bundleEssenceToTrytes(&essence[0]);
+    k.absorb(Types::trytesToBytes(essence));
   }
 
   std::vector<uint8_t> hash(ByteHashLength);
@@ -169,6 +177,53 @@ Bundle::addTrytes(const std::vector<Types::Trytes>& signatureFragments) {
   }
 }
 
+void
+Bundle::readMessage(std::size_t index, std::ostream& out) const {
+  if (index >= transactions_.size()) {
+    throw Errors::IllegalState("Invalid transaction index");
+  }
+
+  //! the message spans the following transactions of the same address carrying no value
+  const auto& address = transactions_[index].getAddress();
+  auto        last    = index;
+  while (last + 1 < transactions_.size() && transactions_[last + 1].getValue() == 0 &&
+         transactions_[last + 1].getAddress() == address) {
+    ++last;
+  }
+
+  //! fragments have an odd length: a tryte may be carried over to the next fragment
+  char        trytes[MaxTrxMsgLength + 1];
+  char        chars[(MaxTrxMsgLength + 1) / 2];
+  std::size_t pending = 0;
+
+  for (auto i = index; i <= last; ++i) {
+    const auto& fragment = transactions_[i].getSignatureFragments();
+    auto        length   = std::min<std::size_t>(fragment.size(), MaxTrxMsgLength);
+
+    if (i == last) {
+      const auto end = fragment.find_last_not_of('9', length ? length - 1 : 0);
+      length         = (end == std::string::npos || length == 0) ? 0 : end + 1;
+    }
+
+    std::copy(fragment.begin(), fragment.begin() + length, trytes + pending);
+    length += pending;
+    pending = length % 2;
+
+    //! a message ending on the first tryte of a character lost its '9' to the padding
+    if (i == last && pending) {
+      trytes[length++] = '9';
+      pending          = 0;
+    }
+
+    Types::trytesToString(trytes, length - pending, chars);
+    out.write(chars, (length - pending) / 2);
+
+    if (pending) {
+      trytes[0] = trytes[length - 1];
+    }
+  }
+}
+
 std::vector<int8_t>
 Bundle::normalizedBundle(const Types::Trytes& bundleHash) {
   std::vector<int8_t> normalizedBundle(SeedLength, 0);
@@ -0,0 +1,203 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <algorithm>
+
+#include <iota/constants.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <iota/models/bundle_builder.hpp>
+#include <iota/models/transaction.hpp>
+#include <iota/types/trinary.hpp>
+#include <iota/utils/stop_watch.hpp>
+
+namespace IOTA {
+
+namespace Models {
+
+constexpr std::size_t BundleBuilder::NoMessage;
+
+BundleBuilder::BundleBuilder(std::size_t nbTransactions)
+    : timestamp_(Utils::StopWatch::now().count()) {
+  reserve(nbTransactions);
+}
+
+BundleBuilder::BundleBuilder(const Bundle& bundle, const std::vector<Types::Trytes>& fragments)
+    : bundle_(bundle), timestamp_(Utils::StopWatch::now().count()) {
+  //! the fragments are held by the transactions themselves
+  bundle_.addTrytes(fragments);
+  slices_.assign(bundle_.getTransactions().size(), { NoMessage, 0 });
+
+  for (const auto& trx : bundle_.getTransactions()) {
+    if (trx.getValue() > 0) {
+      totalValue_ += trx.getValue();
+    }
+  }
+}
+
+void
+BundleBuilder::reserve(std::size_t nbTransactions) {
+  bundle_.reserve(nbTransactions);
+  slices_.reserve(nbTransactions);
+}
+
+void
+BundleBuilder::addTransfer(Transfer&& transfer) {
+  addMessage(transfer.getAddress(), transfer.getValue(), std::move(transfer.getMessage()),
+             transfer.getTag());
+}
+
+void
+BundleBuilder::addTransfer(const Transfer& transfer) {
+  addTransfer(Transfer{ transfer });
+}
+
+void
+BundleBuilder::addTransfer(const Address& address, int64_t value, std::istream& message,
+                           const Tag& tag) {
+  Types::Trytes trytes;
+  char          buffer[4096];
+
+  //! encode each block straight after the trytes already read
+  while (message.read(buffer, sizeof(buffer)) || message.gcount() > 0) {
+    const auto count  = static_cast<std::size_t>(message.gcount());
+    const auto offset = trytes.size();
+
+    trytes.resize(offset + 2 * count);
+    Types::stringToTrytes(buffer, count, &trytes[offset]);
+  }
+
+  if (message.bad()) {
+    throw Errors::IllegalState("Could not read message");
+  }
+
+  addMessage(address, value, std::move(trytes), tag);
+}
+
+void
+BundleBuilder::addMessage(const Address& address, int64_t value, Types::Trytes&& message,
+                          const Tag& tag) {
+  const auto nbFragments =
+      std::max<std::size_t>((message.size() + MaxTrxMsgLength - 1) / MaxTrxMsgLength, 1);
+
+  //! each transaction carries the next slice of the message
+  const auto index = message.empty() ? NoMessage : messages_.size();
+  for (std::size_t i = 0; i < nbFragments; ++i) {
+    slices_.push_back({ index, i * MaxTrxMsgLength });
+  }
+  if (!message.empty()) {
+    messages_.push_back(std::move(message));
+  }
+
+  bundle_.addTransaction(Transaction{ address, value, tag, timestamp_ },
+                         static_cast<int32_t>(nbFragments));
+  totalValue_ += value;
+}
+
+void
+BundleBuilder::addInput(const Address& input, const Tag& tag) {
+  const auto security = std::max<int32_t>(input.getSecurity(), 1);
+
+  slices_.insert(slices_.end(), security, { NoMessage, 0 });
+  bundle_.addTransaction(Transaction{ input, -input.getBalance(), tag, timestamp_ }, security);
+}
+
+void
+BundleBuilder::addOutput(const Address& address, int64_t value, const Tag& tag) {
+  slices_.push_back({ NoMessage, 0 });
+  bundle_.addTransaction(Transaction{ address, value, tag, timestamp_ });
+  totalValue_ += value;
+}
+
+void
+BundleBuilder::finalize() {
+  bundle_.finalize();
+}
+
+void
+BundleBuilder::applyMessages() {
+  auto& trxs = bundle_.getTransactions();
+
+  for (std::size_t i = 0; i < trxs.size(); ++i) {
+    Types::Trytes fragment(MaxTrxMsgLength, '9');
+
+    if (i < slices_.size() && slices_[i].message != NoMessage) {
+      const auto& message = messages_[slices_[i].message];
+      const auto  offset  = std::min(slices_[i].offset, message.size());
+      const auto  length  = std::min<std::size_t>(message.size() - offset, MaxTrxMsgLength);
+
+      std::copy(message.begin() + offset, message.begin() + offset + length, fragment.begin());
+    }
+
+    trxs[i].setSignatureFragments(fragment);
+    trxs[i].setTrunkTransaction(EmptyHash);
+    trxs[i].setBranchTransaction(EmptyHash);
+    trxs[i].setNonce(EmptyNonce);
+  }
+}
+
+std::vector<Types::Trytes>
+BundleBuilder::toTrytes() const {
+  const auto&                trxs = bundle_.getTransactions();
+  std::vector<Types::Trytes> trytes;
+
+  trytes.reserve(trxs.size());
+  for (std::size_t i = 0; i < trxs.size(); ++i) {
+    trytes.emplace_back(TrxTrytesLength, '9');
+    auto out = &trytes.back()[0];
+
+    trxs[i].toTrytes(out);
+
+    //! the message slice replaces the signature message fragment, padded with '9'
+    if (i < slices_.size() && slices_[i].message != NoMessage) {
+      const auto& message = messages_[slices_[i].message];
+      const auto  offset  = std::min(slices_[i].offset, message.size());
+      const auto  length  = std::min<std::size_t>(message.size() - offset, MaxTrxMsgLength);
+
+      std::copy(message.begin() + offset, message.begin() + offset + length, out);
+      std::fill(out + length, out + MaxTrxMsgLength, '9');
+    }
+  }
+
+  return trytes;
+}
+
+int64_t
+BundleBuilder::getTotalValue() const {
+  return totalValue_;
+}
+
+const Bundle&
+BundleBuilder::getBundle() const {
+  return bundle_;
+}
+
+Bundle&
+BundleBuilder::getBundle() {
+  return bundle_;
+}
+
+}  // namespace Models
+
+}  // namespace IOTA
@@ -0,0 +1,277 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <algorithm>
+
+#include <iota/errors/illegal_state.hpp>
+#include <iota/models/compact_transaction.hpp>
+#include <iota/models/transaction.hpp>
+#include <iota/models/transaction_view.hpp>
+
+namespace IOTA {
+
+namespace Models {
+
+constexpr std::size_t CompactTransaction::PackedTrxLength;
+constexpr std::size_t CompactTransaction::PackedHashLength;
+constexpr uint8_t     CompactTransaction::SerializationVersion;
+constexpr std::size_t CompactTransaction::SerializedLength;
+
+CompactTransaction::CompactTransaction() {
+  //! empty hash and null transaction, packed without a trytes round trip
+  Types::nullTrytesToPackedTrits(HashLength, hash_.data());
+  Types::nullTrytesToPackedTrits(TrxTrytesLength, trx_.data());
+}
+
+CompactTransaction::CompactTransaction(const Types::Trytes& trytes)
+    : CompactTransaction(TransactionView{ trytes }) {
+}
+
+CompactTransaction::CompactTransaction(const TransactionView& view) {
+  init(view.toTrytes(), view.getHash());
+}
+
+CompactTransaction::CompactTransaction(const Transaction& transaction) {
+  Types::Trytes trytes(TrxTrytesLength, '9');
+  transaction.toTrytes(&trytes[0]);
+
+  if (transaction.getHash().size() == HashLength) {
+    init(trytes, transaction.getHash());
+  } else {
+    const TransactionView view{ std::move(trytes) };
+    init(view.toTrytes(), view.getHash());
+  }
+}
+
+void
+CompactTransaction::init(const Types::Trytes& trytes, const Types::Trytes& hash) {
+  if (trytes.size() != TrxTrytesLength || !Types::isValidTrytes(trytes)) {
+    throw Errors::IllegalState("Invalid transaction trytes");
+  }
+
+  if (!Types::isValidHash(hash)) {
+    throw Errors::IllegalState("Invalid transaction hash");
+  }
+
+  Types::trytesToPackedTrits(trytes.data(), TrxTrytesLength, trx_.data());
+  Types::trytesToPackedTrits(hash.data(), HashLength, hash_.data());
+  decodeIntegers();
+}
+
+void
+CompactTransaction::decodeIntegers() {
+  value_                         = intField(TransactionView::ValueOffset);
+  timestamp_                     = intField(TransactionView::TimestampOffset);
+  currentIndex_                  = intField(TransactionView::CurrentIndexOffset);
+  lastIndex_                     = intField(TransactionView::LastIndexOffset);
+  attachmentTimestamp_           = intField(TransactionView::AttachmentTimestampOffset);
+  attachmentTimestampLowerBound_ = intField(TransactionView::AttachmentTimestampLowerBoundOffset);
+  attachmentTimestampUpperBound_ = intField(TransactionView::AttachmentTimestampUpperBoundOffset);
+}
+
+Types::Trytes
+CompactTransaction::toTrytes() const {
+  Types::Trytes trytes(TrxTrytesLength, '9');
+  toTrytes(&trytes[0]);
+
+  return trytes;
+}
+
+void
+CompactTransaction::toTrytes(char* trytes) const {
+  Types::packedTritsToTrytes(trx_.data(), 0, TrxTrytesLength, trytes);
+}
+
+Transaction
+CompactTransaction::toTransaction() const {
+  return Transaction{ TransactionView{ toTrytes(), getHash() } };
+}
+
+void
+CompactTransaction::serialize(uint8_t* bytes) const {
+  bytes[0] = SerializationVersion;
+  std::copy(hash_.begin(), hash_.end(), bytes + 1);
+  std::copy(trx_.begin(), trx_.end(), bytes + 1 + PackedHashLength);
+}
+
+std::vector<uint8_t>
+CompactTransaction::serialize() const {
+  std::vector<uint8_t> bytes(SerializedLength);
+  serialize(bytes.data());
+
+  return bytes;
+}
+
+CompactTransaction
+CompactTransaction::deserialize(const uint8_t* bytes, std::size_t length) {
+  if (length < SerializedLength) {
+    throw Errors::IllegalState("Invalid compact transaction length");
+  }
+
+  if (bytes[0] != SerializationVersion) {
+    throw Errors::IllegalState("Unsupported compact transaction version");
+  }
+
+  //! 5 trits per byte can encode at most 3^5 - 1 = 242
+  const auto data = bytes + 1;
+  const auto end  = data + PackedHashLength + PackedTrxLength;
+  if (std::find_if(data, end, [](uint8_t byte) { return byte > 242; }) != end) {
+    throw Errors::IllegalState("Invalid compact transaction trits");
+  }
+
+  CompactTransaction trx;
+  std::copy(data, data + PackedHashLength, trx.hash_.begin());
+  std::copy(data + PackedHashLength, end, trx.trx_.begin());
+  trx.decodeIntegers();
+
+  return trx;
+}
+
+CompactTransaction
+CompactTransaction::deserialize(const std::vector<uint8_t>& bytes) {
+  return deserialize(bytes.data(), bytes.size());
+}
+
+bool
+CompactTransaction::isValid() const {
+  const auto& offset = TransactionView::ValidityChunkOffset;
+
+  return field(offset) == Types::Trytes(offset.second - offset.first, '9');
+}
+
+bool
+CompactTransaction::isTailTransaction() const {
+  return getCurrentIndex() == 0;
+}
+
+Types::Trytes
+CompactTransaction::getHash() const {
+  Types::Trytes hash(HashLength, '9');
+  Types::packedTritsToTrytes(hash_.data(), 0, HashLength, &hash[0]);
+
+  return hash;
+}
+
+Types::Trytes
+CompactTransaction::getSignatureFragments() const {
+  return field(TransactionView::SignatureFragmentsOffset);
+}
+
+Models::Address
+CompactTransaction::getAddress() const {
+  return field(TransactionView::AddressOffset);
+}
+
+int64_t
+CompactTransaction::getValue() const {
+  return value_;
+}
+
+Models::Tag
+CompactTransaction::getObsoleteTag() const {
+  return field(TransactionView::ObsoleteTagOffset);
+}
+
+int64_t
+CompactTransaction::getTimestamp() const {
+  return timestamp_;
+}
+
+int64_t
+CompactTransaction::getCurrentIndex() const {
+  return currentIndex_;
+}
+
+int64_t
+CompactTransaction::getLastIndex() const {
+  return lastIndex_;
+}
+
+Types::Trytes
+CompactTransaction::getBundle() const {
+  return field(TransactionView::BundleOffset);
+}
+
+Types::Trytes
+CompactTransaction::getTrunkTransaction() const {
+  return field(TransactionView::TrunkOffset);
+}
+
+Types::Trytes
+CompactTransaction::getBranchTransaction() const {
+  return field(TransactionView::BranchOffset);
+}
+
+Models::Tag
+CompactTransaction::getTag() const {
+  return field(TransactionView::TagOffset);
+}
+
+int64_t
+CompactTransaction::getAttachmentTimestamp() const {
+  return attachmentTimestamp_;
+}
+
+int64_t
+CompactTransaction::getAttachmentTimestampLowerBound() const {
+  return attachmentTimestampLowerBound_;
+}
+
+int64_t
+CompactTransaction::getAttachmentTimestampUpperBound() const {
+  return attachmentTimestampUpperBound_;
+}
+
+Types::Trytes
+CompactTransaction::getNonce() const {
+  return field(TransactionView::NonceOffset);
+}
+
+bool
+CompactTransaction::operator==(const CompactTransaction& rhs) const {
+  return hash_ == rhs.hash_ && trx_ == rhs.trx_;
+}
+
+bool
+CompactTransaction::operator!=(const CompactTransaction& rhs) const {
+  return !operator==(rhs);
+}
+
+Types::Trytes
+CompactTransaction::field(const std::pair<int, int>& offset) const {
+  Types::Trytes trytes(offset.second - offset.first, '9');
+  Types::packedTritsToTrytes(trx_.data(), offset.first, trytes.size(), &trytes[0]);
+
+  return trytes;
+}
+
+int64_t
+CompactTransaction::intField(const std::pair<int, int>& offset) const {
+  return Types::trytesToInt(field(offset), 0, offset.second - offset.first);
+}
+
+}  // namespace Models
+
+}  // namespace IOTA
@@ -0,0 +1,74 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <iota/constants.hpp>
+#include <iota/models/multisig_address_builder.hpp>
+#include <iota/types/trinary.hpp>
+
+namespace IOTA {
+
+namespace Models {
+
+void
+MultisigAddressBuilder::absorbDigests(const std::vector<uint8_t>& digests) {
+  security_ += digests.size() / ByteHashLength;
+  k_.absorb(digests);
+}
+
+Address
+MultisigAddressBuilder::finalize() {
+  std::vector<uint8_t> addressBytes(ByteHashLength);
+  k_.squeeze(addressBytes);
+
+  return { Types::bytesToTrytes(addressBytes), 0, 0, security_, Address::MULTISIG };
+}
+
+int32_t
+MultisigAddressBuilder::getSecurity() const {
+  return security_;
+}
+
+bool
+MultisigAddressBuilder::validate(const Address&                           address,
+                                 const std::vector<std::vector<uint8_t>>& digests) {
+  if (address.getType() != Address::MULTISIG) {
+    return false;
+  }
+
+  Crypto::Kerl k;
+
+  for (const auto& digest : digests) {
+    k.absorb(digest);
+  }
+
+  std::vector<uint8_t> addressBytes(ByteHashLength);
+  k.squeeze(addressBytes);
+
+  return address == Types::bytesToTrytes(addressBytes);
+}
+
+}  // namespace Models
+
+}  // namespace IOTA
@@ -23,6 +23,8 @@
 //
 //
 
+#include <algorithm>
+
 #include <iota/constants.hpp>
 #include <iota/crypto/curl.hpp>
 #include <iota/errors/illegal_state.hpp>
@@ -33,6 +35,38 @@ namespace IOTA {
 
 namespace Models {
 
+//! Size in trytes of the value field, validity chunk included
+static constexpr std::size_t ValueTrytesLength = 27;
+//! Size in trytes of the timestamp, index and attachment timestamp fields
+static constexpr std::size_t IntTrytesLength = 9;
+
+//! copies field into trytes[0, length[, right padded with '9', returns pointer past the field
+template <typename Field>
+static char*
+writeField(char* trytes, const Field& field, std::size_t length) {
+  const auto size = std::min<std::size_t>(field.size(), length);
+
+  std::copy(field.begin(), field.begin() + size, trytes);
+  std::fill(trytes + size, trytes + length, '9');
+
+  return trytes + length;
+}
+
+//! encodes value into trytes[0, length[, returns pointer past the field
+static char*
+writeInt(char* trytes, const int64_t& value, std::size_t length) {
+  Types::intToTrytes(value, trytes, length);
+
+  return trytes + length;
+}
+
+//! appends the length trytes encoding value to trytes
+static void
+appendInt(Types::Trytes& trytes, const int64_t& value, std::size_t length) {
+  trytes.resize(trytes.size() + length);
+  Types::intToTrytes(value, &trytes[trytes.size() - length], length);
+}
+
 const std::pair<int, int> Transaction::SignatureFragmentsOffset            = { 0, 2187 };
 const std::pair<int, int> Transaction::AddressOffset                       = { 2187, 2268 };
 const std::pair<int, int> Transaction::ValueOffset                         = { 6804, 6837 };
@@ -54,11 +88,35 @@ Transaction::Transaction(const Types::Trytes& trytes) {
   initFromTrytes(trytes);
 }
 
+Transaction::Transaction(const TransactionView& view) {
+  //! same validity check as initFromTrytes
+  if (!view.isValid()) {
+    return;
+  }
+
+  setHash(view.getHash());
+  setSignatureFragments(view.getSignatureFragments());
+  setAddress(view.getAddress());
+  setValue(view.getValue());
+  setObsoleteTag(view.getObsoleteTag());
+  setTag(view.getTag());
+  setTimestamp(view.getTimestamp());
+  setAttachmentTimestamp(view.getAttachmentTimestamp());
+  setAttachmentTimestampLowerBound(view.getAttachmentTimestampLowerBound());
+  setAttachmentTimestampUpperBound(view.getAttachmentTimestampUpperBound());
+  setCurrentIndex(view.getCurrentIndex());
+  setLastIndex(view.getLastIndex());
+  setBundle(view.getBundle());
+  setTrunkTransaction(view.getTrunkTransaction());
+  setBranchTransaction(view.getBranchTransaction());
+  setNonce(view.getNonce());
+}
+
 Transaction::Transaction(const Types::Trytes& signatureFragments, int64_t currentIndex,
-                         int64_t lastIndex, const Types::Trytes& nonce, const Types::Trytes& hash,
-                         int64_t timestamp, const Types::Trytes& trunkTransaction,
-                         const Types::Trytes& branchTransaction, const Models::Address& address,
-                         int64_t value, const Types::Trytes& bundle, const Models::Tag& tag,
+                         int64_t lastIndex, const Types::Trytes& nonce, const Types::Hash& hash,
+                         int64_t timestamp, const Types::Hash& trunkTransaction,
+                         const Types::Hash& branchTransaction, const Models::Address& address,
+                         int64_t value, const Types::Hash& bundle, const Models::Tag& tag,
                          int64_t attachmentTimestamp, int64_t attachmentTimestampLowerBound,
                          int64_t attachmentTimestampUpperBound)
     : hash_(hash),
@@ -102,13 +160,13 @@ Transaction::isTailTransaction() const {
   return getCurrentIndex() == 0;
 }
 
-const Types::Trytes&
+const Types::Hash&
 Transaction::getHash() const {
   return hash_;
 }
 
 void
-Transaction::setHash(const Types::Trytes& hash) {
+Transaction::setHash(const Types::Hash& hash) {
   hash_ = hash;
 }
 
@@ -222,33 +280,33 @@ Transaction::setLastIndex(int64_t lastIndex) {
   lastIndex_ = lastIndex;
 }
 
-const Types::Trytes&
+const Types::Hash&
 Transaction::getBundle() const {
   return bundle_;
 }
 
 void
-Transaction::setBundle(const Types::Trytes& bundle) {
+Transaction::setBundle(const Types::Hash& bundle) {
   bundle_ = bundle;
 }
 
-const Types::Trytes&
+const Types::Hash&
 Transaction::getTrunkTransaction() const {
   return trunkTransaction_;
 }
 
 void
-Transaction::setTrunkTransaction(const Types::Trytes& trunkTransaction) {
+Transaction::setTrunkTransaction(const Types::Hash& trunkTransaction) {
   trunkTransaction_ = trunkTransaction;
 }
 
-const Types::Trytes&
+const Types::Hash&
 Transaction::getBranchTransaction() const {
   return branchTransaction_;
 }
 
 void
-Transaction::setBranchTransaction(const Types::Trytes& branchTransaction) {
+Transaction::setBranchTransaction(const Types::Hash& branchTransaction) {
   branchTransaction_ = branchTransaction;
 }
 
@@ -284,24 +342,55 @@ Transaction::operator!=(const Transaction& rhs) const {
 
 Types::Trytes
 Transaction::toTrytes() const {
-  auto value     = Types::tritsToTrytes(Types::intToTrits(getValue(), SeedLength));
-  auto timestamp = Types::tritsToTrytes(Types::intToTrits(getTimestamp(), TryteAlphabetLength));
-  auto currentIndex =
-      Types::tritsToTrytes(Types::intToTrits(getCurrentIndex(), TryteAlphabetLength));
-  auto lastIndex = Types::tritsToTrytes(Types::intToTrits(getLastIndex(), TryteAlphabetLength));
-  auto attachmentTimestamp =
-      Types::tritsToTrytes(Types::intToTrits(getAttachmentTimestamp(), TryteAlphabetLength));
-  auto attachmentTimestampLowerBound = Types::tritsToTrytes(
-      Types::intToTrits(getAttachmentTimestampLowerBound(), TryteAlphabetLength));
-  auto attachmentTimestampUpperBound = Types::tritsToTrytes(
-      Types::intToTrits(getAttachmentTimestampUpperBound(), TryteAlphabetLength));
-  auto tag = getTag().empty() ? getObsoleteTag() : getTag();
-
-  return getSignatureFragments() + getAddress().toTrytes() + value +
-         getObsoleteTag().toTrytesWithPadding() + timestamp + currentIndex + lastIndex +
-         getBundle() + getTrunkTransaction() + getBranchTransaction() + tag.toTrytesWithPadding() +
-         attachmentTimestamp + attachmentTimestampLowerBound + attachmentTimestampUpperBound +
-         getNonce();
+  const auto& tag = getTag().empty() ? getObsoleteTag() : getTag();
+
+  //! variable-size fields are appended as is, which keeps the representation of incomplete
+  //! transactions unchanged
+  Types::Trytes trytes;
+  trytes.reserve(TrxTrytesLength);
+  trytes.append(getSignatureFragments()).append(getAddress().toTrytes());
+  appendInt(trytes, getValue(), ValueTrytesLength);
+  trytes.append(getObsoleteTag().toTrytesWithPadding());
+  appendInt(trytes, getTimestamp(), IntTrytesLength);
+  appendInt(trytes, getCurrentIndex(), IntTrytesLength);
+  appendInt(trytes, getLastIndex(), IntTrytesLength);
+  trytes.append(getBundle().data(), getBundle().size());
+  trytes.append(getTrunkTransaction().data(), getTrunkTransaction().size());
+  trytes.append(getBranchTransaction().data(), getBranchTransaction().size());
+  trytes.append(tag.toTrytesWithPadding());
+  appendInt(trytes, getAttachmentTimestamp(), IntTrytesLength);
+  appendInt(trytes, getAttachmentTimestampLowerBound(), IntTrytesLength);
+  appendInt(trytes, getAttachmentTimestampUpperBound(), IntTrytesLength);
+  trytes.append(getNonce());
+
+  return trytes;
+}
+
+void
+Transaction::toTrytes(char* trytes) const {
+  const auto& tag = getTag().empty() ? getObsoleteTag() : getTag();
+
+  trytes = writeField(trytes, getSignatureFragments(), MaxTrxMsgLength);
+  bundleEssenceToTrytes(trytes);
+  trytes += BundleEssenceLength;
+  trytes = writeField(trytes, getBundle(), HashLength);
+  trytes = writeField(trytes, getTrunkTransaction(), HashLength);
+  trytes = writeField(trytes, getBranchTransaction(), HashLength);
+  trytes = writeField(trytes, tag.toTrytesWithPadding(), TagLength);
+  trytes = writeInt(trytes, getAttachmentTimestamp(), IntTrytesLength);
+  trytes = writeInt(trytes, getAttachmentTimestampLowerBound(), IntTrytesLength);
+  trytes = writeInt(trytes, getAttachmentTimestampUpperBound(), IntTrytesLength);
+  writeField(trytes, getNonce(), NonceLength);
+}
+
+void
+Transaction::bundleEssenceToTrytes(char* trytes) const {
+  trytes = writeField(trytes, getAddress().toTrytes(), AddressLength);
+  trytes = writeInt(trytes, getValue(), ValueTrytesLength);
+  trytes = writeField(trytes, getObsoleteTag().toTrytesWithPadding(), TagLength);
+  trytes = writeInt(trytes, getTimestamp(), IntTrytesLength);
+  trytes = writeInt(trytes, getCurrentIndex(), IntTrytesLength);
+  writeInt(trytes, getLastIndex(), IntTrytesLength);
 }
 
 void
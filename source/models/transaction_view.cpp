@@ -0,0 +1,191 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <iota/constants.hpp>
+#include <iota/crypto/curl.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <iota/models/transaction_view.hpp>
+#include <iota/types/trinary.hpp>
+
+namespace IOTA {
+
+namespace Models {
+
+const std::pair<int, int> TransactionView::SignatureFragmentsOffset            = { 0, 2187 };
+const std::pair<int, int> TransactionView::AddressOffset                       = { 2187, 2268 };
+const std::pair<int, int> TransactionView::ValueOffset                         = { 2268, 2279 };
+const std::pair<int, int> TransactionView::ValidityChunkOffset                 = { 2279, 2295 };
+const std::pair<int, int> TransactionView::ObsoleteTagOffset                   = { 2295, 2322 };
+const std::pair<int, int> TransactionView::TimestampOffset                     = { 2322, 2331 };
+const std::pair<int, int> TransactionView::CurrentIndexOffset                  = { 2331, 2340 };
+const std::pair<int, int> TransactionView::LastIndexOffset                     = { 2340, 2349 };
+const std::pair<int, int> TransactionView::BundleOffset                        = { 2349, 2430 };
+const std::pair<int, int> TransactionView::TrunkOffset                         = { 2430, 2511 };
+const std::pair<int, int> TransactionView::BranchOffset                        = { 2511, 2592 };
+const std::pair<int, int> TransactionView::TagOffset                           = { 2592, 2619 };
+const std::pair<int, int> TransactionView::AttachmentTimestampOffset           = { 2619, 2628 };
+const std::pair<int, int> TransactionView::AttachmentTimestampLowerBoundOffset = { 2628, 2637 };
+const std::pair<int, int> TransactionView::AttachmentTimestampUpperBoundOffset = { 2637, 2646 };
+const std::pair<int, int> TransactionView::NonceOffset                         = { 2646, 2673 };
+
+TransactionView::TransactionView(const Types::Trytes& trytes)
+    : TransactionView(Types::Trytes(trytes)) {
+}
+
+TransactionView::TransactionView(Types::Trytes&& trytes) : trytes_(std::move(trytes)) {
+  if (trytes_.size() != TrxTrytesLength) {
+    throw Errors::IllegalState("Invalid transaction trytes");
+  }
+}
+
+TransactionView::TransactionView(Types::Trytes&& trytes, const Types::Trytes& hash)
+    : TransactionView(std::move(trytes)) {
+  if (!hash.empty()) {
+    hash_.set(hash);
+  }
+}
+
+const Types::Trytes&
+TransactionView::toTrytes() const {
+  return trytes_;
+}
+
+bool
+TransactionView::isValid() const {
+  for (int i = ValidityChunkOffset.first; i < ValidityChunkOffset.second; i++) {
+    if (trytes_[i] != '9') {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool
+TransactionView::isTailTransaction() const {
+  return getCurrentIndex() == 0;
+}
+
+const Types::Trytes&
+TransactionView::getHash() const {
+  return hash_.get([this]() {
+    auto hash = Types::Trits(TritHashLength);
+
+    Crypto::Curl curl;
+    curl.absorb(Types::trytesToTrits(trytes_));
+    curl.squeeze(hash);
+
+    return Types::tritsToTrytes(hash);
+  });
+}
+
+Types::Trytes
+TransactionView::getSignatureFragments() const {
+  return field(SignatureFragmentsOffset);
+}
+
+Models::Address
+TransactionView::getAddress() const {
+  return field(AddressOffset);
+}
+
+int64_t
+TransactionView::getValue() const {
+  return intField(ValueOffset);
+}
+
+Models::Tag
+TransactionView::getObsoleteTag() const {
+  return field(ObsoleteTagOffset);
+}
+
+int64_t
+TransactionView::getTimestamp() const {
+  return intField(TimestampOffset);
+}
+
+int64_t
+TransactionView::getCurrentIndex() const {
+  return intField(CurrentIndexOffset);
+}
+
+int64_t
+TransactionView::getLastIndex() const {
+  return intField(LastIndexOffset);
+}
+
+Types::Trytes
+TransactionView::getBundle() const {
+  return field(BundleOffset);
+}
+
+Types::Trytes
+TransactionView::getTrunkTransaction() const {
+  return field(TrunkOffset);
+}
+
+Types::Trytes
+TransactionView::getBranchTransaction() const {
+  return field(BranchOffset);
+}
+
+Models::Tag
+TransactionView::getTag() const {
+  return field(TagOffset);
+}
+
+int64_t
+TransactionView::getAttachmentTimestamp() const {
+  return intField(AttachmentTimestampOffset);
+}
+
+int64_t
+TransactionView::getAttachmentTimestampLowerBound() const {
+  return intField(AttachmentTimestampLowerBoundOffset);
+}
+
+int64_t
+TransactionView::getAttachmentTimestampUpperBound() const {
+  return intField(AttachmentTimestampUpperBoundOffset);
+}
+
+Types::Trytes
+TransactionView::getNonce() const {
+  return field(NonceOffset);
+}
+
+Types::Trytes
+TransactionView::field(const std::pair<int, int>& offset) const {
+  return trytes_.substr(offset.first, offset.second - offset.first);
+}
+
+int64_t
+TransactionView::intField(const std::pair<int, int>& offset) const {
+  return Types::trytesToInt(trytes_, offset.first, offset.second - offset.first);
+}
+
+}  // namespace Models
+
+}  // namespace IOTA
@@ -63,6 +63,11 @@ Transfer::getMessage() const {
   return message_;
 }
 
+Types::Trytes&
+Transfer::getMessage() {
+  return message_;
+}
+
 void
 Transfer::setMessage(const Types::Trytes& message) {
   if (!Types::isValidTrytes(message)) {
@@ -0,0 +1,158 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <algorithm>
+#include <cstring>
+
+#include <iota/errors/illegal_state.hpp>
+#include <iota/types/hash.hpp>
+
+namespace IOTA {
+
+namespace Types {
+
+Hash::Hash() : size_(0) {
+  trytes_.fill(0);
+}
+
+Hash::Hash(const Types::Trytes& trytes) : Hash() {
+  if (trytes.size() > HashLength) {
+    throw Errors::IllegalState("Invalid hash length");
+  }
+
+  std::copy(trytes.begin(), trytes.end(), trytes_.begin());
+  size_ = static_cast<uint8_t>(trytes.size());
+}
+
+Hash::Hash(const char* trytes) : Hash(Types::Trytes(trytes)) {
+}
+
+Types::Trytes
+Hash::toTrytes() const {
+  return Types::Trytes(data(), size());
+}
+
+Hash::operator Types::Trytes() const {
+  return toTrytes();
+}
+
+bool
+Hash::empty() const {
+  return size_ == 0;
+}
+
+std::size_t
+Hash::size() const {
+  return size_;
+}
+
+const char*
+Hash::data() const {
+  return trytes_.data();
+}
+
+const char*
+Hash::begin() const {
+  return data();
+}
+
+const char*
+Hash::end() const {
+  return data() + size();
+}
+
+char
+Hash::operator[](std::size_t index) const {
+  return trytes_[index];
+}
+
+uint64_t
+Hash::hashCode() const {
+  const std::size_t length = std::min<std::size_t>(size_, 13);
+  uint64_t          res    = size_;
+
+  for (std::size_t i = 0; i < length; ++i) {
+    const char tryte = trytes_[i];
+
+    res = res * TryteAlphabetLength + (tryte == '9' ? 0 : static_cast<uint8_t>(tryte - 'A' + 1));
+  }
+
+  return res;
+}
+
+bool
+Hash::operator==(const Hash& rhs) const {
+  //! unused trytes are zero-filled, so the whole storage can be compared
+  return size_ == rhs.size_ && std::memcmp(trytes_.data(), rhs.trytes_.data(), HashLength) == 0;
+}
+
+bool
+Hash::operator!=(const Hash& rhs) const {
+  return !operator==(rhs);
+}
+
+bool
+Hash::operator<(const Hash& rhs) const {
+  return std::lexicographical_compare(begin(), end(), rhs.begin(), rhs.end());
+}
+
+bool
+Hash::operator==(const Types::Trytes& rhs) const {
+  return size() == rhs.size() && std::equal(begin(), end(), rhs.begin());
+}
+
+bool
+Hash::operator!=(const Types::Trytes& rhs) const {
+  return !operator==(rhs);
+}
+
+bool
+Hash::operator==(const char* rhs) const {
+  return size() == std::strlen(rhs) && std::equal(begin(), end(), rhs);
+}
+
+bool
+Hash::operator!=(const char* rhs) const {
+  return !operator==(rhs);
+}
+
+bool
+operator==(const Types::Trytes& lhs, const Hash& rhs) {
+  return rhs == lhs;
+}
+
+bool
+operator!=(const Types::Trytes& lhs, const Hash& rhs) {
+  return rhs != lhs;
+}
+
+std::ostream&
+operator<<(std::ostream& os, const Hash& hash) {
+  return os.write(hash.data(), hash.size());
+}
+
+}  // namespace Types
+
+}  // namespace IOTA
@@ -88,18 +88,62 @@ isValidHash(const Trytes& s) {
   return s.length() == HashLength && isValidTrytes(s);
 }
 
+//! the 2 trytes encoding each byte value
+static const std::array<std::array<char, 2>, 256>&
+charTrytes() {
+  static const auto table = [] {
+    std::array<std::array<char, 2>, 256> trytes;
+
+    for (std::size_t c = 0; c < trytes.size(); ++c) {
+      trytes[c] = { { TryteAlphabet[c % TryteAlphabetLength],
+                      TryteAlphabet[c / TryteAlphabetLength] } };
+    }
+    return trytes;
+  }();
+
+  return table;
+}
+
+//! the index of each character in the tryte alphabet, -1 for invalid characters
+static const std::array<int8_t, 256>&
+tryteIndexes() {
+  static const auto table = [] {
+    std::array<int8_t, 256> indexes;
+
+    for (std::size_t c = 0; c < indexes.size(); ++c) {
+      indexes[c] = tryteIndex(static_cast<char>(c));
+    }
+    return indexes;
+  }();
+
+  return table;
+}
+
 Trytes
 charToTrytes(const char c) {
-  return Trytes{ TryteAlphabet[c % 27], TryteAlphabet[c / 27] };
+  const auto& trytes = charTrytes()[static_cast<unsigned char>(c)];
+
+  return Trytes{ trytes[0], trytes[1] };
 }
 
 Trytes
 stringToTrytes(const std::string& str) {
-  Trytes t;
-  for (const auto& c : str) {
-    t += charToTrytes(c);
+  Trytes trytes(2 * str.size(), '9');
+
+  stringToTrytes(str.data(), str.size(), &trytes[0]);
+  return trytes;
+}
+
+void
+stringToTrytes(const char* str, std::size_t length, char* trytes) {
+  const auto& table = charTrytes();
+
+  for (std::size_t i = 0; i < length; ++i) {
+    const auto& pair = table[static_cast<unsigned char>(str[i])];
+
+    trytes[2 * i]     = pair[0];
+    trytes[2 * i + 1] = pair[1];
   }
-  return t;
 }
 
 std::string
@@ -107,13 +151,30 @@ trytesToString(const Trytes& trytes) {
   if (trytes.size() % 2 != 0)
     throw Errors::IllegalState("Odd number of trytes provided");
 
-  std::string str;
-  for (size_t i = 0; i < trytes.size(); i += 2) {
-    str += TryteAlphabet.find(trytes[i]) + TryteAlphabet.find(trytes[i + 1]) * 27;
-  }
+  std::string str(trytes.size() / 2, '\0');
+  trytesToString(trytes.data(), trytes.size(), &str[0]);
   return str;
 }
 
+void
+trytesToString(const char* trytes, std::size_t length, char* str) {
+  if (length % 2 != 0)
+    throw Errors::IllegalState("Odd number of trytes provided");
+
+  const auto& indexes = tryteIndexes();
+
+  for (std::size_t i = 0; i < length; i += 2) {
+    const auto low  = indexes[static_cast<unsigned char>(trytes[i])];
+    const auto high = indexes[static_cast<unsigned char>(trytes[i + 1])];
+
+    if (low < 0 || high < 0) {
+      throw Errors::IllegalState("Invalid trytes provided");
+    }
+
+    str[i / 2] = static_cast<char>(low + high * TryteAlphabetLength);
+  }
+}
+
 std::vector<uint8_t>
 tritsToBytes(const Trits& trits, std::size_t offset) {
   Bigint               b;
@@ -226,6 +287,94 @@ intToTrits(const int64_t& value, std::size_t length) {
   return res;
 }
 
+int64_t
+trytesToInt(const Trytes& trytes, std::size_t offset, std::size_t length) {
+  const int base = TryteAlphabetLength;
+  int64_t   res  = 0;
+
+  for (std::size_t i = offset + length; i > offset; --i) {
+    int value = tryteIndex(trytes[i - 1]);
+
+    //! trytes above 'M' (13) encode negative values in balanced ternary
+    if (value > base / 2) {
+      value -= base;
+    }
+
+    res = res * base + value;
+  }
+
+  return res;
+}
+
+void
+intToTrytes(const int64_t& value, char* trytes, std::size_t length) {
+  const int base          = TryteAlphabetLength;
+  int       sign          = (value > 0) - (value < 0);
+  uint64_t  absoluteValue = value * sign;
+
+  for (std::size_t i = 0; i < length; ++i) {
+    int remainder = absoluteValue % base;
+    absoluteValue = absoluteValue / base;
+
+    //! remainders above 'M' (13) are carried and encoded as negative values
+    if (remainder > base / 2) {
+      remainder -= base;
+      absoluteValue++;
+    }
+
+    remainder *= sign;
+    trytes[i] = TryteAlphabet[remainder < 0 ? remainder + base : remainder];
+  }
+}
+
+static constexpr uint8_t packedTritsWeights[PackedTritsPerByte] = { 1, 3, 9, 27, 81 };
+
+void
+trytesToPackedTrits(const char* trytes, std::size_t length, uint8_t* bytes) {
+  std::fill(bytes, bytes + packedTritsLength(length), 0);
+
+  for (std::size_t i = 0; i < length * 3; ++i) {
+    const auto& trits = trytesTrits[tryteIndex(trytes[i / 3])];
+
+    //! each trit is shifted from [-1, 1] to [0, 2] and stored as a base 3 digit
+    bytes[i / PackedTritsPerByte] +=
+        (trits[i % 3] + 1) * packedTritsWeights[i % PackedTritsPerByte];
+  }
+}
+
+void
+nullTrytesToPackedTrits(std::size_t length, uint8_t* bytes) {
+  //! a null trit is stored as 1, so a full byte holds 1 + 3 + 9 + 27 + 81
+  const std::size_t trits     = length * 3;
+  const std::size_t fullBytes = trits / PackedTritsPerByte;
+
+  std::fill(bytes, bytes + fullBytes, 121);
+
+  if (trits % PackedTritsPerByte) {
+    bytes[fullBytes] = 0;
+
+    for (std::size_t i = 0; i < trits % PackedTritsPerByte; ++i) {
+      bytes[fullBytes] += packedTritsWeights[i];
+    }
+  }
+}
+
+void
+packedTritsToTrytes(const uint8_t* bytes, std::size_t offset, std::size_t length, char* trytes) {
+  for (std::size_t i = 0; i < length; ++i) {
+    int value = 0;
+
+    for (std::size_t j = 3; j > 0; --j) {
+      const auto pos    = (offset + i) * 3 + j - 1;
+      const auto weight = packedTritsWeights[pos % PackedTritsPerByte];
+
+      value = value * 3 + (bytes[pos / PackedTritsPerByte] / weight % 3 - 1);
+    }
+
+    trytes[i] = TryteAlphabet[value < 0 ? value + TryteAlphabetLength : value];
+  }
+}
+
 void
 incrementTrits(Trits& trits) {
   for (unsigned int i = 0; i < trits.size(); ++i) {
@@ -0,0 +1,136 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <algorithm>
+
+#include <iota/utils/thread_pool.hpp>
+
+namespace IOTA {
+
+namespace Utils {
+
+ThreadPool::ThreadPool(std::size_t maxThreads)
+    : maxThreads_(std::max<std::size_t>(maxThreads, 1)), idle_(0), stop_(false) {
+}
+
+ThreadPool::~ThreadPool() {
+  join();
+}
+
+void
+ThreadPool::join() {
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    stop_ = true;
+  }
+
+  cv_.notify_all();
+
+  //! tasks run meanwhile may queue more tasks and start new workers: join until none is left
+  for (;;) {
+    std::vector<std::thread> threads;
+
+    {
+      std::lock_guard<std::mutex> lock(mtx_);
+      threads.swap(threads_);
+    }
+
+    if (threads.empty()) {
+      return;
+    }
+
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+}
+
+std::size_t
+ThreadPool::getMaxThreads() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return maxThreads_;
+}
+
+void
+ThreadPool::setMaxThreads(std::size_t maxThreads) {
+  std::lock_guard<std::mutex> lock(mtx_);
+  maxThreads_ = std::max<std::size_t>(maxThreads, 1);
+}
+
+std::size_t
+ThreadPool::size() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return threads_.size();
+}
+
+std::size_t
+ThreadPool::pending() const {
+  std::lock_guard<std::mutex> lock(mtx_);
+  return tasks_.size();
+}
+
+void
+ThreadPool::post(std::function<void()>&& task) {
+  {
+    std::lock_guard<std::mutex> lock(mtx_);
+    tasks_.push_back(std::move(task));
+
+    //! start a worker only if the idle ones cannot absorb the queue
+    if (tasks_.size() > idle_ && threads_.size() < maxThreads_) {
+      threads_.emplace_back(&ThreadPool::work, this);
+    }
+  }
+
+  cv_.notify_one();
+}
+
+void
+ThreadPool::work() {
+  for (;;) {
+    std::function<void()> task;
+
+    {
+      std::unique_lock<std::mutex> lock(mtx_);
+
+      ++idle_;
+      cv_.wait(lock, [this]() { return stop_ || !tasks_.empty(); });
+      --idle_;
+
+      //! queued tasks are still run on destruction so that no future is left broken
+      if (tasks_.empty()) {
+        return;
+      }
+
+      task = std::move(tasks_.front());
+      tasks_.pop_front();
+    }
+
+    task();
+  }
+}
+
+}  // namespace Utils
+
+}  // namespace IOTA
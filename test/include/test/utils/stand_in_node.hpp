@@ -0,0 +1,132 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <thread>
+#include <vector>
+
+//! local stand-in for a node, answering requests after a delay
+class StandInNode {
+public:
+  //! builds the body of the answer from the body of the request
+  using Responder = std::function<std::string(const std::string& request)>;
+
+  //! answers every request with the same body
+  explicit StandInNode(const std::string&        body,
+                       std::chrono::milliseconds delay = std::chrono::milliseconds(0))
+      : StandInNode(Responder([body](const std::string&) { return body; }), delay) {
+  }
+
+  explicit StandInNode(const Responder&          respond,
+                       std::chrono::milliseconds delay = std::chrono::milliseconds(0))
+      : respond_(respond), delay_(delay), requests_(0) {
+    sockaddr_in addr{};
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len        = sizeof(addr);
+
+    fd_ = socket(AF_INET, SOCK_STREAM, 0);
+    bind(fd_, reinterpret_cast<sockaddr*>(&addr), len);
+    listen(fd_, 16);
+    getsockname(fd_, reinterpret_cast<sockaddr*>(&addr), &len);
+    port_ = ntohs(addr.sin_port);
+
+    listener_ = std::thread([this]() { serve(); });
+  }
+
+  ~StandInNode() {
+    shutdown(fd_, SHUT_RDWR);
+    close(fd_);
+    listener_.join();
+
+    for (auto& connection : connections_) {
+      connection.join();
+    }
+  }
+
+  uint16_t getPort() const {
+    return port_;
+  }
+
+  std::size_t getRequests() const {
+    return requests_;
+  }
+
+private:
+  void serve() {
+    int fd;
+    while ((fd = accept(fd_, nullptr, nullptr)) >= 0) {
+      connections_.emplace_back([this, fd]() { answer(fd); });
+    }
+  }
+
+  //! answer a single request, then close the connection
+  void answer(int fd) {
+    std::string req;
+    char        buf[4096];
+    ssize_t     n;
+
+    auto headersEnd = std::string::npos;
+    while (headersEnd == std::string::npos && (n = recv(fd, buf, sizeof(buf), 0)) > 0) {
+      req.append(buf, n);
+      headersEnd = req.find("\r\n\r\n");
+    }
+
+    auto length = req.find("Content-Length: ");
+    auto size   = length == std::string::npos ? 0 : std::stoul(req.substr(length + 16));
+    while (headersEnd != std::string::npos && req.size() < headersEnd + 4 + size &&
+           (n = recv(fd, buf, sizeof(buf), 0)) > 0) {
+      req.append(buf, n);
+    }
+
+    ++requests_;
+    std::this_thread::sleep_for(delay_);
+
+    auto body = respond_(headersEnd == std::string::npos ? "" : req.substr(headersEnd + 4));
+    auto res  = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: " +
+               std::to_string(body.size()) + "\r\nConnection: close\r\n\r\n" + body;
+    send(fd, res.data(), res.size(), MSG_NOSIGNAL);
+    close(fd);
+  }
+
+private:
+  Responder                 respond_;
+  std::chrono::milliseconds delay_;
+  std::atomic<std::size_t>  requests_;
+  int                       fd_;
+  uint16_t                  port_;
+  std::thread               listener_;
+  std::vector<std::thread>  connections_;
+};
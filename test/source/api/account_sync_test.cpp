@@ -0,0 +1,111 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include <iota/api/account_sync.hpp>
+#include <iota/api/extended.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <test/utils/constants.hpp>
+
+static std::string
+snapshotJson() {
+  return "{\"addresses\":[{\"address\":\"" + ACCOUNT_1_ADDRESS_1_HASH_WITHOUT_CHECKSUM +
+         "\",\"balance\":100,\"keyIndex\":0,\"security\":2}],"
+         "\"transactions\":[\"" +
+         BUNDLE_1_TRX_1_HASH + "\"],\"rejected\":[{\"hash\":\"" + BUNDLE_1_TRX_2_HASH +
+         "\",\"attempts\":2}],\"bundles\":[[\"" + BUNDLE_1_TRX_1_TRYTES +
+         "\"]],\"confirmedTails\":[\"" + BUNDLE_1_TRX_1_HASH + "\"],\"milestone\":\"" +
+         BUNDLE_1_HASH + "\"}";
+}
+
+TEST(AccountSync, LoadSave) {
+  auto api  = IOTA::API::Extended{ "http://localhost", 1 };
+  auto sync = IOTA::API::AccountSync{ api, ACCOUNT_1_SEED };
+
+  std::istringstream is(snapshotJson());
+  sync.load(is);
+
+  const auto& snapshot = sync.getSnapshot();
+  ASSERT_EQ(snapshot.addresses.size(), 1UL);
+  EXPECT_EQ(snapshot.addresses[0], ACCOUNT_1_ADDRESS_1_HASH_WITHOUT_CHECKSUM);
+  EXPECT_EQ(snapshot.transactions.size(), 1UL);
+  EXPECT_EQ(snapshot.transactions.count(BUNDLE_1_TRX_1_HASH), 1UL);
+  ASSERT_EQ(snapshot.rejected.count(BUNDLE_1_TRX_2_HASH), 1UL);
+  EXPECT_EQ(snapshot.rejected.at(BUNDLE_1_TRX_2_HASH), 2U);
+  EXPECT_EQ(snapshot.confirmedTails.count(BUNDLE_1_TRX_1_HASH), 1UL);
+  EXPECT_EQ(snapshot.milestone, BUNDLE_1_HASH);
+  EXPECT_EQ(sync.getBalance(), 100);
+
+  const auto data = sync.getAccountData();
+  ASSERT_EQ(data.getTransfers().size(), 1UL);
+  EXPECT_EQ(data.getTransfers()[0][0].getHash(), BUNDLE_1_TRX_1_HASH);
+  EXPECT_EQ(data.getTransfers()[0][0].getPersistence(), true);
+  EXPECT_EQ(data.getBalance(), 100);
+
+  std::ostringstream os;
+  sync.save(os);
+
+  auto               other = IOTA::API::AccountSync{ api, ACCOUNT_1_SEED };
+  std::istringstream saved(os.str());
+  other.load(saved);
+
+  EXPECT_EQ(other.getSnapshot().addresses, snapshot.addresses);
+  EXPECT_EQ(other.getSnapshot().transactions, snapshot.transactions);
+  EXPECT_EQ(other.getSnapshot().rejected, snapshot.rejected);
+  EXPECT_EQ(other.getSnapshot().confirmedTails, snapshot.confirmedTails);
+  EXPECT_EQ(other.getSnapshot().milestone, snapshot.milestone);
+  ASSERT_EQ(other.getSnapshot().bundles.size(), 1UL);
+  EXPECT_EQ(other.getSnapshot().bundles.begin()->first, BUNDLE_1_TRX_1_HASH);
+}
+
+TEST(AccountSync, LoadOtherSeed) {
+  auto api  = IOTA::API::Extended{ "http://localhost", 1 };
+  auto sync = IOTA::API::AccountSync{ api, ACCOUNT_2_SEED };
+
+  std::istringstream is(snapshotJson());
+  EXPECT_THROW(sync.load(is), IOTA::Errors::IllegalState);
+  EXPECT_TRUE(sync.getSnapshot().addresses.empty());
+}
+
+TEST(AccountSync, LoadInvalid) {
+  auto api  = IOTA::API::Extended{ "http://localhost", 1 };
+  auto sync = IOTA::API::AccountSync{ api, ACCOUNT_1_SEED };
+
+  std::istringstream missing("{\"addresses\":[]}");
+  EXPECT_THROW(sync.load(missing), IOTA::Errors::IllegalState);
+
+  std::istringstream garbage("not json");
+  EXPECT_THROW(sync.load(garbage), IOTA::Errors::IllegalState);
+
+  auto       json  = snapshotJson();
+  const auto begin = json.find(",\"rejected\"");
+  json.erase(begin, json.find(",\"bundles\"") - begin);
+
+  std::istringstream withoutRejected(json);
+  EXPECT_THROW(sync.load(withoutRejected), IOTA::Errors::IllegalState);
+}
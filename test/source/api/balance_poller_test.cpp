@@ -0,0 +1,93 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <gtest/gtest.h>
+
+#include <iota/api/balance_poller.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <test/utils/constants.hpp>
+#include <test/utils/stand_in_node.hpp>
+
+TEST(BalancePoller, Add) {
+  auto api = IOTA::API::Core{ "http://localhost", 1, true, 1 };
+
+  IOTA::API::BalancePoller poller(api);
+  EXPECT_EQ(poller.size(), 0UL);
+  EXPECT_EQ(poller.getShardSize(), api.getChunkSize("getBalances"));
+  EXPECT_EQ(poller.getMaxShardsInFlight(), api.getMaxChunksInFlight());
+
+  EXPECT_EQ(poller.add(IOTA::Models::Address{ ACCOUNT_1_ADDRESS_1_HASH }), 0UL);
+  poller.add({ IOTA::Models::Address{ ACCOUNT_1_ADDRESS_2_HASH_WITHOUT_CHECKSUM },
+               IOTA::Models::Address{ ACCOUNT_1_ADDRESS_3_HASH_WITHOUT_CHECKSUM } });
+
+  EXPECT_EQ(poller.size(), 3UL);
+  EXPECT_EQ(poller.getAddress(0), ACCOUNT_1_ADDRESS_1_HASH_WITHOUT_CHECKSUM);
+  EXPECT_EQ(poller.getAddress(2), ACCOUNT_1_ADDRESS_3_HASH_WITHOUT_CHECKSUM);
+  EXPECT_EQ(poller.getBalances(), std::vector<int64_t>(3, 0));
+  EXPECT_EQ(poller.getTotalBalance(), 0);
+
+  EXPECT_THROW(poller.add(IOTA::Models::Address{}), IOTA::Errors::IllegalState);
+  EXPECT_EQ(poller.size(), 3UL);
+}
+
+TEST(BalancePoller, PollEmpty) {
+  auto api = IOTA::API::Core{ "http://localhost", 1, true, 1 };
+
+  IOTA::API::BalancePoller poller(api);
+  EXPECT_TRUE(poller.poll().empty());
+}
+
+TEST(BalancePoller, PollFailure) {
+  auto api = IOTA::API::Core{ "http://localhost", 1, true, 1 };
+
+  IOTA::API::BalancePoller poller(api);
+  poller.setShardSize(1);
+  poller.setMaxShardsInFlight(2);
+  poller.add({ IOTA::Models::Address{ ACCOUNT_1_ADDRESS_1_HASH_WITHOUT_CHECKSUM },
+               IOTA::Models::Address{ ACCOUNT_1_ADDRESS_2_HASH_WITHOUT_CHECKSUM },
+               IOTA::Models::Address{ ACCOUNT_1_ADDRESS_3_HASH_WITHOUT_CHECKSUM } });
+
+  //! the node is unreachable: balances are left untouched
+  EXPECT_ANY_THROW(poller.poll());
+  EXPECT_EQ(poller.getBalances(), std::vector<int64_t>(3, 0));
+}
+
+TEST(BalancePoller, PollUnsplit) {
+  StandInNode node("{\"balances\":[\"5\",\"7\",\"9\"],\"milestoneIndex\":1,\"duration\":0}");
+
+  //! a chunk size of 0 never splits getBalances: all the addresses go in a single shard
+  auto api = IOTA::API::Core{ "http://127.0.0.1", node.getPort(), true, 1 };
+  api.setChunkSize("getBalances", 0);
+
+  IOTA::API::BalancePoller poller(api);
+  EXPECT_EQ(poller.getShardSize(), 0UL);
+  poller.add({ IOTA::Models::Address{ ACCOUNT_1_ADDRESS_1_HASH_WITHOUT_CHECKSUM },
+               IOTA::Models::Address{ ACCOUNT_1_ADDRESS_2_HASH_WITHOUT_CHECKSUM },
+               IOTA::Models::Address{ ACCOUNT_1_ADDRESS_3_HASH_WITHOUT_CHECKSUM } });
+
+  EXPECT_EQ(poller.poll().size(), 3UL);
+  EXPECT_EQ(poller.getBalances(), (std::vector<int64_t>{ 5, 7, 9 }));
+  EXPECT_EQ(node.getRequests(), 1UL);
+}
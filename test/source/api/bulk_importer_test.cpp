@@ -0,0 +1,98 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include <iota/api/bulk_importer.hpp>
+#include <iota/api/tangle_store.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <test/utils/constants.hpp>
+
+TEST(BulkImporter, Import) {
+  //! blocks of 2 lines, with an empty line, an invalid line and a windows line ending
+  std::stringstream dump;
+  dump << BUNDLE_1_TRX_1_TRYTES << "\n\n"
+       << BUNDLE_1_HASH << "\n"
+       << BUNDLE_1_TRX_1_TRYTES << "\r\n"
+       << BUNDLE_1_TRX_1_TRYTES;
+
+  IOTA::API::BulkImporter                       importer(2);
+  std::vector<IOTA::Models::CompactTransaction> trxs;
+
+  auto stats = importer.import(dump, [&trxs](std::vector<IOTA::Models::CompactTransaction>&& b) {
+    trxs.insert(trxs.end(), b.begin(), b.end());
+  });
+
+  EXPECT_EQ(stats.transactions, 3UL);
+  EXPECT_EQ(stats.invalid, 1UL);
+  ASSERT_EQ(trxs.size(), 3UL);
+  for (const auto& trx : trxs) {
+    EXPECT_EQ(trx.getHash(), BUNDLE_1_TRX_1_HASH);
+    EXPECT_EQ(trx.toTrytes(), BUNDLE_1_TRX_1_TRYTES);
+  }
+}
+
+TEST(BulkImporter, Consumers) {
+  std::stringstream dump;
+  for (int i = 0; i < 100; ++i) {
+    dump << BUNDLE_1_TRX_1_TRYTES << "\n";
+  }
+
+  IOTA::API::TangleStore               store;
+  IOTA::API::BulkImporter::BundleIndex index;
+  IOTA::API::BulkImporter              importer;
+
+  EXPECT_EQ(importer.getBlockSize(), IOTA::API::BulkImporter::DefaultBlockSize);
+  EXPECT_EQ(importer.import(dump, IOTA::API::BulkImporter::storeInto(store)).transactions, 100UL);
+  EXPECT_EQ(store.size(), 1UL);
+  EXPECT_TRUE(store.contains(BUNDLE_1_TRX_1_HASH));
+
+  dump.clear();
+  dump.seekg(0);
+  importer.import(dump, IOTA::API::BulkImporter::indexBundlesInto(index));
+  ASSERT_EQ(index.size(), 1UL);
+  EXPECT_EQ(index[BUNDLE_1_HASH].size(), 100UL);
+  EXPECT_EQ(index[BUNDLE_1_HASH].front(), BUNDLE_1_TRX_1_HASH);
+}
+
+TEST(BulkImporter, ImportFile) {
+  const std::string path = "bulk_importer_test.dump";
+  std::ofstream(path) << BUNDLE_1_TRX_1_TRYTES << "\n";
+
+  IOTA::API::BulkImporter importer;
+  std::size_t             nb = 0;
+
+  auto stats = importer.importFile(
+      path, [&nb](std::vector<IOTA::Models::CompactTransaction>&& b) { nb += b.size(); });
+  EXPECT_EQ(stats.transactions, 1UL);
+  EXPECT_EQ(nb, 1UL);
+
+  std::remove(path.c_str());
+  EXPECT_THROW(importer.importFile(path, nullptr), IOTA::Errors::IllegalState);
+}
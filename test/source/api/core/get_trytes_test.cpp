@@ -23,6 +23,9 @@
 //
 //
 
+#include <chrono>
+#include <future>
+
 #include <gtest/gtest.h>
 
 #include <iota/api/core.hpp>
@@ -30,6 +33,7 @@
 #include <test/utils/configuration.hpp>
 #include <test/utils/constants.hpp>
 #include <test/utils/expect_exception.hpp>
+#include <test/utils/stand_in_node.hpp>
 
 TEST(Core, GetTrytes) {
   IOTA::API::Core api(get_proxy_host(), get_proxy_port());
@@ -48,3 +52,100 @@ TEST(Core, GetTrytesInvalidHash) {
 
   EXPECT_GE(res.getDuration(), 0);
 }
+
+TEST(Core, GetTrytesAsync) {
+  IOTA::API::Core api(get_proxy_host(), get_proxy_port());
+  auto            future = api.getTrytesAsync({ BUNDLE_1_TRX_1_HASH });
+  auto            res    = future.get();
+
+  EXPECT_GE(res.getDuration(), 0);
+  EXPECT_EQ(res.getTrytes()[0], BUNDLE_1_TRX_1_TRYTES);
+}
+
+TEST(Core, GetTrytesAsyncOutlivesApi) {
+  StandInNode node("{\"trytes\":[\"" + BUNDLE_1_TRX_1_TRYTES + "\"],\"duration\":0}",
+                   std::chrono::milliseconds(100));
+  std::future<IOTA::API::Responses::GetTrytes> future;
+
+  {
+    IOTA::API::Core api("http://127.0.0.1", node.getPort());
+    future = api.getTrytesAsync({ BUNDLE_1_TRX_1_HASH });
+  }
+
+  EXPECT_EQ(future.get().getTrytes()[0], BUNDLE_1_TRX_1_TRYTES);
+}
+
+TEST(Core, CopyAssignment) {
+  StandInNode     node("{\"trytes\":[\"" + BUNDLE_1_TRX_1_TRYTES + "\"],\"duration\":0}");
+  IOTA::API::Core api("http://127.0.0.1", 1);
+  IOTA::API::Core other("http://127.0.0.1", node.getPort());
+
+  other.setMaxAsyncRequests(2);
+  api = other;
+
+  EXPECT_EQ(api.getMaxAsyncRequests(), 2UL);
+  EXPECT_EQ(api.getTrytesAsync({ BUNDLE_1_TRX_1_HASH }).get().getTrytes()[0],
+            BUNDLE_1_TRX_1_TRYTES);
+}
+
+TEST(Core, GetTrytesAsyncInvalidHash) {
+  IOTA::API::Core api(get_proxy_host(), get_proxy_port());
+  auto            future = api.getTrytesAsync({ "9999" });
+
+  EXPECT_EXCEPTION(future.get(), IOTA::Errors::BadRequest, "Invalid hashes input")
+}
+
+TEST(Core, GetTrytesChunked) {
+  IOTA::API::Core api(get_proxy_host(), get_proxy_port());
+  api.setChunkSize("getTrytes", 1);
+
+  auto res = api.getTrytes({ BUNDLE_1_TRX_1_HASH, BUNDLE_1_TRX_2_HASH, BUNDLE_1_TRX_1_HASH });
+
+  EXPECT_GE(res.getDuration(), 0);
+  ASSERT_EQ(res.getTrytes().size(), 3UL);
+  EXPECT_EQ(res.getTrytes()[0], BUNDLE_1_TRX_1_TRYTES);
+  EXPECT_EQ(res.getTrytes()[1], BUNDLE_1_TRX_2_TRYTES);
+  EXPECT_EQ(res.getTrytes()[2], BUNDLE_1_TRX_1_TRYTES);
+}
+
+TEST(Core, ChunkSize) {
+  IOTA::API::Core api(get_proxy_host(), get_proxy_port());
+
+  EXPECT_EQ(api.getChunkSize("getTrytes"), 1000UL);
+  EXPECT_EQ(api.getChunkSize("getNodeInfo"), 0UL);
+
+  api.setChunkSize("getTrytes", 10);
+  EXPECT_EQ(api.getChunkSize("getTrytes"), 10UL);
+
+  api.setMaxChunksInFlight(0);
+  EXPECT_EQ(api.getMaxChunksInFlight(), 1UL);
+}
+
+TEST(Core, GetTrytesStream) {
+  IOTA::API::Core                  api(get_proxy_host(), get_proxy_port());
+  std::vector<IOTA::Types::Trytes> trytes;
+
+  auto res = api.getTrytes({ BUNDLE_1_TRX_1_HASH, BUNDLE_1_TRX_2_HASH },
+                           [&trytes](IOTA::Types::Trytes&& t) { trytes.push_back(std::move(t)); });
+
+  EXPECT_GE(res.getDuration(), 0);
+  ASSERT_EQ(trytes.size(), 2UL);
+  EXPECT_EQ(trytes[0], BUNDLE_1_TRX_1_TRYTES);
+  EXPECT_EQ(trytes[1], BUNDLE_1_TRX_2_TRYTES);
+}
+
+TEST(Core, GetTrytesCache) {
+  IOTA::API::Core api(get_proxy_host(), get_proxy_port());
+  api.enableTrytesCache(10);
+
+  auto res = api.getTrytes({ BUNDLE_1_TRX_1_HASH });
+  EXPECT_EQ(res.getTrytes()[0], BUNDLE_1_TRX_1_TRYTES);
+  EXPECT_EQ(api.getTrytesCache()->misses(), 1UL);
+
+  res = api.getTrytes({ BUNDLE_1_TRX_2_HASH, BUNDLE_1_TRX_1_HASH });
+  ASSERT_EQ(res.getTrytes().size(), 2UL);
+  EXPECT_EQ(res.getTrytes()[0], BUNDLE_1_TRX_2_TRYTES);
+  EXPECT_EQ(res.getTrytes()[1], BUNDLE_1_TRX_1_TRYTES);
+  EXPECT_EQ(api.getTrytesCache()->hits(), 1UL);
+  EXPECT_EQ(api.getTrytesCache()->size(), 2UL);
+}
@@ -27,8 +27,11 @@
 
 #include <iota/api/extended.hpp>
 #include <iota/api/responses/get_inclusion_states.hpp>
+#include <iota/errors/illegal_state.hpp>
 #include <test/utils/configuration.hpp>
 #include <test/utils/constants.hpp>
+#include <test/utils/expect_exception.hpp>
+#include <test/utils/stand_in_node.hpp>
 
 TEST(Extended, GetLatestInclusion) {
   auto api = IOTA::API::Extended{ get_proxy_host(), get_proxy_port() };
@@ -50,3 +53,42 @@ TEST(Extended, GetLatestInclusionInvalidHash) {
 
   EXPECT_EQ(res.getStates(), std::vector<bool>({ true, false, true, true }));
 }
+
+TEST(Extended, GetLatestInclusionConfirmedTails) {
+  auto api = IOTA::API::Extended{ get_proxy_host(), get_proxy_port() };
+  EXPECT_EQ(api.getMilestoneRefreshInterval(), IOTA::DefaultMilestoneRefreshInterval);
+
+  auto hash = BUNDLE_1_TRX_2_HASH;
+  hash[0]   = '9';
+
+  auto res = api.getLatestInclusion({ BUNDLE_1_TRX_1_HASH, hash });
+  EXPECT_EQ(res.getStates(), std::vector<bool>({ true, false }));
+  EXPECT_EQ(api.getConfirmedTails().size(), 1UL);
+
+  //! confirmed transactions are answered from the cache
+  auto hits = api.getConfirmedTails().hits();
+  res       = api.getLatestInclusion({ hash, BUNDLE_1_TRX_1_HASH });
+  EXPECT_EQ(res.getStates(), std::vector<bool>({ false, true }));
+  EXPECT_EQ(api.getConfirmedTails().hits(), hits + 1);
+
+  res = api.getLatestInclusion({ BUNDLE_1_TRX_1_HASH });
+  EXPECT_EQ(res.getStates(), std::vector<bool>({ true }));
+
+  api.setMilestoneRefreshInterval(0);
+  EXPECT_EQ(api.getMilestoneRefreshInterval(), 0);
+}
+
+TEST(Extended, GetLatestInclusionInvalidStates) {
+  StandInNode node([](const std::string& body) -> std::string {
+    if (body.find("getNodeInfo") != std::string::npos) {
+      return "{\"latestSolidSubtangleMilestone\":\"" + BUNDLE_1_HASH + "\"}";
+    }
+
+    return "{\"states\":[true]}";
+  });
+
+  auto api = IOTA::API::Extended{ "http://127.0.0.1", node.getPort() };
+
+  EXPECT_EXCEPTION(api.getLatestInclusion({ BUNDLE_1_TRX_1_HASH, BUNDLE_1_TRX_2_HASH }),
+                   IOTA::Errors::IllegalState, "Invalid number of inclusion states");
+}
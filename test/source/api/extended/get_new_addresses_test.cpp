@@ -23,6 +23,10 @@
 //
 //
 
+#include <algorithm>
+#include <map>
+#include <mutex>
+
 #include <gtest/gtest.h>
 
 #include <iota/api/extended.hpp>
@@ -32,6 +36,7 @@
 #include <test/utils/configuration.hpp>
 #include <test/utils/constants.hpp>
 #include <test/utils/expect_exception.hpp>
+#include <test/utils/stand_in_node.hpp>
 
 TEST(Extended, GetNewAddressesTotalReturnAll) {
   auto api = IOTA::API::Extended{ get_proxy_host(), get_proxy_port() };
@@ -80,3 +85,54 @@ TEST(Extended, GetNewAddressesNoTotalReturnOne) {
   EXPECT_EQ(res.getAddresses().size(), 1UL);
   EXPECT_EQ(res.getAddresses()[0], ACCOUNT_1_ADDRESS_7_HASH_WITHOUT_CHECKSUM);
 }
+
+TEST(Extended, GetNewAddressesWindows) {
+  //! the first three addresses are spent, the fourth one only received and the fifth one is new
+  const std::vector<std::string> spent = { ACCOUNT_1_ADDRESS_1_HASH_WITHOUT_CHECKSUM,
+                                           ACCOUNT_1_ADDRESS_2_HASH_WITHOUT_CHECKSUM,
+                                           ACCOUNT_1_ADDRESS_3_HASH_WITHOUT_CHECKSUM };
+  const std::string              used  = ACCOUNT_1_ADDRESS_4_HASH_WITHOUT_CHECKSUM;
+
+  std::mutex                         mtx;
+  std::map<std::string, std::size_t> commands;
+
+  StandInNode node([&](const std::string& body) {
+    const auto req     = json::parse(body);
+    const auto command = req.at("command").get<std::string>();
+    json       res;
+
+    {
+      std::lock_guard<std::mutex> lock(mtx);
+      ++commands[command];
+    }
+
+    if (command == "wereAddressesSpentFrom") {
+      res["states"] = json::array();
+      for (const auto& address : req.at("addresses")) {
+        res["states"].push_back(std::count(spent.begin(), spent.end(),
+                                           address.get<std::string>().substr(0, 81)) > 0);
+      }
+    } else if (command == "findTransactions") {
+      res["hashes"] = json::array();
+      for (const auto& address : req.at("addresses")) {
+        if (address.get<std::string>().substr(0, 81) == used) {
+          res["hashes"].push_back(BUNDLE_1_TRX_1_HASH);
+        }
+      }
+    }
+
+    return res.dump();
+  });
+
+  auto api = IOTA::API::Extended{ "http://127.0.0.1", node.getPort(), true, 1 };
+  auto res = api.getNewAddresses(ACCOUNT_1_SEED, 0, 0, true);
+
+  ASSERT_EQ(res.getAddresses().size(), 5UL);
+  EXPECT_EQ(res.getAddresses()[3], ACCOUNT_1_ADDRESS_4_HASH);
+  EXPECT_EQ(res.getAddresses()[4], ACCOUNT_1_ADDRESS_5_HASH);
+
+  //! windows of 1, 2 and 4 addresses, and a lookup of each unspent address of the last one
+  EXPECT_EQ(commands["wereAddressesSpentFrom"], 3UL);
+  EXPECT_EQ(commands["findTransactions"], 4UL);
+  EXPECT_EQ(commands.count("getTrytes"), 0UL);
+}
@@ -26,10 +26,12 @@
 #include <gtest/gtest.h>
 
 #include <iota/api/extended.hpp>
+#include <iota/api/tangle_store.hpp>
 #include <iota/errors/illegal_state.hpp>
 #include <iota/models/transaction.hpp>
 #include <test/utils/configuration.hpp>
 #include <test/utils/constants.hpp>
+#include <test/utils/stand_in_node.hpp>
 
 TEST(Extended, GetTransactionsObjects) {
   auto api = IOTA::API::Extended{ get_proxy_host(), get_proxy_port() };
@@ -102,3 +104,33 @@ TEST(Extended, GetTransactionsObjectsInvalidHash) {
 
   EXPECT_THROW(api.getTransactionsObjects({ "hello" }), IOTA::Errors::IllegalState);
 }
+
+TEST(Extended, GetTransactionsObjectsSeveralChunks) {
+  auto api   = IOTA::API::Extended{ "http://localhost", 1, true, 1 };
+  auto store = std::make_shared<IOTA::API::TangleStore>();
+  store->add(BUNDLE_1_TRX_1_HASH, BUNDLE_1_TRX_1_TRYTES);
+
+  //! one hash per chunk: the chunks are fetched concurrently, here from the store only
+  api.setTangleStore(store);
+  api.setChunkSize("getTrytes", 1);
+
+  auto trxs = api.getTransactionsObjects({ BUNDLE_1_TRX_1_HASH, BUNDLE_1_TRX_1_HASH });
+  ASSERT_EQ(trxs.size(), 2UL);
+  EXPECT_EQ(trxs[0].getHash(), BUNDLE_1_TRX_1_HASH);
+  EXPECT_EQ(trxs[1].getHash(), BUNDLE_1_TRX_1_HASH);
+
+  auto views = api.getTransactionsViews({ BUNDLE_1_TRX_1_HASH, BUNDLE_1_TRX_1_HASH });
+  ASSERT_EQ(views.size(), 2UL);
+  EXPECT_EQ(views[1].getHash(), BUNDLE_1_TRX_1_HASH);
+}
+
+TEST(Extended, GetTransactionsObjectsAfterAssignment) {
+  StandInNode node("{\"trytes\":[\"" + BUNDLE_1_TRX_1_TRYTES + "\"],\"duration\":0}");
+  auto        api = IOTA::API::Extended{ "http://127.0.0.1", 1 };
+
+  api      = IOTA::API::Extended{ "http://127.0.0.1", node.getPort() };
+  auto res = api.getTransactionsObjects({ BUNDLE_1_TRX_1_HASH });
+
+  ASSERT_EQ(res.size(), 1UL);
+  EXPECT_EQ(res[0].getHash(), BUNDLE_1_TRX_1_HASH);
+}
@@ -99,6 +99,32 @@ TEST(Extended, TraverseBundleTransactionHash) {
   EXPECT_EQ(trx4.getPersistence(), false);
 }
 
+TEST(Extended, TraverseBundleTrunkByTrunk) {
+  auto api = IOTA::API::Extended{ get_proxy_host(), get_proxy_port() };
+  EXPECT_TRUE(api.getWholeBundleFetch());
+
+  auto whole = api.traverseBundle(BUNDLE_1_TRX_1_HASH);
+
+  api.setWholeBundleFetch(false);
+  EXPECT_FALSE(api.getWholeBundleFetch());
+
+  auto res = api.traverseBundle(BUNDLE_1_TRX_1_HASH);
+
+  ASSERT_EQ(res.getTransactions().size(), 4UL);
+  ASSERT_EQ(whole.getTransactions().size(), 4UL);
+
+  EXPECT_EQ(res[0].getHash(), BUNDLE_1_TRX_1_HASH);
+  EXPECT_EQ(res[1].getHash(), BUNDLE_1_TRX_2_HASH);
+  EXPECT_EQ(res[2].getHash(), BUNDLE_1_TRX_3_HASH);
+  EXPECT_EQ(res[3].getHash(), BUNDLE_1_TRX_4_HASH);
+
+  for (std::size_t i = 0; i < res.getTransactions().size(); ++i) {
+    EXPECT_EQ(res[i].getHash(), whole[i].getHash());
+  }
+
+  EXPECT_THROW(api.traverseBundle(BUNDLE_1_TRX_2_HASH), IOTA::Errors::IllegalState);
+}
+
 TEST(Extended, TraverseBundleTransactionHashNonTail) {
   auto api = IOTA::API::Extended{ get_proxy_host(), get_proxy_port() };
 
@@ -0,0 +1,113 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <utility>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <iota/api/json_stream_reader.hpp>
+#include <iota/errors/unrecognized.hpp>
+
+using Values = std::vector<std::pair<std::string, std::string>>;
+
+static IOTA::API::JsonStreamReader
+makeReader(Values& values) {
+  return IOTA::API::JsonStreamReader([&values](const std::string& field, std::string&& value) {
+    values.emplace_back(field, std::move(value));
+  });
+}
+
+TEST(JsonStreamReader, Fields) {
+  Values values;
+  auto   reader = makeReader(values);
+  std::string json =
+      "{ \"hashes\": [\"ABC\", \"DEF\"], \"duration\": 12, \"empty\": [], \"flag\": true }";
+
+  reader.feed(json.data(), json.size());
+  reader.finish();
+
+  Values expected = { { "hashes", "ABC" }, { "hashes", "DEF" }, { "duration", "12" },
+                      { "flag", "true" } };
+  EXPECT_EQ(values, expected);
+}
+
+TEST(JsonStreamReader, Pieces) {
+  Values      values;
+  auto        reader = makeReader(values);
+  std::string json   = "{\"trytes\":[\"ABCDEF\",\"GHI\"],\"duration\":123}";
+
+  //! feed one character at a time
+  for (auto c : json) {
+    reader.feed(&c, 1);
+  }
+  reader.finish();
+
+  Values expected = { { "trytes", "ABCDEF" }, { "trytes", "GHI" }, { "duration", "123" } };
+  EXPECT_EQ(values, expected);
+}
+
+TEST(JsonStreamReader, Escapes) {
+  Values      values;
+  auto        reader = makeReader(values);
+  std::string json   = "{\"error\":\"a\\\"b\\\\c\\n\\u0041\\u00e9\"}";
+
+  reader.feed(json.data(), json.size());
+  reader.finish();
+
+  ASSERT_EQ(values.size(), 1UL);
+  EXPECT_EQ(values[0].second, "a\"b\\c\nA\xC3\xA9");
+}
+
+TEST(JsonStreamReader, SkipNested) {
+  Values      values;
+  auto        reader = makeReader(values);
+  std::string json =
+      "{\"a\":{\"b\":[1,{\"c\":\"}\"}]},\"d\":[[1,2],\"x\",{\"e\":1}],\"f\":-1.5e3}";
+
+  reader.feed(json.data(), json.size());
+  reader.finish();
+
+  Values expected = { { "d", "x" }, { "f", "-1.5e3" } };
+  EXPECT_EQ(values, expected);
+}
+
+TEST(JsonStreamReader, Invalid) {
+  Values      values;
+  auto        reader = makeReader(values);
+  std::string json   = "{\"a\" 1}";
+
+  EXPECT_THROW(reader.feed(json.data(), json.size()), IOTA::Errors::Unrecognized);
+}
+
+TEST(JsonStreamReader, Incomplete) {
+  Values      values;
+  auto        reader = makeReader(values);
+  std::string json   = "{\"a\":[\"b\"";
+
+  reader.feed(json.data(), json.size());
+  EXPECT_THROW(reader.finish(), IOTA::Errors::Unrecognized);
+  EXPECT_EQ(values.size(), 1UL);
+}
@@ -0,0 +1,79 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <gtest/gtest.h>
+
+#include <iota/api/json_writer.hpp>
+
+TEST(JsonWriter, Object) {
+  std::string           body;
+  IOTA::API::JsonWriter writer(body);
+
+  writer.beginObject();
+  writer.field("command", "getTrytes");
+  writer.field("hashes", std::vector<std::string>({ "ABC", "DEF" }));
+  writer.field("depth", 3);
+  writer.field("empty", std::vector<std::string>());
+  writer.field("flag", false);
+  writer.endObject();
+
+  EXPECT_EQ(body,
+            "{\"command\":\"getTrytes\",\"hashes\":[\"ABC\",\"DEF\"],\"depth\":3,\"empty\":[],"
+            "\"flag\":false}");
+}
+
+TEST(JsonWriter, NestedArrays) {
+  std::string           body;
+  IOTA::API::JsonWriter writer(body);
+
+  writer.beginArray();
+  writer.value(int64_t(-1));
+  writer.beginArray();
+  writer.value(true);
+  writer.endArray();
+  writer.beginObject();
+  writer.endObject();
+  writer.endArray();
+
+  EXPECT_EQ(body, "[-1,[true],{}]");
+}
+
+TEST(JsonWriter, Escape) {
+  std::string           body;
+  IOTA::API::JsonWriter writer(body);
+
+  writer.value(std::string("a\"b\\c\nd\x01"));
+
+  EXPECT_EQ(body, "\"a\\\"b\\\\c\\nd\\u0001\"");
+}
+
+TEST(JsonWriter, Append) {
+  std::string           body = "prefix";
+  IOTA::API::JsonWriter writer(body);
+
+  writer.value("ABC");
+
+  EXPECT_EQ(body, "prefix\"ABC\"");
+}
@@ -0,0 +1,73 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <gtest/gtest.h>
+
+#include <iota/api/node.hpp>
+
+TEST(Node, Latency) {
+  IOTA::API::Node node("http://localhost:14265", 60);
+
+  EXPECT_EQ(node.getUrl(), "http://localhost:14265");
+  EXPECT_EQ(node.getSamples(), 0UL);
+  EXPECT_EQ(node.getLatency(), 0);
+  EXPECT_EQ(node.getLatencyPercentile(0.95), 0);
+
+  node.recordSuccess(std::chrono::milliseconds(100));
+  EXPECT_EQ(node.getLatency(), 100);
+
+  node.recordSuccess(std::chrono::milliseconds(200));
+  EXPECT_EQ(node.getLatency(), 120);
+  EXPECT_EQ(node.getSamples(), 2UL);
+}
+
+TEST(Node, LatencyPercentile) {
+  IOTA::API::Node node("http://localhost:14265", 60);
+
+  for (int i = 1; i <= 100; ++i) {
+    node.recordSuccess(std::chrono::milliseconds(i));
+  }
+
+  //! only the last LatencyWindow samples are kept: 37 to 100
+  EXPECT_EQ(node.getSamples(), 100UL);
+  EXPECT_EQ(node.getLatencyPercentile(0), 37);
+  EXPECT_EQ(node.getLatencyPercentile(1), 100);
+  EXPECT_EQ(node.getLatencyPercentile(0.5), 69);
+}
+
+TEST(Node, Health) {
+  IOTA::API::Node node("http://localhost:14265", 60);
+  EXPECT_TRUE(node.isHealthy());
+
+  for (unsigned int i = 0; i < IOTA::API::Node::MaxFailures; ++i) {
+    EXPECT_TRUE(node.isHealthy());
+    node.recordFailure();
+  }
+  EXPECT_FALSE(node.isHealthy());
+  EXPECT_EQ(node.getFailures(), IOTA::API::Node::MaxFailures);
+
+  node.recordSuccess(std::chrono::milliseconds(10));
+  EXPECT_TRUE(node.isHealthy());
+}
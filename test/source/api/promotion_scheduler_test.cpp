@@ -0,0 +1,65 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <gtest/gtest.h>
+
+#include <iota/api/extended.hpp>
+#include <iota/api/promotion_scheduler.hpp>
+#include <test/utils/constants.hpp>
+
+TEST(PromotionScheduler, Track) {
+  auto api       = IOTA::API::Extended{ "http://localhost", 1, true, 1 };
+  auto promotion = IOTA::Models::Transfer{ ACCOUNT_2_ADDRESS_1_HASH_WITHOUT_CHECKSUM, 0, "",
+                                           "TESTTAG99999999999999999999" };
+
+  IOTA::API::PromotionScheduler scheduler(api, promotion, 3, 9);
+
+  scheduler.track(BUNDLE_1_TRX_1_HASH);
+  scheduler.track(BUNDLE_1_TRX_1_HASH);
+  scheduler.track(BUNDLE_1_TRX_2_HASH);
+  EXPECT_EQ(scheduler.getPending(), 2UL);
+
+  scheduler.untrack(BUNDLE_1_TRX_2_HASH);
+  EXPECT_EQ(scheduler.getPending(), 1UL);
+
+  EXPECT_EQ(scheduler.getPromotions(), 0UL);
+  EXPECT_EQ(scheduler.getReattachments(), 0UL);
+}
+
+TEST(PromotionScheduler, UnreachableNode) {
+  auto api       = IOTA::API::Extended{ "http://localhost", 1, true, 1 };
+  auto promotion = IOTA::Models::Transfer{ ACCOUNT_2_ADDRESS_1_HASH_WITHOUT_CHECKSUM, 0, "",
+                                           "TESTTAG99999999999999999999" };
+
+  IOTA::API::PromotionScheduler scheduler(api, promotion, 3, 9, 1);
+  scheduler.track(BUNDLE_1_TRX_1_HASH);
+
+  //! checks fail: the bundle stays tracked, and nothing is sent
+  std::this_thread::sleep_for(std::chrono::milliseconds(3 * IOTA::API::PromotionScheduler::Tick));
+
+  EXPECT_EQ(scheduler.getPending(), 1UL);
+  EXPECT_EQ(scheduler.getPromotions(), 0UL);
+  EXPECT_EQ(scheduler.getReattachments(), 0UL);
+}
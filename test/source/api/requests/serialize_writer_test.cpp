@@ -0,0 +1,170 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <gtest/gtest.h>
+#include <nlohmann/json.hpp>
+
+#include <iota/api/json_writer.hpp>
+#include <iota/api/requests/add_neighbors.hpp>
+#include <iota/api/requests/attach_to_tangle.hpp>
+#include <iota/api/requests/broadcast_transactions.hpp>
+#include <iota/api/requests/check_consistency.hpp>
+#include <iota/api/requests/find_transactions.hpp>
+#include <iota/api/requests/get_balances.hpp>
+#include <iota/api/requests/get_inclusion_states.hpp>
+#include <iota/api/requests/get_neighbors.hpp>
+#include <iota/api/requests/get_node_info.hpp>
+#include <iota/api/requests/get_tips.hpp>
+#include <iota/api/requests/get_transactions_to_approve.hpp>
+#include <iota/api/requests/get_trytes.hpp>
+#include <iota/api/requests/interrupt_attaching_to_tangle.hpp>
+#include <iota/api/requests/remove_neighbors.hpp>
+#include <iota/api/requests/store_transactions.hpp>
+#include <iota/api/requests/were_addresses_spent_from.hpp>
+#include <test/utils/constants.hpp>
+
+//! gtest versions older than 1.10 only have the *_CASE spelling
+#ifndef TYPED_TEST_SUITE
+#define TYPED_TEST_SUITE TYPED_TEST_CASE
+#endif
+
+namespace Requests = IOTA::API::Requests;
+
+//! request with every field set, requests without field use the default
+template <typename T>
+static T
+makeRequest() {
+  return T{};
+}
+
+template <>
+Requests::AddNeighbors
+makeRequest<Requests::AddNeighbors>() {
+  return Requests::AddNeighbors{ { "udp://8.8.8.8:14265", "udp://8.8.8.5:14265" } };
+}
+
+template <>
+Requests::AttachToTangle
+makeRequest<Requests::AttachToTangle>() {
+  return Requests::AttachToTangle{ BUNDLE_1_TRX_1_TRUNK, BUNDLE_1_TRX_1_BRANCH, 14,
+                                   { BUNDLE_1_TRX_1_TRYTES, BUNDLE_1_TRX_1_TRYTES } };
+}
+
+template <>
+Requests::BroadcastTransactions
+makeRequest<Requests::BroadcastTransactions>() {
+  return Requests::BroadcastTransactions{ { BUNDLE_1_TRX_1_TRYTES, BUNDLE_1_TRX_1_TRYTES } };
+}
+
+template <>
+Requests::CheckConsistency
+makeRequest<Requests::CheckConsistency>() {
+  return Requests::CheckConsistency{ { BUNDLE_1_TRX_1_HASH, BUNDLE_1_TRX_1_TRUNK } };
+}
+
+template <>
+Requests::FindTransactions
+makeRequest<Requests::FindTransactions>() {
+  return Requests::FindTransactions{ { ACCOUNT_1_ADDRESS_1_HASH, ACCOUNT_1_ADDRESS_2_HASH },
+                                     { BUNDLE_1_TRX_1_TAG },
+                                     { BUNDLE_1_TRX_1_TRUNK },
+                                     { BUNDLE_1_HASH } };
+}
+
+template <>
+Requests::GetBalances
+makeRequest<Requests::GetBalances>() {
+  return Requests::GetBalances{ { ACCOUNT_1_ADDRESS_1_HASH, ACCOUNT_1_ADDRESS_2_HASH },
+                                42,
+                                { BUNDLE_1_TRX_1_HASH } };
+}
+
+template <>
+Requests::GetInclusionStates
+makeRequest<Requests::GetInclusionStates>() {
+  return Requests::GetInclusionStates{ { BUNDLE_1_TRX_1_HASH, BUNDLE_1_TRX_1_TRUNK },
+                                       { BUNDLE_1_TRX_1_BRANCH } };
+}
+
+template <>
+Requests::GetTransactionsToApprove
+makeRequest<Requests::GetTransactionsToApprove>() {
+  return Requests::GetTransactionsToApprove{ 27, BUNDLE_1_TRX_1_HASH };
+}
+
+template <>
+Requests::GetTrytes
+makeRequest<Requests::GetTrytes>() {
+  return Requests::GetTrytes{ { BUNDLE_1_TRX_1_HASH, BUNDLE_1_TRX_1_TRUNK } };
+}
+
+template <>
+Requests::RemoveNeighbors
+makeRequest<Requests::RemoveNeighbors>() {
+  return Requests::RemoveNeighbors{ { "udp://8.8.8.8:14265" } };
+}
+
+template <>
+Requests::StoreTransactions
+makeRequest<Requests::StoreTransactions>() {
+  return Requests::StoreTransactions{ { BUNDLE_1_TRX_1_TRYTES } };
+}
+
+template <>
+Requests::WereAddressesSpentFrom
+makeRequest<Requests::WereAddressesSpentFrom>() {
+  return Requests::WereAddressesSpentFrom{
+    { ACCOUNT_1_ADDRESS_1_HASH, ACCOUNT_1_ADDRESS_2_HASH }
+  };
+}
+
+template <typename T>
+class SerializeWriter : public ::testing::Test {};
+
+using RequestTypes =
+    ::testing::Types<Requests::AddNeighbors, Requests::AttachToTangle,
+                     Requests::BroadcastTransactions, Requests::CheckConsistency,
+                     Requests::FindTransactions, Requests::GetBalances,
+                     Requests::GetInclusionStates, Requests::GetNeighbors, Requests::GetNodeInfo,
+                     Requests::GetTips, Requests::GetTransactionsToApprove, Requests::GetTrytes,
+                     Requests::InterruptAttachingToTangle, Requests::RemoveNeighbors,
+                     Requests::StoreTransactions, Requests::WereAddressesSpentFrom>;
+
+TYPED_TEST_SUITE(SerializeWriter, RequestTypes);
+
+TYPED_TEST(SerializeWriter, SameAsJson) {
+  const auto req = makeRequest<TypeParam>();
+  json       data;
+
+  req.serialize(data);
+
+  std::string           body;
+  IOTA::API::JsonWriter writer(body);
+  writer.beginObject();
+  req.serialize(writer);
+  writer.endObject();
+
+  EXPECT_EQ(json::parse(body), data);
+}
@@ -0,0 +1,82 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <iota/api/extended.hpp>
+#include <iota/api/send_pipeline.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <test/utils/constants.hpp>
+
+TEST(SendPipeline, StageFailure) {
+  auto api = IOTA::API::Extended{ "http://localhost", 1, true, 1 };
+
+  auto transfer  = IOTA::Models::Transfer{ ACCOUNT_2_ADDRESS_1_HASH_WITHOUT_CHECKSUM, 0, "TESTMSG",
+                                          "TESTTAG99999999999999999999" };
+  auto transfers = std::vector<IOTA::Models::Transfer>{ transfer };
+
+  IOTA::API::SendPipeline pipeline(api, 3, 9);
+
+  //! the node is unreachable: bundles are prepared, but fail at tip selection
+  auto first  = pipeline.submit(ACCOUNT_1_SEED, transfers);
+  auto second = pipeline.submit(ACCOUNT_1_SEED, transfers);
+
+  EXPECT_ANY_THROW(first.get());
+  EXPECT_ANY_THROW(second.get());
+
+  EXPECT_EQ(pipeline.getCompleted(), 2UL);
+  EXPECT_EQ(pipeline.getStageStats(IOTA::API::SendPipeline::Stage::Prepare).count, 2UL);
+  EXPECT_EQ(pipeline.getStageStats(IOTA::API::SendPipeline::Stage::Pow).count, 0UL);
+  EXPECT_EQ(pipeline.getStageStats(IOTA::API::SendPipeline::Stage::Broadcast).count, 0UL);
+  EXPECT_GE(pipeline.getThroughput(), 0.0);
+}
+
+TEST(SendPipeline, ValueTransferWithoutInputs) {
+  auto api = IOTA::API::Extended{ "http://localhost", 1, true, 1 };
+
+  IOTA::API::SendPipeline pipeline(api, 3, 9);
+
+  auto transfer  = IOTA::Models::Transfer{ ACCOUNT_2_ADDRESS_1_HASH_WITHOUT_CHECKSUM, 1, "TESTMSG",
+                                          "TESTTAG99999999999999999999" };
+  auto transfers = std::vector<IOTA::Models::Transfer>{ transfer };
+
+  //! automatic input selection could sign the inputs of a bundle still in flight
+  EXPECT_THROW(pipeline.submit(ACCOUNT_1_SEED, transfers), IOTA::Errors::IllegalState);
+  EXPECT_EQ(pipeline.getStageStats(IOTA::API::SendPipeline::Stage::Prepare).count, 0UL);
+}
+
+TEST(SendPipeline, InvalidTransfer) {
+  auto api = IOTA::API::Extended{ "http://localhost", 1, true, 1 };
+
+  IOTA::API::SendPipeline pipeline(api, 3, 9);
+
+  auto transfers = std::vector<IOTA::Models::Transfer>{ IOTA::Models::Transfer{} };
+  auto result    = pipeline.submit(ACCOUNT_1_SEED, transfers);
+
+  EXPECT_THROW(result.get(), IOTA::Errors::IllegalState);
+  EXPECT_EQ(pipeline.getStageStats(IOTA::API::SendPipeline::Stage::Prepare).count, 0UL);
+}
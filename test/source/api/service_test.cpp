@@ -0,0 +1,139 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <gtest/gtest.h>
+
+#include <iota/api/requests/get_node_info.hpp>
+#include <iota/api/responses/get_node_info.hpp>
+#include <iota/api/service.hpp>
+#include <test/utils/expect_exception.hpp>
+#include <test/utils/stand_in_node.hpp>
+
+TEST(Service, Nodes) {
+  IOTA::API::Service service("http://localhost", 1);
+  service.addNode("http://localhost", 2);
+
+  ASSERT_EQ(service.getNodes().size(), 2UL);
+  EXPECT_EQ(service.getNodes()[0]->getUrl(), "http://localhost:1");
+  EXPECT_EQ(service.getNodes()[1]->getUrl(), "http://localhost:2");
+}
+
+TEST(Service, RankNodes) {
+  IOTA::API::Service service("http://localhost", 1);
+  service.addNode("http://localhost", 2);
+  service.addNode("http://localhost", 3);
+
+  auto& nodes = service.getNodes();
+  nodes[0]->recordSuccess(std::chrono::milliseconds(300));
+  nodes[1]->recordSuccess(std::chrono::milliseconds(100));
+  nodes[2]->recordSuccess(std::chrono::milliseconds(200));
+
+  auto ranked = service.rankNodes();
+  ASSERT_EQ(ranked.size(), 3UL);
+  EXPECT_EQ(ranked[0], nodes[1]);
+  EXPECT_EQ(ranked[1], nodes[2]);
+  EXPECT_EQ(ranked[2], nodes[0]);
+
+  //! unhealthy nodes are left out
+  for (unsigned int i = 0; i < IOTA::API::Node::MaxFailures; ++i) {
+    nodes[1]->recordFailure();
+  }
+
+  ranked = service.rankNodes();
+  ASSERT_EQ(ranked.size(), 2UL);
+  EXPECT_EQ(ranked[0], nodes[2]);
+  EXPECT_EQ(ranked[1], nodes[0]);
+}
+
+TEST(Service, Settings) {
+  IOTA::API::Service service("http://localhost", 1);
+
+  EXPECT_FALSE(service.getBroadcastToAllNodes());
+  service.setBroadcastToAllNodes(true);
+  EXPECT_TRUE(service.getBroadcastToAllNodes());
+
+  EXPECT_EQ(service.getHedgePercentile(), 0.95);
+  service.setHedgePercentile(0);
+  EXPECT_EQ(service.getHedgePercentile(), 0);
+}
+
+TEST(Service, Failover) {
+  //! no node listens on these ports: a read is tried on every node before failing
+  IOTA::API::Service service("http://localhost", 1);
+  service.addNode("http://localhost", 2);
+
+  EXPECT_THROW((service.request<IOTA::API::Requests::GetNodeInfo,
+                                IOTA::API::Responses::GetNodeInfo>()),
+               IOTA::Errors::Network);
+
+  for (const auto& node : service.getNodes()) {
+    EXPECT_EQ(node->getFailures(), 1U);
+    EXPECT_EQ(node->getSamples(), 0UL);
+  }
+}
+
+TEST(Service, HedgedRead) {
+  StandInNode slow("{\"appName\":\"slow\"}", std::chrono::milliseconds(500));
+  StandInNode fast("{\"appName\":\"fast\"}", std::chrono::milliseconds(0));
+
+  IOTA::API::Service service("http://127.0.0.1", slow.getPort());
+  service.addNode("http://127.0.0.1", fast.getPort());
+
+  //! the slow node is usually the fastest for this command
+  auto& nodes = service.getNodes();
+  for (int i = 0; i < 10; ++i) {
+    nodes[0]->recordSuccess(std::chrono::milliseconds(10), "getNodeInfo");
+    nodes[1]->recordSuccess(std::chrono::milliseconds(20), "getNodeInfo");
+  }
+
+  auto res = service.request<IOTA::API::Requests::GetNodeInfo, IOTA::API::Responses::GetNodeInfo>();
+
+  EXPECT_EQ(res.getAppName(), "fast");
+  EXPECT_EQ(slow.getRequests(), 1UL);
+  EXPECT_EQ(fast.getRequests(), 1UL);
+}
+
+TEST(Service, HedgedReadByCommand) {
+  StandInNode slow("{\"appName\":\"slow\"}", std::chrono::milliseconds(100));
+  StandInNode fast("{\"appName\":\"fast\"}", std::chrono::milliseconds(0));
+
+  IOTA::API::Service service("http://127.0.0.1", slow.getPort());
+  service.addNode("http://127.0.0.1", fast.getPort());
+
+  //! latencies of another command do not hedge this one
+  auto& nodes = service.getNodes();
+  for (int i = 0; i < 10; ++i) {
+    nodes[0]->recordSuccess(std::chrono::milliseconds(10), "getTrytes");
+    nodes[1]->recordSuccess(std::chrono::milliseconds(20), "getTrytes");
+  }
+
+  auto res = service.request<IOTA::API::Requests::GetNodeInfo, IOTA::API::Responses::GetNodeInfo>();
+
+  EXPECT_EQ(res.getAppName(), "slow");
+  EXPECT_EQ(slow.getRequests(), 1UL);
+  EXPECT_EQ(fast.getRequests(), 0UL);
+  EXPECT_EQ(nodes[0]->getSamples("getNodeInfo"), 1UL);
+  EXPECT_EQ(nodes[0]->getSamples(), 11UL);
+}
@@ -0,0 +1,73 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <gtest/gtest.h>
+
+#include <iota/api/session_pool.hpp>
+
+TEST(SessionPool, AcquireCreatesSession) {
+  IOTA::API::SessionPool pool("http://localhost:14265", 60);
+
+  auto session = pool.acquire();
+  EXPECT_NE(session, nullptr);
+  EXPECT_EQ(pool.idle(), 0UL);
+}
+
+TEST(SessionPool, ReleaseReusesSession) {
+  IOTA::API::SessionPool pool("http://localhost:14265", 60);
+
+  auto session = pool.acquire();
+  auto raw     = session.get();
+  pool.release(std::move(session));
+  EXPECT_EQ(pool.idle(), 1UL);
+
+  auto reused = pool.acquire();
+  EXPECT_EQ(reused.get(), raw);
+  EXPECT_EQ(pool.idle(), 0UL);
+}
+
+TEST(SessionPool, MaxIdle) {
+  IOTA::API::SessionPool pool("http://localhost:14265", 60, "", "", 2);
+  EXPECT_EQ(pool.getMaxIdle(), 2UL);
+
+  auto first  = pool.acquire();
+  auto second = pool.acquire();
+  auto third  = pool.acquire();
+  pool.release(std::move(first));
+  pool.release(std::move(second));
+  pool.release(std::move(third));
+  EXPECT_EQ(pool.idle(), 2UL);
+
+  pool.setMaxIdle(1);
+  EXPECT_EQ(pool.getMaxIdle(), 1UL);
+  EXPECT_EQ(pool.idle(), 1UL);
+}
+
+TEST(SessionPool, ReleaseNull) {
+  IOTA::API::SessionPool pool("http://localhost:14265", 60);
+
+  pool.release(nullptr);
+  EXPECT_EQ(pool.idle(), 0UL);
+}
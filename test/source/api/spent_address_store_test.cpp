@@ -0,0 +1,149 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <cstdio>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include <iota/api/extended.hpp>
+#include <iota/api/spent_address_store.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <test/utils/constants.hpp>
+
+static const std::string STORE_PATH = "spent_address_store_test.bin";
+
+static void
+removeStore() {
+  std::remove(STORE_PATH.c_str());
+  std::remove((STORE_PATH + ".log").c_str());
+}
+
+static std::size_t
+fileSize(const std::string& path) {
+  std::ifstream file(path, std::ios::binary | std::ios::ate);
+  return file ? static_cast<std::size_t>(file.tellg()) : 0;
+}
+
+TEST(SpentAddressStore, InMemory) {
+  IOTA::API::SpentAddressStore store;
+  EXPECT_EQ(store.size(), 0UL);
+  EXPECT_FALSE(store.contains(ACCOUNT_1_ADDRESS_1_HASH));
+
+  store.add(ACCOUNT_1_ADDRESS_1_HASH);
+  store.add({ ACCOUNT_1_ADDRESS_1_HASH_WITHOUT_CHECKSUM, ACCOUNT_1_ADDRESS_2_HASH });
+  EXPECT_EQ(store.size(), 2UL);
+
+  EXPECT_TRUE(store.contains(ACCOUNT_1_ADDRESS_1_HASH_WITHOUT_CHECKSUM));
+  EXPECT_TRUE(store.contains(ACCOUNT_1_ADDRESS_2_HASH_WITHOUT_CHECKSUM));
+  EXPECT_FALSE(store.contains(ACCOUNT_1_ADDRESS_3_HASH));
+
+  EXPECT_THROW(store.add("INVALID"), IOTA::Errors::IllegalState);
+  EXPECT_THROW(store.contains(""), IOTA::Errors::IllegalState);
+}
+
+TEST(SpentAddressStore, Record) {
+  const auto record = IOTA::API::SpentAddressStore::toRecord(ACCOUNT_1_ADDRESS_1_HASH);
+
+  EXPECT_EQ(record, IOTA::API::SpentAddressStore::toRecord(
+                        ACCOUNT_1_ADDRESS_1_HASH_WITHOUT_CHECKSUM));
+  EXPECT_NE(record, IOTA::API::SpentAddressStore::toRecord(ACCOUNT_1_ADDRESS_2_HASH));
+}
+
+TEST(SpentAddressStore, Persistence) {
+  removeStore();
+
+  {
+    IOTA::API::SpentAddressStore store(STORE_PATH);
+    store.add({ ACCOUNT_1_ADDRESS_1_HASH, ACCOUNT_1_ADDRESS_2_HASH });
+
+    //! records are journaled until compaction
+    EXPECT_EQ(fileSize(STORE_PATH), 0UL);
+    EXPECT_EQ(fileSize(STORE_PATH + ".log"), 2 * IOTA::ByteHashLength);
+  }
+
+  {
+    //! the journal is merged on open
+    IOTA::API::SpentAddressStore store(STORE_PATH);
+    EXPECT_EQ(store.size(), 2UL);
+    EXPECT_EQ(fileSize(STORE_PATH), 2 * IOTA::ByteHashLength);
+    EXPECT_EQ(fileSize(STORE_PATH + ".log"), 0UL);
+
+    EXPECT_TRUE(store.contains(ACCOUNT_1_ADDRESS_1_HASH));
+    EXPECT_TRUE(store.contains(ACCOUNT_1_ADDRESS_2_HASH));
+    EXPECT_FALSE(store.contains(ACCOUNT_1_ADDRESS_3_HASH));
+
+    store.add(ACCOUNT_1_ADDRESS_2_HASH);
+    store.add(ACCOUNT_1_ADDRESS_3_HASH);
+    EXPECT_EQ(store.size(), 3UL);
+    EXPECT_TRUE(store.contains(ACCOUNT_1_ADDRESS_3_HASH));
+
+    store.compact();
+    EXPECT_EQ(fileSize(STORE_PATH), 3 * IOTA::ByteHashLength);
+    EXPECT_TRUE(store.contains(ACCOUNT_1_ADDRESS_1_HASH));
+    EXPECT_TRUE(store.contains(ACCOUNT_1_ADDRESS_2_HASH));
+    EXPECT_TRUE(store.contains(ACCOUNT_1_ADDRESS_3_HASH));
+  }
+
+  removeStore();
+}
+
+TEST(SpentAddressStore, CompactThreshold) {
+  removeStore();
+
+  {
+    IOTA::API::SpentAddressStore store(STORE_PATH, 2);
+    store.add(ACCOUNT_1_ADDRESS_1_HASH);
+    EXPECT_EQ(fileSize(STORE_PATH), 0UL);
+
+    store.add(ACCOUNT_1_ADDRESS_3_HASH);
+    EXPECT_EQ(fileSize(STORE_PATH), 2 * IOTA::ByteHashLength);
+    EXPECT_EQ(store.size(), 2UL);
+  }
+
+  removeStore();
+}
+
+TEST(SpentAddressStore, InvalidFile) {
+  removeStore();
+  std::ofstream(STORE_PATH) << "not a store";
+
+  EXPECT_THROW(IOTA::API::SpentAddressStore{ STORE_PATH }, IOTA::Errors::IllegalState);
+
+  removeStore();
+}
+
+TEST(SpentAddressStore, Extended) {
+  auto api = IOTA::API::Extended{ "http://localhost", 1, true, 1 };
+  EXPECT_EQ(api.getSpentAddressStore(), nullptr);
+
+  auto store = std::make_shared<IOTA::API::SpentAddressStore>();
+  api.setSpentAddressStore(store);
+  EXPECT_EQ(api.getSpentAddressStore(), store);
+
+  //! copies share the store
+  auto copy = api;
+  EXPECT_EQ(copy.getSpentAddressStore(), store);
+}
@@ -0,0 +1,136 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <cstdio>
+#include <fstream>
+
+#include <gtest/gtest.h>
+
+#include <iota/api/core.hpp>
+#include <iota/api/responses/find_transactions.hpp>
+#include <iota/api/responses/get_trytes.hpp>
+#include <iota/api/tangle_store.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <test/utils/constants.hpp>
+#include <test/utils/stand_in_node.hpp>
+
+static const std::string STORE_PATH = "tangle_store_test.bin";
+
+TEST(TangleStore, InMemory) {
+  IOTA::API::TangleStore store;
+  IOTA::Types::Trytes    trytes;
+
+  EXPECT_EQ(store.size(), 0UL);
+  EXPECT_FALSE(store.contains(BUNDLE_1_TRX_1_HASH));
+  EXPECT_FALSE(store.getTrytes(BUNDLE_1_TRX_1_HASH, trytes));
+
+  EXPECT_TRUE(store.add(BUNDLE_1_TRX_1_HASH, BUNDLE_1_TRX_1_TRYTES));
+  EXPECT_FALSE(store.add(BUNDLE_1_TRX_1_HASH, BUNDLE_1_TRX_1_TRYTES));
+  EXPECT_EQ(store.size(), 1UL);
+
+  EXPECT_TRUE(store.contains(BUNDLE_1_TRX_1_HASH));
+  EXPECT_TRUE(store.getTrytes(BUNDLE_1_TRX_1_HASH, trytes));
+  EXPECT_EQ(trytes, BUNDLE_1_TRX_1_TRYTES);
+
+  EXPECT_THROW(store.add(BUNDLE_1_TRX_1_HASH, "INVALID"), IOTA::Errors::IllegalState);
+  EXPECT_THROW(store.add("INVALID", BUNDLE_1_TRX_1_TRYTES), IOTA::Errors::IllegalState);
+}
+
+TEST(TangleStore, FindTransactions) {
+  IOTA::API::TangleStore store;
+  store.add(BUNDLE_1_TRX_1_HASH, BUNDLE_1_TRX_1_TRYTES);
+
+  const std::vector<IOTA::Types::Trytes> expected = { BUNDLE_1_TRX_1_HASH };
+  const IOTA::Models::Address            address  = BUNDLE_1_TRX_1_ADDRESS_WITHOUT_CHECKSUM;
+  const IOTA::Models::Address            other    = ACCOUNT_1_ADDRESS_1_HASH_WITHOUT_CHECKSUM;
+
+  EXPECT_EQ(store.findTransactions({ address }, {}, {}, {}), expected);
+  EXPECT_EQ(store.findTransactions({ other, address }, {}, {}, {}), expected);
+  EXPECT_EQ(store.findTransactions({}, { BUNDLE_1_TRX_1_TAG }, {}, {}), expected);
+  EXPECT_EQ(store.findTransactions({}, {}, { BUNDLE_1_TRX_1_TRUNK }, {}), expected);
+  EXPECT_EQ(store.findTransactions({}, {}, { BUNDLE_1_TRX_1_BRANCH }, {}), expected);
+  EXPECT_EQ(store.findTransactions({}, {}, {}, { BUNDLE_1_HASH }), expected);
+
+  //! fields are intersected
+  EXPECT_EQ(store.findTransactions({ address }, {}, {}, { BUNDLE_1_HASH }), expected);
+  EXPECT_TRUE(store.findTransactions({ other }, {}, {}, { BUNDLE_1_HASH }).empty());
+  EXPECT_TRUE(store.findTransactions({}, {}, {}, {}).empty());
+}
+
+TEST(TangleStore, Persistence) {
+  std::remove(STORE_PATH.c_str());
+
+  {
+    IOTA::API::TangleStore store(STORE_PATH);
+    EXPECT_TRUE(store.add(BUNDLE_1_TRX_1_HASH, BUNDLE_1_TRX_1_TRYTES));
+  }
+
+  {
+    IOTA::API::TangleStore store(STORE_PATH);
+    IOTA::Types::Trytes    trytes;
+
+    EXPECT_EQ(store.size(), 1UL);
+    EXPECT_TRUE(store.getTrytes(BUNDLE_1_TRX_1_HASH, trytes));
+    EXPECT_EQ(trytes, BUNDLE_1_TRX_1_TRYTES);
+    EXPECT_EQ(store.findTransactions({}, {}, {}, { BUNDLE_1_HASH }),
+              std::vector<IOTA::Types::Trytes>{ BUNDLE_1_TRX_1_HASH });
+  }
+
+  std::ofstream(STORE_PATH, std::ios::app) << "garbage";
+  EXPECT_THROW(IOTA::API::TangleStore{ STORE_PATH }, IOTA::Errors::IllegalState);
+
+  std::remove(STORE_PATH.c_str());
+}
+
+TEST(TangleStore, Core) {
+  auto api   = IOTA::API::Core{ "http://localhost", 1, true, 1 };
+  auto store = std::make_shared<IOTA::API::TangleStore>();
+  store->add(BUNDLE_1_TRX_1_HASH, BUNDLE_1_TRX_1_TRYTES);
+
+  //! the node is unreachable: only the stored transactions can be answered
+  api.setTangleStore(store);
+  EXPECT_EQ(api.getTangleStore(), store);
+  EXPECT_EQ(api.getTrytes({ BUNDLE_1_TRX_1_HASH }).getTrytes(),
+            std::vector<IOTA::Types::Trytes>{ BUNDLE_1_TRX_1_TRYTES });
+  EXPECT_ANY_THROW(
+      api.getTrytes({ BUNDLE_1_TRX_1_HASH, ACCOUNT_1_ADDRESS_1_HASH_WITHOUT_CHECKSUM }));
+  EXPECT_ANY_THROW(api.findTransactions({}, {}, {}, { BUNDLE_1_HASH }));
+}
+
+TEST(TangleStore, CoreFindTransactions) {
+  StandInNode node("{\"hashes\":[\"" + BUNDLE_1_TRX_2_HASH + "\",\"" + BUNDLE_1_TRX_1_HASH +
+                   "\"]}");
+
+  auto api   = IOTA::API::Core{ "http://127.0.0.1", node.getPort(), true, 1 };
+  auto store = std::make_shared<IOTA::API::TangleStore>();
+  store->add(BUNDLE_1_TRX_1_HASH, BUNDLE_1_TRX_1_TRYTES);
+  api.setTangleStore(store);
+
+  //! the answer of the node is returned as is, the store only serves getTrytes
+  const auto expected =
+      std::vector<IOTA::Types::Trytes>{ BUNDLE_1_TRX_2_HASH, BUNDLE_1_TRX_1_HASH };
+  EXPECT_EQ(api.findTransactions({}, {}, {}, { BUNDLE_1_HASH }).getHashes(), expected);
+  EXPECT_EQ(node.getRequests(), 1UL);
+}
@@ -0,0 +1,83 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <memory>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <iota/api/extended.hpp>
+#include <iota/api/tip_pool.hpp>
+
+TEST(TipPool, EmptyPool) {
+  auto api = IOTA::API::Core{ "http://localhost", 1, true, 1 };
+
+  IOTA::API::TipPool       pool(api, 2, 1000, 10);
+  IOTA::API::TipPool::Tips tips;
+
+  EXPECT_EQ(pool.size(3), 0UL);
+
+  //! the node is unreachable: nothing can be prefetched
+  EXPECT_FALSE(pool.take(3, tips));
+  pool.watch(4);
+
+  EXPECT_EQ(pool.getHits(), 0UL);
+  EXPECT_EQ(pool.getMisses(), 1UL);
+  EXPECT_EQ(pool.size(3), 0UL);
+  EXPECT_EQ(pool.size(4), 0UL);
+}
+
+TEST(TipPool, Extended) {
+  auto api = IOTA::API::Extended{ "http://localhost", 1, true, 1 };
+  EXPECT_EQ(api.getTipPool(), nullptr);
+
+  api.enableTipPool(2);
+  ASSERT_NE(api.getTipPool(), nullptr);
+
+  //! copies share the pool
+  auto copy = api;
+  EXPECT_EQ(copy.getTipPool(), api.getTipPool());
+
+  api.enableTipPool(0);
+  EXPECT_EQ(api.getTipPool(), nullptr);
+  EXPECT_NE(copy.getTipPool(), nullptr);
+}
+
+TEST(TipPool, OutlivesApi) {
+  std::unique_ptr<IOTA::API::Extended> api(
+      new IOTA::API::Extended{ "http://localhost", 1, true, 1 });
+  api->enableTipPool(2);
+
+  //! the original is destroyed first: the pool keeps fetching through its own copy of the api
+  auto copy = *api;
+  api.reset();
+
+  IOTA::API::TipPool::Tips tips;
+  EXPECT_FALSE(copy.getTipPool()->take(3, tips));
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+  EXPECT_EQ(copy.getTipPool()->getMisses(), 1UL);
+  EXPECT_EQ(copy.getTipPool()->size(3), 0UL);
+}
@@ -0,0 +1,87 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <gtest/gtest.h>
+
+#include <iota/crypto/batch_curl.hpp>
+#include <iota/crypto/curl.hpp>
+#include <iota/errors/crypto.hpp>
+#include <iota/types/trinary.hpp>
+#include <test/utils/constants.hpp>
+
+static IOTA::Types::Trytes
+curlHash(const IOTA::Types::Trytes& trytes) {
+  IOTA::Crypto::Curl curl;
+  IOTA::Types::Trits hash(IOTA::TritHashLength);
+
+  curl.absorb(IOTA::Types::trytesToTrits(trytes));
+  curl.squeeze(hash);
+
+  return IOTA::Types::tritsToTrytes(hash);
+}
+
+TEST(BatchCurl, TransactionHash) {
+  IOTA::Crypto::BatchCurl curl;
+
+  curl.absorb({ BUNDLE_1_TRX_1_TRYTES.data() }, IOTA::TrxTrytesLength);
+  EXPECT_EQ(curl.squeeze(1), std::vector<IOTA::Types::Trytes>{ BUNDLE_1_TRX_1_HASH });
+}
+
+TEST(BatchCurl, FullBatch) {
+  //! every lane hashes a different message
+  std::vector<IOTA::Types::Trytes> messages;
+  std::vector<const char*>         trytes;
+  for (std::size_t i = 0; i < IOTA::Crypto::BatchCurl::BatchSize; ++i) {
+    auto message = BUNDLE_1_HASH + BUNDLE_1_TRX_1_HASH;
+    message[i]   = IOTA::TryteAlphabet[i % IOTA::TryteAlphabetLength];
+    messages.push_back(message);
+  }
+  for (const auto& message : messages) {
+    trytes.push_back(message.data());
+  }
+
+  IOTA::Crypto::BatchCurl curl;
+  curl.absorb(trytes, 2 * IOTA::HashLength);
+  const auto hashes = curl.squeeze(messages.size());
+
+  ASSERT_EQ(hashes.size(), messages.size());
+  for (std::size_t i = 0; i < messages.size(); ++i) {
+    EXPECT_EQ(hashes[i], curlHash(messages[i]));
+  }
+
+  //! reset brings back the initial state
+  curl.reset();
+  curl.absorb({ messages[3].data() }, 2 * IOTA::HashLength);
+  EXPECT_EQ(curl.squeeze(1)[0], hashes[3]);
+}
+
+TEST(BatchCurl, InvalidParameters) {
+  IOTA::Crypto::BatchCurl curl;
+
+  EXPECT_THROW(curl.absorb({ BUNDLE_1_HASH.data() }, 10), IOTA::Errors::Crypto);
+  EXPECT_THROW(curl.absorb(std::vector<const char*>(65, BUNDLE_1_HASH.data()), IOTA::HashLength),
+               IOTA::Errors::Crypto);
+  EXPECT_THROW(curl.squeeze(65), IOTA::Errors::Crypto);
+}
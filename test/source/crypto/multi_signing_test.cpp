@@ -29,6 +29,7 @@
 #include <iota/constants.hpp>
 #include <iota/crypto/multi_signing.hpp>
 #include <iota/models/bundle.hpp>
+#include <iota/models/multisig_address_builder.hpp>
 #include <iota/models/seed.hpp>
 #include <iota/models/transfer.hpp>
 #include <iota/types/trinary.hpp>
@@ -36,8 +37,7 @@
 #include <test/utils/constants.hpp>
 
 TEST(Multisigning, Basic) {
-  IOTA::Models::Address msa(IOTA::Models::Address::MULTISIG);
-  auto                  api = IOTA::API::Extended{ get_proxy_host(), get_proxy_port() };
+  auto api = IOTA::API::Extended{ get_proxy_host(), get_proxy_port() };
 
   auto firstKey = IOTA::Crypto::MultiSigning::key(IOTA::Types::trytesToBytes(ACCOUNT_1_SEED), 0, 3);
   auto firstDigest = IOTA::Crypto::MultiSigning::digests(firstKey);
@@ -56,15 +56,17 @@ TEST(Multisigning, Basic) {
       "MVPPSRNZYFSGXSKAKCLYMKJRZJHXRUXUTAYS9YBNKHVVVOANLAMKPPGXSEWQZOVBFQPAZAGNXBMYIUGPDRJMVQGXFZAI"
       "APTLAMPW9BFEHTWEL9UIB9XHVEAGSFATCDYLYLHOAVPCKPNSVVJRGXOYZ9C");
 
-  msa.absorbDigests(firstDigest);
-  msa.absorbDigests(secondDigest);
-  msa.finalize();
+  IOTA::Models::MultisigAddressBuilder builder;
+  builder.absorbDigests(firstDigest);
+  builder.absorbDigests(secondDigest);
+  const auto msa = builder.finalize();
 
   // TODO add in constants.hpp
   EXPECT_EQ(msa.toTrytes(),
             "IZRSJJABYOJ9ZGMIDQPEYLIORMSJBHLIYVBOCOYG9CKKCCJG99MDZYANLWQFEIBGUA9QJSXXKTACDHSSZ");
 
-  EXPECT_TRUE(msa.validate({ firstDigest, secondDigest }));
+  EXPECT_TRUE(
+      IOTA::Models::MultisigAddressBuilder::validate(msa, { firstDigest, secondDigest }));
 
   IOTA::Models::Transfer tf{ ACCOUNT_5_ADDRESS_1_HASH, 1, "", IOTA::EmptyTag };
 
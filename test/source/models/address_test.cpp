@@ -23,6 +23,9 @@
 //
 //
 
+#include <thread>
+#include <vector>
+
 #include <gtest/gtest.h>
 
 #include <iota/constants.hpp>
@@ -306,3 +309,34 @@ TEST(Address, OperatorNEqTrytes) {
   IOTA::Types::Trytes   rhs_neq(ACCOUNT_1_ADDRESS_2_HASH);
   EXPECT_TRUE(lhs_neq != rhs_neq);
 }
+
+TEST(Address, GetType) {
+  EXPECT_EQ(IOTA::Models::Address{ ACCOUNT_1_ADDRESS_1_HASH }.getType(),
+            IOTA::Models::Address::NORMAL);
+  EXPECT_EQ(IOTA::Models::Address{ IOTA::Models::Address::MULTISIG }.getType(),
+            IOTA::Models::Address::MULTISIG);
+}
+
+TEST(Address, CopyKeepsChecksum) {
+  const IOTA::Models::Address address = ACCOUNT_1_ADDRESS_1_HASH_WITHOUT_CHECKSUM;
+  address.getChecksum();
+
+  auto copy = address;
+  EXPECT_EQ(copy, address);
+  EXPECT_EQ(copy.toTrytesWithChecksum(), ACCOUNT_1_ADDRESS_1_HASH);
+}
+
+TEST(Address, ConcurrentChecksum) {
+  const IOTA::Models::Address address = ACCOUNT_1_ADDRESS_1_HASH_WITHOUT_CHECKSUM;
+  std::vector<std::thread>    readers;
+
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&address]() {
+      EXPECT_EQ(address.toTrytesWithChecksum(), ACCOUNT_1_ADDRESS_1_HASH);
+    });
+  }
+
+  for (auto& reader : readers) {
+    reader.join();
+  }
+}
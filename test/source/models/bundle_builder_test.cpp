@@ -0,0 +1,148 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <sstream>
+
+#include <gtest/gtest.h>
+
+#include <iota/constants.hpp>
+#include <iota/models/bundle_builder.hpp>
+#include <iota/models/transaction.hpp>
+#include <iota/types/trinary.hpp>
+#include <test/utils/constants.hpp>
+
+TEST(BundleBuilder, AddTransfer) {
+  IOTA::Models::BundleBuilder builder(2);
+
+  builder.addTransfer({ ACCOUNT_1_ADDRESS_1_HASH, 42, "", "TAG" });
+  builder.addTransfer({ ACCOUNT_1_ADDRESS_2_HASH, 21, "MESSAGE", "TAG" });
+
+  const auto& trxs = builder.getBundle().getTransactions();
+  ASSERT_EQ(trxs.size(), 2UL);
+  EXPECT_EQ(trxs[0].getAddress(), ACCOUNT_1_ADDRESS_1_HASH);
+  EXPECT_EQ(trxs[0].getValue(), 42);
+  EXPECT_EQ(trxs[1].getAddress(), ACCOUNT_1_ADDRESS_2_HASH);
+  EXPECT_EQ(trxs[1].getValue(), 21);
+  EXPECT_EQ(trxs[0].getTimestamp(), trxs[1].getTimestamp());
+  EXPECT_EQ(builder.getTotalValue(), 63);
+}
+
+TEST(BundleBuilder, AddTransferLongMessage) {
+  IOTA::Models::BundleBuilder builder;
+
+  builder.addTransfer({ ACCOUNT_1_ADDRESS_1_HASH, 0, std::string(IOTA::MaxTrxMsgLength * 2, 'A'),
+                        "TAG" });
+  builder.addTransfer({ ACCOUNT_1_ADDRESS_2_HASH, 0,
+                        std::string(IOTA::MaxTrxMsgLength, 'B') + "CD", "TAG" });
+
+  EXPECT_EQ(builder.getBundle().getTransactions().size(), 4UL);
+
+  builder.finalize();
+  const auto trytes = builder.toTrytes();
+  ASSERT_EQ(trytes.size(), 4UL);
+
+  EXPECT_EQ(trytes[0].substr(0, IOTA::MaxTrxMsgLength), std::string(IOTA::MaxTrxMsgLength, 'A'));
+  EXPECT_EQ(trytes[1].substr(0, IOTA::MaxTrxMsgLength), std::string(IOTA::MaxTrxMsgLength, 'A'));
+  EXPECT_EQ(trytes[2].substr(0, IOTA::MaxTrxMsgLength), std::string(IOTA::MaxTrxMsgLength, 'B'));
+  EXPECT_EQ(trytes[3].substr(0, IOTA::MaxTrxMsgLength),
+            "CD" + std::string(IOTA::MaxTrxMsgLength - 2, '9'));
+}
+
+TEST(BundleBuilder, ToTrytes) {
+  IOTA::Models::BundleBuilder builder;
+
+  builder.addTransfer({ ACCOUNT_1_ADDRESS_1_HASH_WITHOUT_CHECKSUM, 0, "MESSAGE", "TAG" });
+  builder.addOutput(ACCOUNT_1_ADDRESS_2_HASH_WITHOUT_CHECKSUM, 0, "TAG");
+  builder.finalize();
+
+  const auto  trytes = builder.toTrytes();
+  const auto& trxs   = builder.getBundle().getTransactions();
+  ASSERT_EQ(trytes.size(), 2UL);
+
+  for (std::size_t i = 0; i < trytes.size(); ++i) {
+    const IOTA::Models::Transaction trx{ trytes[i] };
+
+    EXPECT_EQ(trx.getAddress(), trxs[i].getAddress());
+    EXPECT_EQ(trx.getBundle(), trxs[i].getBundle());
+    EXPECT_EQ(trx.getCurrentIndex(), static_cast<int64_t>(i));
+    EXPECT_EQ(trx.getLastIndex(), 1);
+  }
+
+  EXPECT_EQ(trytes[0].substr(0, IOTA::MaxTrxMsgLength),
+            "MESSAGE" + std::string(IOTA::MaxTrxMsgLength - 7, '9'));
+  EXPECT_EQ(trytes[1].substr(0, IOTA::MaxTrxMsgLength), std::string(IOTA::MaxTrxMsgLength, '9'));
+}
+
+TEST(BundleBuilder, AddInput) {
+  IOTA::Models::BundleBuilder builder;
+
+  builder.addOutput(ACCOUNT_1_ADDRESS_2_HASH, 100, "TAG");
+  builder.addInput({ ACCOUNT_1_ADDRESS_1_HASH, 100, 0, 2 }, "TAG");
+
+  const auto& trxs = builder.getBundle().getTransactions();
+  ASSERT_EQ(trxs.size(), 3UL);
+  EXPECT_EQ(trxs[1].getValue(), -100);
+  EXPECT_EQ(trxs[2].getValue(), 0);
+  EXPECT_EQ(trxs[2].getAddress(), ACCOUNT_1_ADDRESS_1_HASH);
+  EXPECT_EQ(builder.getTotalValue(), 100);
+}
+
+TEST(BundleBuilder, CtorFromBundle) {
+  IOTA::Models::Bundle bundle({ { ACCOUNT_1_ADDRESS_1_HASH, 42, "TAG", 0 } });
+
+  IOTA::Models::BundleBuilder builder(bundle, { "MESSAGE" });
+  EXPECT_EQ(builder.getTotalValue(), 42);
+  EXPECT_EQ(builder.getBundle().getTransactions()[0].getSignatureFragments(), "MESSAGE");
+
+  const auto trytes = builder.toTrytes();
+  ASSERT_EQ(trytes.size(), 1UL);
+  EXPECT_EQ(trytes[0].substr(0, 7), "MESSAGE");
+}
+
+TEST(BundleBuilder, AddTransferStream) {
+  const std::string  message(5000, 'M');
+  std::istringstream in(message);
+
+  IOTA::Models::BundleBuilder builder;
+  builder.addTransfer(ACCOUNT_1_ADDRESS_1_HASH_WITHOUT_CHECKSUM, 42, in, "TAG");
+  EXPECT_EQ(builder.getTotalValue(), 42);
+
+  //! 10000 trytes need 5 transactions
+  builder.finalize();
+  builder.applyMessages();
+
+  const auto& b = builder.getBundle();
+  ASSERT_EQ(b.getTransactions().size(), 5UL);
+  EXPECT_EQ(b.getTransactions()[0].getValue(), 42);
+  EXPECT_EQ(b.getTransactions()[4].getTrunkTransaction(), IOTA::EmptyHash);
+
+  std::ostringstream out;
+  b.readMessage(0, out);
+  EXPECT_EQ(out.str(), message);
+
+  const auto trytes = builder.toTrytes();
+  EXPECT_EQ(trytes[0].substr(0, IOTA::MaxTrxMsgLength),
+            IOTA::Types::stringToTrytes(message).substr(0, IOTA::MaxTrxMsgLength));
+}
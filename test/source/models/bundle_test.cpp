@@ -23,9 +23,14 @@
 //
 //
 
+#include <sstream>
+
 #include <gtest/gtest.h>
 
+#include <iota/constants.hpp>
+#include <iota/errors/illegal_state.hpp>
 #include <iota/models/bundle.hpp>
+#include <iota/types/trinary.hpp>
 #include <test/utils/constants.hpp>
 
 TEST(Bundle, CtorDefault) {
@@ -313,3 +318,27 @@ TEST(Bundle, AddTrytes) {
   EXPECT_EQ(b[1].getNonce(), "999999999999999999999999999");
   EXPECT_EQ(b[2].getNonce(), "999999999999999999999999999");
 }
+
+TEST(Bundle, ReadMessage) {
+  //! 3000 characters: the characters straddle the odd-sized fragments
+  const std::string message(3000, 'Z');
+  const auto        trytes = IOTA::Types::stringToTrytes(message);
+
+  IOTA::Models::Bundle b;
+  b.addTransaction({ ACCOUNT_1_ADDRESS_1_HASH, 0, "TAG", 0 }, 3);
+  b.addTransaction({ ACCOUNT_1_ADDRESS_2_HASH, 0, "TAG", 0 });
+  b.addTrytes({ trytes.substr(0, IOTA::MaxTrxMsgLength),
+                trytes.substr(IOTA::MaxTrxMsgLength, IOTA::MaxTrxMsgLength),
+                trytes.substr(2 * IOTA::MaxTrxMsgLength), IOTA::Types::stringToTrytes("\n") });
+
+  std::ostringstream out;
+  b.readMessage(0, out);
+  EXPECT_EQ(out.str(), message);
+
+  //! the second tryte of a newline is '9' and is lost with the padding
+  out.str("");
+  b.readMessage(3, out);
+  EXPECT_EQ(out.str(), "\n");
+
+  EXPECT_THROW(b.readMessage(4, out), IOTA::Errors::IllegalState);
+}
@@ -0,0 +1,132 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <gtest/gtest.h>
+
+#include <iota/errors/illegal_state.hpp>
+#include <iota/models/compact_transaction.hpp>
+#include <iota/models/transaction.hpp>
+#include <iota/models/transaction_view.hpp>
+#include <test/utils/constants.hpp>
+#include <test/utils/expect_exception.hpp>
+
+TEST(CompactTransaction, DefaultCtor) {
+  IOTA::Models::CompactTransaction t;
+
+  EXPECT_EQ(t.toTrytes(), std::string(IOTA::TrxTrytesLength, '9'));
+  EXPECT_EQ(t.getHash(), IOTA::EmptyHash);
+  EXPECT_EQ(t.getValue(), 0);
+  EXPECT_TRUE(t.isTailTransaction());
+}
+
+TEST(CompactTransaction, CtorFromTrxTrytes) {
+  IOTA::Models::CompactTransaction t(BUNDLE_1_TRX_1_TRYTES);
+
+  EXPECT_TRUE(t.isValid());
+  EXPECT_TRUE(t.isTailTransaction());
+  EXPECT_EQ(t.toTrytes(), BUNDLE_1_TRX_1_TRYTES);
+  EXPECT_EQ(t.getHash(), BUNDLE_1_TRX_1_HASH);
+  EXPECT_EQ(t.getSignatureFragments(), BUNDLE_1_TRX_1_SIGNATURE_FRAGMENT);
+  EXPECT_EQ(t.getAddress(), IOTA::Models::Address{ BUNDLE_1_TRX_1_ADDRESS_WITHOUT_CHECKSUM });
+  EXPECT_EQ(t.getValue(), BUNDLE_1_TRX_1_VALUE);
+  EXPECT_EQ(t.getTimestamp(), BUNDLE_1_TRX_1_TS);
+  EXPECT_EQ(t.getCurrentIndex(), BUNDLE_1_TRX_1_CURRENT_INDEX);
+  EXPECT_EQ(t.getLastIndex(), BUNDLE_1_TRX_1_LAST_INDEX);
+  EXPECT_EQ(t.getBundle(), BUNDLE_1_HASH);
+  EXPECT_EQ(t.getTrunkTransaction(), BUNDLE_1_TRX_1_TRUNK);
+  EXPECT_EQ(t.getBranchTransaction(), BUNDLE_1_TRX_1_BRANCH);
+  EXPECT_EQ(t.getTag(), IOTA::Models::Tag{ BUNDLE_1_TRX_1_TAG });
+  EXPECT_EQ(t.getNonce(), BUNDLE_1_TRX_1_NONCE);
+}
+
+TEST(CompactTransaction, CtorFromInvalidTrytes) {
+  EXPECT_EXCEPTION(IOTA::Models::CompactTransaction t(""), IOTA::Errors::IllegalState,
+                   "Invalid transaction trytes");
+
+  auto trytes = BUNDLE_1_TRX_1_TRYTES;
+  trytes[0]   = 'a';
+  EXPECT_EXCEPTION(IOTA::Models::CompactTransaction t(trytes), IOTA::Errors::IllegalState,
+                   "Invalid transaction trytes");
+}
+
+TEST(CompactTransaction, TransactionRoundTrip) {
+  IOTA::Models::Transaction        trx(BUNDLE_1_TRX_1_TRYTES);
+  IOTA::Models::CompactTransaction t(trx);
+
+  EXPECT_EQ(t.getHash(), trx.getHash());
+  EXPECT_EQ(t.toTrytes(), trx.toTrytes());
+
+  auto back = t.toTransaction();
+  EXPECT_EQ(back, trx);
+  EXPECT_EQ(back.toTrytes(), BUNDLE_1_TRX_1_TRYTES);
+  EXPECT_EQ(back.getAttachmentTimestamp(), trx.getAttachmentTimestamp());
+}
+
+TEST(CompactTransaction, CtorFromTransactionWithoutHash) {
+  IOTA::Models::Transaction trx(BUNDLE_1_TRX_1_TRYTES);
+  trx.setHash("");
+
+  EXPECT_EQ(IOTA::Models::CompactTransaction{ trx }.getHash(), BUNDLE_1_TRX_1_HASH);
+}
+
+TEST(CompactTransaction, CtorFromView) {
+  IOTA::Models::TransactionView    view(BUNDLE_1_TRX_1_TRYTES);
+  IOTA::Models::CompactTransaction t(view);
+
+  EXPECT_EQ(t, IOTA::Models::CompactTransaction{ BUNDLE_1_TRX_1_TRYTES });
+  EXPECT_NE(t, IOTA::Models::CompactTransaction{ BUNDLE_1_TRX_2_TRYTES });
+}
+
+TEST(CompactTransaction, SerializeRoundTrip) {
+  IOTA::Models::CompactTransaction t(BUNDLE_1_TRX_1_TRYTES);
+
+  auto bytes = t.serialize();
+  EXPECT_EQ(bytes.size(), IOTA::Models::CompactTransaction::SerializedLength);
+  EXPECT_EQ(bytes[0], IOTA::Models::CompactTransaction::SerializationVersion);
+
+  auto restored = IOTA::Models::CompactTransaction::deserialize(bytes);
+  EXPECT_EQ(restored, t);
+  EXPECT_EQ(restored.toTrytes(), BUNDLE_1_TRX_1_TRYTES);
+  EXPECT_EQ(restored.getHash(), BUNDLE_1_TRX_1_HASH);
+  EXPECT_EQ(restored.getValue(), BUNDLE_1_TRX_1_VALUE);
+  EXPECT_EQ(restored.getTimestamp(), BUNDLE_1_TRX_1_TS);
+}
+
+TEST(CompactTransaction, DeserializeInvalid) {
+  auto bytes = IOTA::Models::CompactTransaction{ BUNDLE_1_TRX_1_TRYTES }.serialize();
+
+  EXPECT_EXCEPTION(IOTA::Models::CompactTransaction::deserialize(bytes.data(), bytes.size() - 1),
+                   IOTA::Errors::IllegalState, "Invalid compact transaction length");
+
+  auto badVersion = bytes;
+  badVersion[0]   = 42;
+  EXPECT_EXCEPTION(IOTA::Models::CompactTransaction::deserialize(badVersion),
+                   IOTA::Errors::IllegalState, "Unsupported compact transaction version");
+
+  auto badTrits = bytes;
+  badTrits[10]  = 243;
+  EXPECT_EXCEPTION(IOTA::Models::CompactTransaction::deserialize(badTrits),
+                   IOTA::Errors::IllegalState, "Invalid compact transaction trits");
+}
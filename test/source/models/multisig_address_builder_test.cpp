@@ -0,0 +1,58 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <gtest/gtest.h>
+
+#include <iota/crypto/multi_signing.hpp>
+#include <iota/models/multisig_address_builder.hpp>
+#include <iota/types/trinary.hpp>
+#include <test/utils/constants.hpp>
+
+static const std::string MULTISIG_ADDRESS =
+    "IZRSJJABYOJ9ZGMIDQPEYLIORMSJBHLIYVBOCOYG9CKKCCJG99MDZYANLWQFEIBGUA9QJSXXKTACDHSSZ";
+
+TEST(MultisigAddressBuilder, Finalize) {
+  auto firstDigest = IOTA::Crypto::MultiSigning::digests(
+      IOTA::Crypto::MultiSigning::key(IOTA::Types::trytesToBytes(ACCOUNT_1_SEED), 0, 3));
+  auto secondDigest = IOTA::Crypto::MultiSigning::digests(
+      IOTA::Crypto::MultiSigning::key(IOTA::Types::trytesToBytes(ACCOUNT_2_SEED), 0, 3));
+
+  IOTA::Models::MultisigAddressBuilder builder;
+  builder.absorbDigests(firstDigest);
+  builder.absorbDigests(secondDigest);
+  EXPECT_EQ(builder.getSecurity(), 6);
+
+  auto address = builder.finalize();
+  EXPECT_EQ(address.toTrytes(), MULTISIG_ADDRESS);
+  EXPECT_EQ(address.getType(), IOTA::Models::Address::MULTISIG);
+  EXPECT_EQ(address.getSecurity(), 6);
+
+  using IOTA::Models::MultisigAddressBuilder;
+  EXPECT_TRUE(MultisigAddressBuilder::validate(address, { firstDigest, secondDigest }));
+  EXPECT_FALSE(MultisigAddressBuilder::validate(address, { secondDigest, firstDigest }));
+  //! a NORMAL address with the same trytes is not a multisig address
+  EXPECT_FALSE(MultisigAddressBuilder::validate(IOTA::Models::Address{ MULTISIG_ADDRESS },
+                                                { firstDigest, secondDigest }));
+}
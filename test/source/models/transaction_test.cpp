@@ -25,6 +25,7 @@
 
 #include <gtest/gtest.h>
 
+#include <iota/constants.hpp>
 #include <iota/errors/illegal_state.hpp>
 #include <iota/models/transaction.hpp>
 #include <test/utils/constants.hpp>
@@ -229,6 +230,31 @@ TEST(Transaction, CtorFromTrxTrytesInvalidTrytes) {
             "9999999999999999999999999999999999999999999999999");
 }
 
+TEST(Transaction, ToTrytesBuffer) {
+  IOTA::Models::Transaction t(BUNDLE_1_TRX_1_TRYTES);
+  std::string               buffer(IOTA::TrxTrytesLength, 'X');
+
+  t.toTrytes(&buffer[0]);
+  EXPECT_EQ(buffer, BUNDLE_1_TRX_1_TRYTES);
+  EXPECT_EQ(buffer, t.toTrytes());
+}
+
+TEST(Transaction, ToTrytesBufferPadsMissingFields) {
+  IOTA::Models::Transaction t;
+  std::string               buffer(IOTA::TrxTrytesLength, 'X');
+
+  t.toTrytes(&buffer[0]);
+  EXPECT_EQ(buffer, std::string(IOTA::TrxTrytesLength, '9'));
+}
+
+TEST(Transaction, BundleEssenceToTrytes) {
+  IOTA::Models::Transaction t(BUNDLE_1_TRX_1_TRYTES);
+  std::string               essence(IOTA::BundleEssenceLength, 'X');
+
+  t.bundleEssenceToTrytes(&essence[0]);
+  EXPECT_EQ(essence, BUNDLE_1_TRX_1_TRYTES.substr(2187, IOTA::BundleEssenceLength));
+}
+
 TEST(Transaction, CtorFull) {
   IOTA::Models::Transaction t("signatureFragments", 1, 2, "nonce", "hash", 3, "trunkTransaction",
                               "branchTransaction", ACCOUNT_1_ADDRESS_1_HASH, 4, "bundle", "TAG", 5,
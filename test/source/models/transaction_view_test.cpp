@@ -0,0 +1,107 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <iota/errors/illegal_state.hpp>
+#include <iota/models/transaction.hpp>
+#include <iota/models/transaction_view.hpp>
+#include <test/utils/constants.hpp>
+#include <test/utils/expect_exception.hpp>
+
+TEST(TransactionView, CtorFromTrxTrytes) {
+  IOTA::Models::TransactionView v(BUNDLE_1_TRX_1_TRYTES);
+
+  EXPECT_TRUE(v.isValid());
+  EXPECT_TRUE(v.isTailTransaction());
+  EXPECT_EQ(v.toTrytes(), BUNDLE_1_TRX_1_TRYTES);
+  EXPECT_EQ(v.getSignatureFragments(), BUNDLE_1_TRX_1_SIGNATURE_FRAGMENT);
+  EXPECT_EQ(v.getAddress(), IOTA::Models::Address{ BUNDLE_1_TRX_1_ADDRESS_WITHOUT_CHECKSUM });
+  EXPECT_EQ(v.getValue(), BUNDLE_1_TRX_1_VALUE);
+  EXPECT_EQ(v.getTimestamp(), BUNDLE_1_TRX_1_TS);
+  EXPECT_EQ(v.getCurrentIndex(), BUNDLE_1_TRX_1_CURRENT_INDEX);
+  EXPECT_EQ(v.getLastIndex(), BUNDLE_1_TRX_1_LAST_INDEX);
+  EXPECT_EQ(v.getBundle(), BUNDLE_1_HASH);
+  EXPECT_EQ(v.getTrunkTransaction(), BUNDLE_1_TRX_1_TRUNK);
+  EXPECT_EQ(v.getBranchTransaction(), BUNDLE_1_TRX_1_BRANCH);
+  EXPECT_EQ(v.getTag(), IOTA::Models::Tag{ BUNDLE_1_TRX_1_TAG });
+  EXPECT_EQ(v.getNonce(), BUNDLE_1_TRX_1_NONCE);
+  EXPECT_EQ(v.getHash(), BUNDLE_1_TRX_1_HASH);
+}
+
+TEST(TransactionView, CtorFromMovedTrxTrytes) {
+  IOTA::Types::Trytes           trytes = BUNDLE_1_TRX_1_TRYTES;
+  IOTA::Models::TransactionView v(std::move(trytes));
+
+  EXPECT_EQ(v.toTrytes(), BUNDLE_1_TRX_1_TRYTES);
+  EXPECT_EQ(v.getHash(), BUNDLE_1_TRX_1_HASH);
+}
+
+TEST(TransactionView, CtorInvalidLength) {
+  EXPECT_EXCEPTION(IOTA::Models::TransactionView v(""), IOTA::Errors::IllegalState,
+                   "Invalid transaction trytes");
+  EXPECT_EXCEPTION(IOTA::Models::TransactionView v(BUNDLE_1_TRX_1_TRYTES + "9"),
+                   IOTA::Errors::IllegalState, "Invalid transaction trytes");
+}
+
+TEST(TransactionView, InvalidValidityChunk) {
+  IOTA::Types::Trytes trytes = BUNDLE_1_TRX_1_TRYTES;
+  trytes[2280]               = 'A';
+
+  IOTA::Models::TransactionView v(trytes);
+  EXPECT_FALSE(v.isValid());
+  EXPECT_EQ(IOTA::Models::Transaction{ v }, IOTA::Models::Transaction{ trytes });
+  EXPECT_EQ(IOTA::Models::Transaction{ v }.getHash(), "");
+}
+
+TEST(TransactionView, ToTransaction) {
+  IOTA::Models::TransactionView v(BUNDLE_1_TRX_1_TRYTES);
+  IOTA::Models::Transaction     fromView(v);
+  IOTA::Models::Transaction     fromTrytes(BUNDLE_1_TRX_1_TRYTES);
+
+  EXPECT_EQ(fromView.getHash(), fromTrytes.getHash());
+  EXPECT_EQ(fromView.getAddress(), fromTrytes.getAddress());
+  EXPECT_EQ(fromView.getValue(), fromTrytes.getValue());
+  EXPECT_EQ(fromView.getAttachmentTimestamp(), fromTrytes.getAttachmentTimestamp());
+  EXPECT_EQ(fromView.getAttachmentTimestampUpperBound(),
+            fromTrytes.getAttachmentTimestampUpperBound());
+  EXPECT_EQ(fromView.toTrytes(), BUNDLE_1_TRX_1_TRYTES);
+}
+
+TEST(TransactionView, ConcurrentHash) {
+  const IOTA::Models::TransactionView v(BUNDLE_1_TRX_1_TRYTES);
+  std::vector<std::thread>            readers;
+
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&v]() { EXPECT_EQ(v.getHash(), BUNDLE_1_TRX_1_HASH); });
+  }
+
+  for (auto& reader : readers) {
+    reader.join();
+  }
+}
@@ -0,0 +1,102 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <unordered_set>
+
+#include <iota/errors/illegal_state.hpp>
+#include <iota/types/hash.hpp>
+#include <test/utils/constants.hpp>
+#include <test/utils/expect_exception.hpp>
+
+TEST(Hash, DefaultCtor) {
+  IOTA::Types::Hash h;
+
+  EXPECT_TRUE(h.empty());
+  EXPECT_EQ(h.size(), 0UL);
+  EXPECT_EQ(h, "");
+  EXPECT_EQ(h.toTrytes(), "");
+}
+
+TEST(Hash, CtorFromTrytes) {
+  IOTA::Types::Hash h = BUNDLE_1_HASH;
+
+  EXPECT_FALSE(h.empty());
+  EXPECT_EQ(h.size(), IOTA::HashLength);
+  EXPECT_EQ(h, BUNDLE_1_HASH);
+  EXPECT_EQ(BUNDLE_1_HASH, h);
+  EXPECT_EQ(h.toTrytes(), BUNDLE_1_HASH);
+  EXPECT_EQ(static_cast<IOTA::Types::Trytes>(h), BUNDLE_1_HASH);
+  EXPECT_EQ(h[0], BUNDLE_1_HASH[0]);
+  EXPECT_EQ(IOTA::Types::Trytes(h.begin(), h.end()), BUNDLE_1_HASH);
+}
+
+TEST(Hash, CtorFromShortTrytes) {
+  IOTA::Types::Hash h = "ABC";
+
+  EXPECT_EQ(h.size(), 3UL);
+  EXPECT_EQ(h, "ABC");
+  EXPECT_NE(h, "ABCD");
+  EXPECT_NE(h, "AB");
+}
+
+TEST(Hash, CtorFromTooLongTrytes) {
+  EXPECT_EXCEPTION(IOTA::Types::Hash h(ACCOUNT_1_ADDRESS_1_HASH), IOTA::Errors::IllegalState,
+                   "Invalid hash length");
+}
+
+TEST(Hash, Comparison) {
+  IOTA::Types::Hash h1 = BUNDLE_1_TRX_1_HASH;
+  IOTA::Types::Hash h2 = BUNDLE_1_TRX_2_HASH;
+
+  EXPECT_EQ(h1, IOTA::Types::Hash{ BUNDLE_1_TRX_1_HASH });
+  EXPECT_NE(h1, h2);
+  EXPECT_NE(h1, BUNDLE_1_TRX_2_HASH);
+  EXPECT_NE(BUNDLE_1_TRX_2_HASH, h1);
+  EXPECT_EQ(h1 < h2, BUNDLE_1_TRX_1_HASH < BUNDLE_1_TRX_2_HASH);
+  EXPECT_FALSE(h1 < h1);
+}
+
+TEST(Hash, HashCode) {
+  IOTA::Types::Hash h1 = BUNDLE_1_TRX_1_HASH;
+  IOTA::Types::Hash h2 = BUNDLE_1_TRX_2_HASH;
+
+  EXPECT_EQ(h1.hashCode(), IOTA::Types::Hash{ BUNDLE_1_TRX_1_HASH }.hashCode());
+  EXPECT_NE(h1.hashCode(), h2.hashCode());
+  EXPECT_NE(IOTA::Types::Hash{ "A" }.hashCode(), IOTA::Types::Hash{ "A9" }.hashCode());
+
+  std::unordered_set<IOTA::Types::Hash> set = { h1, h2, h1 };
+  EXPECT_EQ(set.size(), 2UL);
+  EXPECT_EQ(set.count(BUNDLE_1_TRX_2_HASH), 1UL);
+}
+
+TEST(Hash, StreamOperator) {
+  std::stringstream ss;
+  ss << IOTA::Types::Hash{ BUNDLE_1_HASH };
+
+  EXPECT_EQ(ss.str(), BUNDLE_1_HASH);
+}
@@ -126,6 +126,33 @@ TEST(Trinary, trytesToString) {
       "XYZ!\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~ \t\n");
 }
 
+TEST(Trinary, trytesToStringInvalidTrytes) {
+  EXPECT_EXCEPTION(IOTA::Types::trytesToString("A1"), IOTA::Errors::IllegalState,
+                   "Invalid trytes provided");
+}
+
+TEST(Trinary, stringToTrytesBuffer) {
+  const std::string str("ASCII Message to Trytes");
+  std::string       trytes(2 * str.size(), ' ');
+  std::string       decoded(str.size(), ' ');
+
+  IOTA::Types::stringToTrytes(str.data(), str.size(), &trytes[0]);
+  EXPECT_EQ(trytes, "KBBCMBSBSBEAWBTCGDGDPCVCTCEAHDCDEACCFDMDHDTCGD");
+
+  IOTA::Types::trytesToString(trytes.data(), trytes.size(), &decoded[0]);
+  EXPECT_EQ(decoded, str);
+}
+
+TEST(Trinary, stringToTrytesAllBytes) {
+  std::string str;
+  for (int c = 0; c < 256; ++c) {
+    str += static_cast<char>(c);
+  }
+
+  EXPECT_EQ(IOTA::Types::charToTrytes(static_cast<char>(255)), "LI");
+  EXPECT_EQ(IOTA::Types::trytesToString(IOTA::Types::stringToTrytes(str)), str);
+}
+
 TEST(Trinary, tritsToBytes) {
   std::vector<uint8_t> b1({ 0x00, 0x00, 0x00, 0x00 });
   b1.insert(std::begin(b1), IOTA::ByteHashLength - b1.size(), 0x00);
@@ -260,3 +287,56 @@ TEST(Trinary, IntToTrits) {
   EXPECT_EQ(IOTA::Types::intToTrits(0, 6), std::vector<int8_t>({ 0, 0, 0, 0, 0, 0 }));
   EXPECT_EQ(IOTA::Types::intToTrits(-42, 6), std::vector<int8_t>({ 0, 1, 1, 1, -1, 0 }));
 }
+
+TEST(Trinary, TrytesToInt) {
+  EXPECT_EQ(IOTA::Types::trytesToInt("OB99", 0, 4), 42);
+  EXPECT_EQ(IOTA::Types::trytesToInt("99OB99", 2, 2), 42);
+  EXPECT_EQ(IOTA::Types::trytesToInt("LY9", 0, 3), -42);
+  EXPECT_EQ(IOTA::Types::trytesToInt("999", 0, 3), 0);
+  EXPECT_EQ(IOTA::Types::trytesToInt("OB", 0, 2),
+            IOTA::Types::tritsToInt<int64_t>(IOTA::Types::trytesToTrits("OB")));
+}
+
+TEST(Trinary, IntToTrytes) {
+  std::string trytes(4, 'X');
+
+  IOTA::Types::intToTrytes(42, &trytes[0], 4);
+  EXPECT_EQ(trytes, "OB99");
+  IOTA::Types::intToTrytes(-42, &trytes[0], 4);
+  EXPECT_EQ(trytes, "LY99");
+  IOTA::Types::intToTrytes(0, &trytes[0], 4);
+  EXPECT_EQ(trytes, "9999");
+
+  trytes = std::string(9, 'X');
+  IOTA::Types::intToTrytes(1527231332, &trytes[0], 9);
+  EXPECT_EQ(trytes, IOTA::Types::tritsToTrytes(IOTA::Types::intToTrits(1527231332, 27)));
+  EXPECT_EQ(IOTA::Types::trytesToInt(trytes, 0, 9), 1527231332);
+}
+
+TEST(Trinary, PackedTrits) {
+  const std::string trytes = "NOPQRSTUVWXYZ9ABCDEFGHIJKLM";
+  std::vector<uint8_t> bytes(IOTA::Types::packedTritsLength(trytes.size()));
+
+  EXPECT_EQ(bytes.size(), 17UL);
+  IOTA::Types::trytesToPackedTrits(trytes.data(), trytes.size(), bytes.data());
+
+  std::string unpacked(trytes.size(), 'X');
+  IOTA::Types::packedTritsToTrytes(bytes.data(), 0, trytes.size(), &unpacked[0]);
+  EXPECT_EQ(unpacked, trytes);
+
+  std::string slice(5, 'X');
+  IOTA::Types::packedTritsToTrytes(bytes.data(), 11, 5, &slice[0]);
+  EXPECT_EQ(slice, trytes.substr(11, 5));
+}
+
+TEST(Trinary, NullTrytesToPackedTrits) {
+  for (std::size_t length : { 0, 1, 5, 81, 2673 }) {
+    const std::string    trytes(length, '9');
+    std::vector<uint8_t> expected(IOTA::Types::packedTritsLength(length));
+    std::vector<uint8_t> bytes(IOTA::Types::packedTritsLength(length));
+
+    IOTA::Types::trytesToPackedTrits(trytes.data(), length, expected.data());
+    IOTA::Types::nullTrytesToPackedTrits(length, bytes.data());
+    EXPECT_EQ(bytes, expected);
+  }
+}
@@ -0,0 +1,97 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <iota/utils/blocking_queue.hpp>
+
+TEST(BlockingQueue, PushPop) {
+  IOTA::Utils::BlockingQueue<int> queue(2);
+  int                             value = 0;
+
+  EXPECT_TRUE(queue.push(1));
+  EXPECT_TRUE(queue.push(2));
+  EXPECT_EQ(queue.size(), 2UL);
+  EXPECT_EQ(queue.capacity(), 2UL);
+
+  EXPECT_TRUE(queue.pop(value));
+  EXPECT_EQ(value, 1);
+  EXPECT_TRUE(queue.pop(value));
+  EXPECT_EQ(value, 2);
+  EXPECT_EQ(queue.size(), 0UL);
+}
+
+TEST(BlockingQueue, MoveOnly) {
+  IOTA::Utils::BlockingQueue<std::unique_ptr<int>> queue;
+  std::unique_ptr<int>                             value;
+
+  EXPECT_TRUE(queue.push(std::unique_ptr<int>(new int(42))));
+  EXPECT_TRUE(queue.pop(value));
+  ASSERT_TRUE(value != nullptr);
+  EXPECT_EQ(*value, 42);
+}
+
+TEST(BlockingQueue, Close) {
+  IOTA::Utils::BlockingQueue<int> queue(1);
+  int                             value = 0;
+
+  EXPECT_TRUE(queue.push(1));
+  queue.close();
+
+  EXPECT_TRUE(queue.isClosed());
+  EXPECT_FALSE(queue.push(2));
+
+  //! queued elements are drained after close
+  EXPECT_TRUE(queue.pop(value));
+  EXPECT_EQ(value, 1);
+  EXPECT_FALSE(queue.pop(value));
+}
+
+TEST(BlockingQueue, ProducerConsumer) {
+  IOTA::Utils::BlockingQueue<int> queue(4);
+  std::vector<int>                received;
+
+  std::thread consumer([&queue, &received]() {
+    int value;
+    while (queue.pop(value)) {
+      received.push_back(value);
+    }
+  });
+
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_TRUE(queue.push(i));
+  }
+  queue.close();
+  consumer.join();
+
+  ASSERT_EQ(received.size(), 1000UL);
+  for (int i = 0; i < 1000; ++i) {
+    EXPECT_EQ(received[i], i);
+  }
+}
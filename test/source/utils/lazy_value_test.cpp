@@ -0,0 +1,96 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <iota/utils/lazy_value.hpp>
+
+TEST(LazyValue, ComputedOnce) {
+  IOTA::Utils::LazyValue<std::string> value;
+  int                                 calls   = 0;
+  auto                                compute = [&calls]() {
+    ++calls;
+    return std::string("A");
+  };
+
+  EXPECT_FALSE(value.ready());
+  EXPECT_EQ(value.get(compute), "A");
+  EXPECT_EQ(value.get(compute), "A");
+  EXPECT_TRUE(value.ready());
+  EXPECT_EQ(calls, 1);
+}
+
+TEST(LazyValue, SetAndReset) {
+  IOTA::Utils::LazyValue<std::string> value;
+
+  value.set("A");
+  EXPECT_EQ(value.get([]() { return std::string("B"); }), "A");
+
+  value.reset();
+  EXPECT_FALSE(value.ready());
+  EXPECT_EQ(value.get([]() { return std::string("B"); }), "B");
+}
+
+TEST(LazyValue, CopyKeepsValue) {
+  IOTA::Utils::LazyValue<std::string> value;
+  IOTA::Utils::LazyValue<std::string> empty;
+
+  value.set("A");
+
+  auto copy = value;
+  EXPECT_EQ(copy.get([]() { return std::string("B"); }), "A");
+
+  copy = empty;
+  EXPECT_FALSE(copy.ready());
+}
+
+TEST(LazyValue, ConcurrentReads) {
+  const IOTA::Utils::LazyValue<std::string> value;
+  std::atomic<int>                          calls{ 0 };
+  std::vector<std::thread>                  readers;
+
+  for (int i = 0; i < 8; ++i) {
+    readers.emplace_back([&value, &calls]() {
+      auto compute = [&calls]() {
+        ++calls;
+        return std::string(81, 'A');
+      };
+
+      EXPECT_EQ(value.get(compute), std::string(81, 'A'));
+    });
+  }
+
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  EXPECT_TRUE(value.ready());
+  EXPECT_GE(calls.load(), 1);
+}
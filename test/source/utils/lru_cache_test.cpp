@@ -0,0 +1,85 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <iota/utils/lru_cache.hpp>
+
+TEST(LRUCache, GetPut) {
+  IOTA::Utils::LRUCache<std::string, int> cache(2);
+  int                                     value = 0;
+
+  EXPECT_FALSE(cache.get("a", value));
+  cache.put("a", 1);
+  EXPECT_TRUE(cache.get("a", value));
+  EXPECT_EQ(value, 1);
+
+  cache.put("a", 2);
+  EXPECT_TRUE(cache.get("a", value));
+  EXPECT_EQ(value, 2);
+  EXPECT_EQ(cache.size(), 1UL);
+
+  EXPECT_EQ(cache.hits(), 2UL);
+  EXPECT_EQ(cache.misses(), 1UL);
+}
+
+TEST(LRUCache, EvictLeastRecentlyUsed) {
+  IOTA::Utils::LRUCache<std::string, int> cache(2);
+  int                                     value = 0;
+
+  cache.put("a", 1);
+  cache.put("b", 2);
+  //! a becomes the most recently used, b is evicted next
+  EXPECT_TRUE(cache.get("a", value));
+  cache.put("c", 3);
+
+  EXPECT_EQ(cache.size(), 2UL);
+  EXPECT_TRUE(cache.get("a", value));
+  EXPECT_FALSE(cache.get("b", value));
+  EXPECT_TRUE(cache.get("c", value));
+  EXPECT_EQ(value, 3);
+}
+
+TEST(LRUCache, ZeroCapacity) {
+  IOTA::Utils::LRUCache<std::string, int> cache(0);
+  int                                     value = 0;
+
+  cache.put("a", 1);
+  EXPECT_FALSE(cache.get("a", value));
+  EXPECT_EQ(cache.size(), 0UL);
+  EXPECT_EQ(cache.capacity(), 0UL);
+}
+
+TEST(LRUCache, Clear) {
+  IOTA::Utils::LRUCache<std::string, int> cache(2);
+  int                                     value = 0;
+
+  cache.put("a", 1);
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0UL);
+  EXPECT_FALSE(cache.get("a", value));
+}
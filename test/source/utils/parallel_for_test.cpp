@@ -0,0 +1,55 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <atomic>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <iota/utils/parallel_for.hpp>
+
+TEST(ParallelFor, EachIndexOnce) {
+  std::vector<std::atomic<int>> visits(1000);
+  for (auto& v : visits) {
+    v = 0;
+  }
+
+  IOTA::Utils::parallel_for(std::size_t{ 10 }, visits.size(), [&visits](std::size_t i) {
+    ++visits[i];
+  });
+
+  for (std::size_t i = 0; i < visits.size(); ++i) {
+    EXPECT_EQ(visits[i], i < 10 ? 0 : 1);
+  }
+}
+
+TEST(ParallelFor, EmptyRange) {
+  std::atomic<int> calls(0);
+
+  IOTA::Utils::parallel_for(std::size_t{ 5 }, std::size_t{ 5 }, [&calls](std::size_t) { ++calls; });
+  IOTA::Utils::parallel_for(std::size_t{ 5 }, std::size_t{ 2 }, [&calls](std::size_t) { ++calls; });
+
+  EXPECT_EQ(calls, 0);
+}
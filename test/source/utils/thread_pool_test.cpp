@@ -0,0 +1,103 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <atomic>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <iota/utils/thread_pool.hpp>
+
+TEST(ThreadPool, Submit) {
+  IOTA::Utils::ThreadPool pool(2);
+
+  auto future = pool.submit([]() { return 42; });
+  EXPECT_EQ(future.get(), 42);
+}
+
+TEST(ThreadPool, SubmitException) {
+  IOTA::Utils::ThreadPool pool(2);
+
+  auto future = pool.submit([]() -> int { throw std::runtime_error("error"); });
+  EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(ThreadPool, BoundedThreads) {
+  IOTA::Utils::ThreadPool pool(3);
+
+  std::atomic<int>               counter(0);
+  std::vector<std::future<void>> futures;
+  for (int i = 0; i < 100; ++i) {
+    futures.push_back(pool.submit([&counter]() { ++counter; }));
+  }
+
+  for (auto& future : futures) {
+    future.get();
+  }
+
+  EXPECT_EQ(counter, 100);
+  EXPECT_LE(pool.size(), 3UL);
+  EXPECT_EQ(pool.pending(), 0UL);
+}
+
+TEST(ThreadPool, MaxThreads) {
+  IOTA::Utils::ThreadPool pool(0);
+  EXPECT_EQ(pool.getMaxThreads(), 1UL);
+
+  pool.setMaxThreads(4);
+  EXPECT_EQ(pool.getMaxThreads(), 4UL);
+}
+
+TEST(ThreadPool, DestructorRunsPendingTasks) {
+  std::atomic<int> counter(0);
+
+  {
+    IOTA::Utils::ThreadPool pool(1);
+    for (int i = 0; i < 10; ++i) {
+      pool.submit([&counter]() { ++counter; });
+    }
+  }
+
+  EXPECT_EQ(counter, 10);
+}
+
+TEST(ThreadPool, JoinRunsNestedTasks) {
+  IOTA::Utils::ThreadPool pool(2);
+  std::atomic<int>        counter(0);
+
+  for (int i = 0; i < 10; ++i) {
+    pool.submit([&pool, &counter]() {
+      ++counter;
+      pool.submit([&counter]() { ++counter; });
+    });
+  }
+
+  pool.join();
+  EXPECT_EQ(counter, 20);
+  EXPECT_EQ(pool.size(), 0UL);
+
+  //! the pool is still usable once joined
+  EXPECT_EQ(pool.submit([]() { return 42; }).get(), 42);
+}
@@ -0,0 +1,80 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <chrono>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include <iota/utils/timer_wheel.hpp>
+
+using Wheel = IOTA::Utils::TimerWheel<std::string>;
+
+TEST(TimerWheel, Expiration) {
+  Wheel wheel(4, std::chrono::milliseconds(10));
+
+  wheel.schedule("a", std::chrono::milliseconds(10));
+  wheel.schedule("b", std::chrono::milliseconds(25));
+  wheel.schedule("c", std::chrono::milliseconds(0));
+  EXPECT_EQ(wheel.size(), 3UL);
+
+  //! delays are rounded up to whole ticks, and are at least one tick
+  auto expired = wheel.advance();
+  ASSERT_EQ(expired.size(), 2UL);
+  EXPECT_EQ(expired[0], "a");
+  EXPECT_EQ(expired[1], "c");
+
+  EXPECT_TRUE(wheel.advance().empty());
+
+  expired = wheel.advance();
+  ASSERT_EQ(expired.size(), 1UL);
+  EXPECT_EQ(expired[0], "b");
+  EXPECT_EQ(wheel.size(), 0UL);
+}
+
+TEST(TimerWheel, SeveralTurns) {
+  Wheel wheel(4, std::chrono::milliseconds(10));
+
+  //! 10 ticks: two full turns, then two more slots
+  wheel.schedule("a", std::chrono::milliseconds(100));
+  wheel.schedule("b", std::chrono::milliseconds(20));
+
+  for (int i = 1; i <= 10; ++i) {
+    auto expired = wheel.advance();
+
+    if (i == 2) {
+      ASSERT_EQ(expired.size(), 1UL);
+      EXPECT_EQ(expired[0], "b");
+    } else if (i == 10) {
+      ASSERT_EQ(expired.size(), 1UL);
+      EXPECT_EQ(expired[0], "a");
+    } else {
+      EXPECT_TRUE(expired.empty());
+    }
+  }
+
+  EXPECT_EQ(wheel.size(), 0UL);
+  EXPECT_EQ(wheel.tick(), std::chrono::milliseconds(10));
+}